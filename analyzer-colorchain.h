@@ -4,10 +4,11 @@
 
 #include "technique.h"
 #include "coord.h"
-#include "cell.h"  // Value, Cell used in the finding and the test_ contract below
+#include "cell.h"  // Value used in the finding and the test_ contract below
+#include "bitboard.h"
+#include "geometry.h"
 
-#include <algorithm>
-#include <unordered_map>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -21,38 +22,54 @@
 // separable test_color_chain predicate. ColorChainFinding is in this header, not
 // file-local, because the whitebox cases construct one and hand it to that
 // predicate.
-struct ColorChainFinding : Finding {
+template<size_t Box>
+struct BasicColorChainFinding : Finding {
+    using G = Geometry<Box>;
+    using Cells = typename G::Cells;
+
     Value value;
-    std::unordered_map<Coord, bool> cells;  // coord -> color (true=green, false=red)
+    Cells green;   // one color class of the chain, as a cell mask
+    Cells red;     // the other
+
+    explicit BasicColorChainFinding(Value v) : value(v) { }
+
+    // Put the cell at `coord` on the chain, in green or in red.
+    void paint(const Coord &coord, bool is_green) { (is_green ? green : red).set(G::index(coord)); }
+
+    size_t size() const { return (green | red).count(); }
+
+    // Rule 2's test: does either color class hold two cells that share a unit?
+    // One AND per colored cell, of its peers with its own class.
+    bool has_repeated_color() const;
 
-    explicit ColorChainFinding(Value v) : value(v) { }
+    // Rule 4's eliminations: the off-chain candidates for `value` on `board` that
+    // see a cell of each color. Every cell a class sees is the OR of its members'
+    // peer masks, so this is one AND of those two masks with the candidates.
+    Cells sees_both_colors(const BasicBoard<Box> &) const;
 
-    // Both vectors come back sorted by coord, for the same reason print() sorts:
-    // `cells` is an unordered_map, so its iteration order is unspecified and
-    // differs between standard libraries. These vectors are not internal -- Rule 2
+    // Both vectors come back sorted by coord: a cell set iterates in ascending
+    // cell index, which is coord order. The order is not internal -- Rule 2
     // prints one "[SC] <coord> x<v>" line per element in order, and
     // Board::any_see_each_other returns the unit of the *first* conflicting pair,
-    // so an unsorted vector leaks bucket order into both the line sequence and the
-    // printed unit tag. The elimination set is the same either way.
+    // so it decides both the line sequence and the printed unit tag.
     std::pair<std::vector<Coord>, std::vector<Coord>> group_cells_by_color() const {
         std::vector<Coord> green_cells, red_cells;
-        for (const auto &[coord, color] : cells) {
-            if (color) { green_cells.push_back(coord); } // true = green
-            else       { red_cells.push_back(coord); }   // false = red
-        }
-        std::sort(green_cells.begin(), green_cells.end());
-        std::sort(red_cells.begin(), red_cells.end());
+        for (size_t index : green) green_cells.push_back(G::coord(index));
+        for (size_t index : red)   red_cells.push_back(G::coord(index));
         return {green_cells, red_cells};
     }
 
-    bool cell_sees_both_colors(const Cell &, const Board &) const;
-
     // Format: "{coord🟩,coord🟥,...}#value", cells sorted by coord so the dump is
-    // deterministic across standard libraries (see the definition).
+    // deterministic (see the definition).
     void print(std::ostream &) const override;
 };
 
-class ColorChainTechnique : public Technique {
+using ColorChainFinding = BasicColorChainFinding<3>;
+
+template<size_t Box>
+class BasicColorChainTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+
 public:
     const char *name() const override { return "SC"; }
     Tier        tier() const override { return Tier::Advanced; }
@@ -60,6 +77,7 @@ public:
 
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
 
     // Tested contract, NOT a leaked private: is `chain` actionable on `board`?
     // (Rule 2: a same-colored pair shares a unit; or Rule 4: some off-chain
@@ -67,5 +85,7 @@ public:
     // chains directly, without friendship. Static, not const-member: the technique
     // is stateless and this reads only its arguments (the board it queries is
     // passed in), matching the static shape of the other hooked techniques.
-    static bool test_color_chain(const Board &, const ColorChainFinding &);
+    static bool test_color_chain(const Board &, const BasicColorChainFinding<Box> &);
 };
+
+using ColorChainTechnique = BasicColorChainTechnique<3>;
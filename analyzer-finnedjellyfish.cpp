@@ -0,0 +1,109 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "analyzer-finnedjellyfish.h"
+#include "analyzer-fish.h"
+#include "board.h"
+#include "row.h"
+#include "column.h"
+#include "cell.h"
+#include "coord.h"
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using analyzer_fish::act_on_finned_fish;
+using analyzer_fish::anchors_of;
+using analyzer_fish::find_finned_fish;
+using analyzer_fish::LineMasks;
+using analyzer_fish::may_have_bases;
+
+namespace {
+
+// Record what the shared worker found as a FinnedJellyfishFinding: one anchor per
+// base line, plus the fins in the order the worker discovered them.
+template<class Bases>
+const Finding &make_finding(const Bases &b, std::vector<Coord> fins,
+                            const Value &value, bool by_row, FindingList &out) {
+    return out.emplace<FinnedJellyfishFinding>(value, anchors_of(b), std::move(fins), by_row);
+}
+
+// The per-anchor search on the value's line masks, which find() builds once per
+// value rather than once per anchor.
+template<size_t Box>
+bool find_at(const BasicCell<Box> &cell, const Value &value, const LineMasks<Box> &masks, FindingList &out) {
+    // Try row-based (eliminations in columns); if not found, try column-based
+    // (eliminations in rows). The base lines' kind cannot be deduced from the
+    // argument list -- the cover is chosen, not handed in -- so it is named.
+    if (find_finned_fish<4, BasicRow<Box>>(cell, value, masks, BasicFinnedJellyfishTechnique<Box>::kName,
+            [&](const auto &b, auto fins) -> const Finding & { return make_finding(b, std::move(fins), value, true, out); }, out))
+        return true;
+    return find_finned_fish<4, BasicColumn<Box>>(cell, value, masks, BasicFinnedJellyfishTechnique<Box>::kName,
+            [&](const auto &b, auto fins) -> const Finding & { return make_finding(b, std::move(fins), value, false, out); }, out);
+}
+
+} // namespace
+
+template<size_t Box>
+bool BasicFinnedJellyfishTechnique<Box>::find_finned_jellyfish(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
+    assert(cell.isNote());
+    assert(cell.check(value));
+
+    return find_at(cell, value, LineMasks<Box>(board, value), out);
+}
+
+// A finned Jellyfish is a Jellyfish whose base lines are allowed extra candidates
+// outside the four cover lines, so long as all of those fins share one nonet. The
+// value is then eliminated from the cover lines' cells inside that nonet, outside
+// the base lines.
+template<size_t Box>
+bool BasicFinnedJellyfishTechnique<Box>::find(const Board &board, FindingList &out) const {
+    assert(out.empty());
+
+    std::array<LineMasks<Box>, Geometry<Box>::kSide> masks;
+    for (Value value : value_range<Box>()) masks[value - 1] = LineMasks<Box>(board, value);
+
+    for (auto const &cell: board.cells()) {
+        // is this a note cell?
+        if (!cell.isNote()) continue;
+
+        // for each value in this cell...
+        for (auto const &value : cell.notes().values()) {
+            // let's see if we can anchor a finned Jellyfish in this cell for this
+            // value; stop at the first one found
+            if (find_at(cell, value, masks[value - 1], out)) return true;
+        }
+    }
+
+    return false;
+}
+
+// Four base lines, with room on each for fins.
+template<size_t Box>
+bool BasicFinnedJellyfishTechnique<Box>::may_fire(const Board &board) const {
+    return may_have_bases(board, 4, 4 + Box);
+}
+
+template<size_t Box>
+bool BasicFinnedJellyfishTechnique<Box>::apply(Board &board, FindingList &mine) const {
+    if (mine.empty()) return false;
+    assert(mine.size() == 1);
+
+    auto const &fj = bucket_cast<FinnedJellyfishFinding>(*mine.front());
+
+    // Row-based pattern eliminates from columns; column-based, from rows.
+    bool did_act = fj.is_row_based
+        ? act_on_finned_fish<4, BasicColumn<Box>>(board, fj.value, fj.anchors, fj.fins, name())
+        : act_on_finned_fish<4, BasicRow<Box>>(board, fj.value, fj.anchors, fj.fins, this->name());
+
+    mine.clear();
+    assert(did_act);
+    return did_act;
+}
+
+template class BasicFinnedJellyfishTechnique<3>;
+template class BasicFinnedJellyfishTechnique<4>;
+template class BasicFinnedJellyfishTechnique<5>;
@@ -0,0 +1,83 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include "technique.h"
+#include "coord.h"
+#include "cell.h"  // Value
+
+#include <array>
+#include <vector>
+
+// Finned Jellyfish: the fin rule at four base lines. A plain Jellyfish needs four
+// base lines whose candidates for one value fall entirely within the same four
+// cross lines. A finned Jellyfish allows extra candidates outside those four
+// cross lines -- the fins -- provided every fin sits in a single nonet. The
+// either/or that licenses it, and the cells it clears, are finned Swordfish's
+// (analyzer-finnedswordfish.h) with one more base line.
+//
+// The search is analyzer_fish::find_finned_fish at N=4, the worker finned X-Wing
+// and finned Swordfish instantiate at N=2 and N=3. At four base lines most sets
+// of lines touch too many cross lines to leave their fins in one band, and the
+// worker prunes those before choosing a cover; analyzer-fish.h has the bound.
+//
+// Finned Jellyfish is *scan-fused* (docs/test-predicate-idiom.md), like every
+// other fish. The seam is find_finned_jellyfish below, and FinnedJellyfishFinding
+// is in this header, not file-local, because the whitebox cases read its fields
+// (mirroring FinnedSwordfishFinding).
+struct FinnedJellyfishFinding : Finding {
+    Value value;
+    // One anchor per base line, the recovery handle every fish uses. An anchor
+    // may itself be a fin; it identifies a line, nothing more.
+    std::array<Coord, 4> anchors;
+    // The fins, in discovery order -- base line by base line, and within each
+    // line in the order its candidates are walked -- for the reasons
+    // FinnedSwordfishFinding::fins gives: print() emits them, and apply() needs
+    // them to recover the cover and the fin's nonet.
+    std::vector<Coord> fins;
+    bool is_row_based;  // true if rows hold the pattern, false if columns do
+
+    FinnedJellyfishFinding(Value v, const std::array<Coord, 4> &a, std::vector<Coord> f, bool row_based)
+        : value(v), anchors(a), fins(std::move(f)), is_row_based(row_based) { }
+    // No same()/dedup here: find() short-circuits at the first hit, so a bucket
+    // never holds two to compare.
+    // Format: "{a1,a2,a3,a4}+{f1,...}#value[^c]" -- FinnedSwordfishFinding's
+    // format at four anchors.
+    void print(std::ostream &o) const override {
+        o << "{" << anchors[0] << "," << anchors[1] << "," << anchors[2] << "," << anchors[3] << "}+{";
+        bool is_first = true;
+        for (const auto &fin : fins) {
+            if (!is_first) o << ",";
+            is_first = false;
+            o << fin;
+        }
+        o << "}"
+          << "#" << value << "[^" << (is_row_based ? "c" : "r") << "]";
+    }
+};
+
+template<size_t Box>
+class BasicFinnedJellyfishTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using Cell = BasicCell<Box>;
+
+public:
+    // Written once, for the reason XWingTechnique::kName gives.
+    static constexpr const char *kName = "FJ";
+
+    const char *name() const override { return kName; }
+    Tier        tier() const override { return Tier::Advanced; }
+    bool  brace_each() const override { return true; }
+
+    bool find(const Board &, FindingList &out) const override;
+    bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
+
+    // Whitebox seam, NOT a leaked private: anchor the per-anchor search on a
+    // chosen cell of a crafted board and inspect the finding it records. Public
+    // *static*, for the reason FinnedSwordfishTechnique::find_finned_swordfish
+    // gives.
+    static bool find_finned_jellyfish(const Board &, const Cell &, const Value &, FindingList &out);
+};
+
+using FinnedJellyfishTechnique = BasicFinnedJellyfishTechnique<3>;
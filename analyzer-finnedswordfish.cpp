@@ -9,6 +9,7 @@
 #include "cell.h"
 #include "coord.h"
 
+#include <array>
 #include <cassert>
 #include <memory>
 #include <utility>
@@ -17,31 +18,41 @@
 using analyzer_fish::act_on_finned_fish;
 using analyzer_fish::anchors_of;
 using analyzer_fish::find_finned_fish;
+using analyzer_fish::LineMasks;
+using analyzer_fish::may_have_bases;
 
 namespace {
 
 // Record what the shared worker found as a FinnedSwordfishFinding: one anchor per
 // base line, plus the fins in the order the worker discovered them.
 template<class Bases>
-std::shared_ptr<Finding> make_finding(const Bases &b, std::vector<Coord> fins,
-                                      const Value &value, bool by_row) {
-    return std::make_shared<FinnedSwordfishFinding>(value, anchors_of(b), std::move(fins), by_row);
+const Finding &make_finding(const Bases &b, std::vector<Coord> fins,
+                            const Value &value, bool by_row, FindingList &out) {
+    return out.emplace<FinnedSwordfishFinding>(value, anchors_of(b), std::move(fins), by_row);
+}
+
+// The per-anchor search on the value's line masks, which find() builds once per
+// value rather than once per anchor.
+template<size_t Box>
+bool find_at(const BasicCell<Box> &cell, const Value &value, const LineMasks<Box> &masks, FindingList &out) {
+    // Try row-based (eliminations in columns); if not found, try column-based
+    // (eliminations in rows). The base lines' kind cannot be deduced from the
+    // argument list -- the cover is chosen, not handed in -- so it is named.
+    if (find_finned_fish<3, BasicRow<Box>>(cell, value, masks, BasicFinnedSwordfishTechnique<Box>::kName,
+            [&](const auto &b, auto fins) -> const Finding & { return make_finding(b, std::move(fins), value, true, out); }, out))
+        return true;
+    return find_finned_fish<3, BasicColumn<Box>>(cell, value, masks, BasicFinnedSwordfishTechnique<Box>::kName,
+            [&](const auto &b, auto fins) -> const Finding & { return make_finding(b, std::move(fins), value, false, out); }, out);
 }
 
 } // namespace
 
-bool FinnedSwordfishTechnique::find_finned_swordfish(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
+template<size_t Box>
+bool BasicFinnedSwordfishTechnique<Box>::find_finned_swordfish(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
     assert(cell.isNote());
     assert(cell.check(value));
 
-    // Try row-based (eliminations in columns); if not found, try column-based
-    // (eliminations in rows). EliminationSet cannot be deduced from the argument
-    // list -- the cover is chosen, not handed in -- so both are named.
-    if (find_finned_fish<3, Row, Column>(board, cell, value, board.row(cell), board.rows(), kName,
-            [&](const auto &b, auto fins) { return make_finding(b, std::move(fins), value, true); }, out))
-        return true;
-    return find_finned_fish<3, Column, Row>(board, cell, value, board.column(cell), board.columns(), kName,
-            [&](const auto &b, auto fins) { return make_finding(b, std::move(fins), value, false); }, out);
+    return find_at(cell, value, LineMasks<Box>(board, value), out);
 }
 
 // https://www.sudokuwiki.org/Finned_Swordfish
@@ -49,9 +60,13 @@ bool FinnedSwordfishTechnique::find_finned_swordfish(const Board &board, const C
 // outside the three cover lines, so long as all of those fins share one nonet. The
 // value is then eliminated from the cover lines' cells inside that nonet, outside
 // the base lines.
-bool FinnedSwordfishTechnique::find(const Board &board, FindingList &out) const {
+template<size_t Box>
+bool BasicFinnedSwordfishTechnique<Box>::find(const Board &board, FindingList &out) const {
     assert(out.empty());
 
+    std::array<LineMasks<Box>, Geometry<Box>::kSide> masks;
+    for (Value value : value_range<Box>()) masks[value - 1] = LineMasks<Box>(board, value);
+
     for (auto const &cell: board.cells()) {
         // is this a note cell?
         if (!cell.isNote()) continue;
@@ -60,14 +75,21 @@ bool FinnedSwordfishTechnique::find(const Board &board, FindingList &out) const
         for (auto const &value : cell.notes().values()) {
             // let's see if we can anchor a finned Swordfish in this cell for this
             // value; stop at the first one found
-            if (find_finned_swordfish(board, cell, value, out)) return true;
+            if (find_at(cell, value, masks[value - 1], out)) return true;
         }
     }
 
     return false;
 }
 
-bool FinnedSwordfishTechnique::apply(Board &board, FindingList &mine) const {
+// Three base lines, with room on each for fins.
+template<size_t Box>
+bool BasicFinnedSwordfishTechnique<Box>::may_fire(const Board &board) const {
+    return may_have_bases(board, 3, 3 + Box);
+}
+
+template<size_t Box>
+bool BasicFinnedSwordfishTechnique<Box>::apply(Board &board, FindingList &mine) const {
     if (mine.empty()) return false;
     assert(mine.size() == 1);
 
@@ -75,10 +97,14 @@ bool FinnedSwordfishTechnique::apply(Board &board, FindingList &mine) const {
 
     // Row-based pattern eliminates from columns; column-based, from rows.
     bool did_act = fs.is_row_based
-        ? act_on_finned_fish<3, Column>(board, fs.value, fs.anchors, fs.fins, name())
-        : act_on_finned_fish<3, Row>(board, fs.value, fs.anchors, fs.fins, name());
+        ? act_on_finned_fish<3, BasicColumn<Box>>(board, fs.value, fs.anchors, fs.fins, name())
+        : act_on_finned_fish<3, BasicRow<Box>>(board, fs.value, fs.anchors, fs.fins, this->name());
 
     mine.clear();
     assert(did_act);
     return did_act;
 }
+
+template class BasicFinnedSwordfishTechnique<3>;
+template class BasicFinnedSwordfishTechnique<4>;
+template class BasicFinnedSwordfishTechnique<5>;
@@ -28,10 +28,11 @@
 // The relationship to FinnedXWingTechnique is the same one SwordfishTechnique has
 // to XWingTechnique: the same rule at N=3 rather than N=2 -- and since #58 the two
 // are not written out separately but share one worker,
-// analyzer_fish::find_finned_fish, instantiated at N=3 here and at N=2 there.
+// analyzer_fish::find_finned_fish, instantiated at N=3 here and at N=2 there
+// (and at N=4 by finned Jellyfish).
 //
 // That retires most of the twin rule these two were under: an algorithm change now
-// has one place to be made and reaches both fish by construction. What still needs
+// has one place to be made and reaches every finned fish by construction. What still needs
 // pairing is what stayed per-technique -- the Finding, the record callback, the
 // whitebox cases, and prose like this paragraph -- so a change to one fish's
 // *glue* is still a prompt to look at the other's.
@@ -93,7 +94,11 @@ struct FinnedSwordfishFinding : Finding {
     }
 };
 
-class FinnedSwordfishTechnique : public Technique {
+template<size_t Box>
+class BasicFinnedSwordfishTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using Cell = BasicCell<Box>;
+
 public:
     // Written once, for the reason XWingTechnique::kName gives.
     static constexpr const char *kName = "FS";
@@ -104,6 +109,7 @@ public:
 
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
 
     // Whitebox seam, NOT a leaked private: anchor the per-anchor search on a
     // chosen cell of a crafted board and inspect the finding it records --
@@ -116,3 +122,5 @@ public:
     // FinnedXWingTechnique::find_finned_xwing.
     static bool find_finned_swordfish(const Board &, const Cell &, const Value &, FindingList &out);
 };
+
+using FinnedSwordfishTechnique = BasicFinnedSwordfishTechnique<3>;
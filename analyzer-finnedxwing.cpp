@@ -9,6 +9,7 @@
 #include "cell.h"
 #include "coord.h"
 
+#include <array>
 #include <cassert>
 #include <memory>
 #include <utility>
@@ -17,31 +18,41 @@
 using analyzer_fish::act_on_finned_fish;
 using analyzer_fish::anchors_of;
 using analyzer_fish::find_finned_fish;
+using analyzer_fish::LineMasks;
+using analyzer_fish::may_have_bases;
 
 namespace {
 
 // Record what the shared worker found as a FinnedXWingFinding: one anchor per
 // base line, plus the fins in the order the worker discovered them.
 template<class Bases>
-std::shared_ptr<Finding> make_finding(const Bases &b, std::vector<Coord> fins,
-                                      const Value &value, bool by_row) {
-    return std::make_shared<FinnedXWingFinding>(value, anchors_of(b), std::move(fins), by_row);
+const Finding &make_finding(const Bases &b, std::vector<Coord> fins,
+                            const Value &value, bool by_row, FindingList &out) {
+    return out.emplace<FinnedXWingFinding>(value, anchors_of(b), std::move(fins), by_row);
+}
+
+// The per-anchor search on the value's line masks, which find() builds once per
+// value rather than once per anchor.
+template<size_t Box>
+bool find_at(const BasicCell<Box> &cell, const Value &value, const LineMasks<Box> &masks, FindingList &out) {
+    // Try row-based (eliminations in columns); if not found, try column-based
+    // (eliminations in rows). The base lines' kind cannot be deduced from the
+    // argument list -- the cover is chosen, not handed in -- so it is named.
+    if (find_finned_fish<2, BasicRow<Box>>(cell, value, masks, BasicFinnedXWingTechnique<Box>::kName,
+            [&](const auto &b, auto fins) -> const Finding & { return make_finding(b, std::move(fins), value, true, out); }, out))
+        return true;
+    return find_finned_fish<2, BasicColumn<Box>>(cell, value, masks, BasicFinnedXWingTechnique<Box>::kName,
+            [&](const auto &b, auto fins) -> const Finding & { return make_finding(b, std::move(fins), value, false, out); }, out);
 }
 
 } // namespace
 
-bool FinnedXWingTechnique::find_finned_xwing(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
+template<size_t Box>
+bool BasicFinnedXWingTechnique<Box>::find_finned_xwing(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
     assert(cell.isNote());
     assert(cell.check(value));
 
-    // Try row-based (eliminations in columns); if not found, try column-based
-    // (eliminations in rows). EliminationSet cannot be deduced from the argument
-    // list -- the cover is chosen, not handed in -- so both are named.
-    if (find_finned_fish<2, Row, Column>(board, cell, value, board.row(cell), board.rows(), kName,
-            [&](const auto &b, auto fins) { return make_finding(b, std::move(fins), value, true); }, out))
-        return true;
-    return find_finned_fish<2, Column, Row>(board, cell, value, board.column(cell), board.columns(), kName,
-            [&](const auto &b, auto fins) { return make_finding(b, std::move(fins), value, false); }, out);
+    return find_at(cell, value, LineMasks<Box>(board, value), out);
 }
 
 // https://www.sudokuwiki.org/Finned_X_Wing
@@ -49,9 +60,13 @@ bool FinnedXWingTechnique::find_finned_xwing(const Board &board, const Cell &cel
 // outside the two cover lines, so long as all of those fins share one nonet. The
 // value is then eliminated from the cover lines' cells inside that nonet, outside
 // the base lines.
-bool FinnedXWingTechnique::find(const Board &board, FindingList &out) const {
+template<size_t Box>
+bool BasicFinnedXWingTechnique<Box>::find(const Board &board, FindingList &out) const {
     assert(out.empty());
 
+    std::array<LineMasks<Box>, Geometry<Box>::kSide> masks;
+    for (Value value : value_range<Box>()) masks[value - 1] = LineMasks<Box>(board, value);
+
     for (auto const &cell: board.cells()) {
         // is this a note cell?
         if (!cell.isNote()) continue;
@@ -60,14 +75,21 @@ bool FinnedXWingTechnique::find(const Board &board, FindingList &out) const {
         for (auto const &value : cell.notes().values()) {
             // let's see if we can anchor a finned X-Wing in this cell for this
             // value; stop at the first one found
-            if (find_finned_xwing(board, cell, value, out)) return true;
+            if (find_at(cell, value, masks[value - 1], out)) return true;
         }
     }
 
     return false;
 }
 
-bool FinnedXWingTechnique::apply(Board &board, FindingList &mine) const {
+// Two base lines, with room on each for fins.
+template<size_t Box>
+bool BasicFinnedXWingTechnique<Box>::may_fire(const Board &board) const {
+    return may_have_bases(board, 2, 2 + Box);
+}
+
+template<size_t Box>
+bool BasicFinnedXWingTechnique<Box>::apply(Board &board, FindingList &mine) const {
     if (mine.empty()) return false;
     assert(mine.size() == 1);
 
@@ -75,10 +97,14 @@ bool FinnedXWingTechnique::apply(Board &board, FindingList &mine) const {
 
     // Row-based pattern eliminates from columns; column-based, from rows.
     bool did_act = fx.is_row_based
-        ? act_on_finned_fish<2, Column>(board, fx.value, fx.anchors, fx.fins, name())
-        : act_on_finned_fish<2, Row>(board, fx.value, fx.anchors, fx.fins, name());
+        ? act_on_finned_fish<2, BasicColumn<Box>>(board, fx.value, fx.anchors, fx.fins, name())
+        : act_on_finned_fish<2, BasicRow<Box>>(board, fx.value, fx.anchors, fx.fins, this->name());
 
     mine.clear();
     assert(did_act);
     return did_act;
 }
+
+template class BasicFinnedXWingTechnique<3>;
+template class BasicFinnedXWingTechnique<4>;
+template class BasicFinnedXWingTechnique<5>;
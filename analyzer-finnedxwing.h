@@ -83,7 +83,11 @@ struct FinnedXWingFinding : Finding {
     }
 };
 
-class FinnedXWingTechnique : public Technique {
+template<size_t Box>
+class BasicFinnedXWingTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using Cell = BasicCell<Box>;
+
 public:
     // Written once, for the reason XWingTechnique::kName gives.
     static constexpr const char *kName = "FX";
@@ -94,6 +98,7 @@ public:
 
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
 
     // Whitebox seam, NOT a leaked private: anchor the per-anchor search on a
     // chosen cell of a crafted board and inspect the finding it records --
@@ -105,3 +110,5 @@ public:
     // and SwordfishTechnique::find_swordfish.
     static bool find_finned_xwing(const Board &, const Cell &, const Value &, FindingList &out);
 };
+
+using FinnedXWingTechnique = BasicFinnedXWingTechnique<3>;
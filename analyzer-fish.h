@@ -5,37 +5,36 @@
 #include "board.h"
 #include "row.h"
 #include "column.h"
-#include "nonet.h"
 #include "cell.h"
 #include "coord.h"
 #include "technique.h"
 #include "verbose.h"
 
-#include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
-// The fish family -- X-Wing, Swordfish, and the finned variant of each -- is one
-// rule at two sizes, and this is where that rule lives.
+// The fish family -- X-Wing, Swordfish, Jellyfish, and the finned variant of
+// each -- is one rule at three sizes, and this is where that rule lives.
 //
 // A fish for one value is N *base lines* (all rows, or all columns) whose
 // candidates for the value all fall on N *cover lines* of the opposite kind.
 // Each cover line then has to spend its candidate for the value on a base line,
 // so every other candidate for it on the cover can go. X-Wing is that at N=2,
-// Swordfish at N=3.
+// Swordfish at N=3, Jellyfish at N=4.
 //
 // A *finned* fish relaxes the confinement: base candidates are allowed off the
 // cover -- the fins -- provided every fin sits in a single nonet. If every fin
 // is false the plain fish holds after all; if some fin is true its nonet already
 // holds the value; so the cells safe under both branches are those that see
-// every fin, which is the fin's nonet. Finned X-Wing is that at N=2, finned
-// Swordfish at N=3.
+// every fin, which is the fin's nonet. Finned X-Wing, finned Swordfish and finned
+// Jellyfish are that at N=2, 3 and 4.
 //
 // There are deliberately *two* workers here rather than one (#58 weighed the
 // alternative): find_plain_fish and find_finned_fish, each parameterised by N.
@@ -47,62 +46,166 @@
 // owns its registry entry, tag, Finding subtype, bucket, tier and file; what is
 // shared is the scan body, not the technique.
 //
+// Both workers run on LineMasks: for one value, a mask per line of the cross
+// lines it is a candidate on -- 9 bits on a 9x9 board. A base line's candidates are then one word,
+// a set of base lines' cross lines is the OR of theirs, and "N cover lines" is a
+// popcount -- where the search once copied each line's candidate cells into a
+// vector and deduplicated cross lines with a linear find.
+//
 // Two orderings in here are output contracts rather than implementation details,
 // and each is called out where it is established:
 //   - the order cover subsets are tried (for_each_cover), because every fish
 //     stops at its first hit, so it decides which pattern gets recorded;
-//   - the order cover lines are swept in act (cover_of), because it decides the
-//     order the elimination lines print in.
+//   - the order cover lines are swept in act (act_on_plain_fish), because it
+//     decides the order the elimination lines print in.
+// Both are the orders the cell-walking search had, bit order standing in for
+// walk order: a line's cells and a mask's bits both ascend with the cross index.
 //
 // Wrapped in a named namespace so these collision-prone generic names do not
 // land at global scope for every TU that includes this header.
+//
+// The lines are the unit views, Row<Box> and Column<Box>, so every size of board
+// runs the same code: LineOf reads the board size and the kind of line off the
+// view type, and a mask over the lines of one kind is the board's own
+// position mask type.
 namespace analyzer_fish {
 
-// The cells of `set` that still hold `value` as a note.
-template<class Set>
-std::vector<Cell> candidates(const Set &set, const Value &value) {
-    std::vector<Cell> candidates;
+template<class Line> struct LineOf;
+template<size_t Box> struct LineOf<BasicRow<Box>> {
+    static constexpr size_t kBox = Box;
+    static constexpr bool kColumn = false;
+    using Cross = BasicColumn<Box>;
+};
+template<size_t Box> struct LineOf<BasicColumn<Box>> {
+    static constexpr size_t kBox = Box;
+    static constexpr bool kColumn = true;
+    using Cross = BasicRow<Box>;
+};
 
-    for (auto const &cell : set) {
-        if (!cell.isNote()) continue;
-        if (!cell.check(value)) continue;
+// A set of lines of one kind, as a mask: one bit per line.
+template<class Line>
+using LineMask = typename Geometry<LineOf<Line>::kBox>::Notes;
+
+// One value's candidates, one mask per line: bit c of rows[r] is set when cell
+// (r, c) holds the value as a note, and bit r of columns[c] is the same cell
+// seen from its column. Those are the board's own position masks for the row
+// and column units (Board::positions), so building them is eighteen reads on a
+// 9x9 board.
+template<size_t Box>
+struct LineMasks {
+    using G = Geometry<Box>;
+    using Masks = std::array<typename G::Notes, G::kSide>;
+
+    Masks rows{};
+    Masks columns{};
+
+    LineMasks() = default;
+    LineMasks(const BasicBoard<Box> &board, const Value &value) {
+        for (size_t line = 0; line < G::kSide; line++) {
+            rows[line]    = board.positions(line, value);
+            columns[line] = board.positions(G::kSide + line, value);
+        }
+    }
 
-        candidates.push_back(cell);
+    // The masks of the lines of kind Line -- a fish's base lines when Line is
+    // its CandidateSet, its cross lines when it is the EliminationSet.
+    template<class Line>
+    const Masks &of() const {
+        if constexpr (LineOf<Line>::kColumn) return columns;
+        else                                 return rows;
     }
+};
 
-    return candidates;
+// The other kind of line: the base lines and the cover are always opposite
+// kinds, so one is derived from the other rather than left for a caller to pass
+// -- a mismatched pair (say <Row, Row>) would compile and silently misbehave.
+template<class Line>
+using CrossOf = typename LineOf<Line>::Cross;
+
+// The cell where line `line` of kind Line meets cross line `cross`.
+template<class Line>
+Coord cell_at(size_t line, size_t cross) {
+    if constexpr (LineOf<Line>::kColumn) return Coord(cross, line);
+    else                                 return Coord(line, cross);
 }
 
-// The Row or Column (selected by the Line type) that `x` (a Cell or Coord)
-// lies on. Board exposes both row()/column() overloads for Cell and Coord, so
-// one helper serves find and act, for cells and coords, with the row/column
-// choice made once here instead of at every call site.
-template<class Line, class CellOrCoord>
-const Line &line_of(const Board &board, const CellOrCoord &x) {
-    if constexpr (std::is_same_v<Line, Column>) return board.column(x);
-    else                                        return board.row(x);
+// The index of the line of kind Line through `coord`, and of its cross line.
+template<class Line>
+size_t line_of(const Coord &coord) {
+    if constexpr (LineOf<Line>::kColumn) return coord.column();
+    else                                 return coord.row();
+}
+template<class Line>
+size_t cross_of(const Coord &coord) { return line_of<CrossOf<Line>>(coord); }
+
+// The Box lines (three on a 9x9 board) of the band or stack holding line
+// `line`, as a mask.
+template<size_t Box>
+constexpr typename Geometry<Box>::Notes band_of(size_t line) {
+    using Mask = typename Geometry<Box>::Notes;
+    return Mask(Mask((1u << Box) - 1) << (line / Box * Box));
+}
+
+// The prefilter every fish shares (Technique::may_fire): does some value, along
+// lines of one kind, have `n` lines that could be base lines -- each holding at
+// least two candidates and at most `most`? A plain fish's base line holds at
+// most N, one per cover line; a finned one's at most N+Box (N+3 on a 9x9
+// board), the bound its search puts on the whole union. Late in a solve most
+// values are placed in most lines, and this turns the search away on one
+// popcount per line.
+template<size_t Box>
+bool may_have_bases(const BasicBoard<Box> &board, size_t n, size_t most) {
+    constexpr size_t kSide = Geometry<Box>::kSide;
+    for (Value value : value_range<Box>()) {
+        for (size_t first : { size_t(0), kSide }) {
+            size_t lines = 0;
+            for (size_t unit = first; unit < first + kSide; unit++) {
+                const size_t count = std::popcount(board.positions(unit, value));
+                lines += count >= 2 && count <= most;
+            }
+            if (lines >= n) return true;
+        }
+    }
+    return false;
 }
 
-// The N base lines of a fish, each paired with its candidate cells for the value
-// under search. `lines[i]` and `candidates[i]` are parallel, so a fish's own
-// vocabulary -- "the first candidate of the second base line" -- indexes
-// straight through. A search fills these one line at a time, so a prefix of the
-// first `count` entries is meaningful before all N are chosen.
+// The N base lines of a fish: each one's index, and its candidates for the value
+// under search as a mask over the cross lines. `lines[i]` and `masks[i]` are
+// parallel, so a fish's own vocabulary -- "the first candidate of the second base
+// line" -- indexes straight through. A search fills these one line at a time, so
+// a prefix of the first `count` entries is meaningful before all N are chosen.
 template<class CandidateSet, size_t N>
 struct Bases {
-    std::array<const CandidateSet *, N> lines{};
-    std::array<std::vector<Cell>, N>    candidates{};
-
-    // Does `cell` lie on one of the base lines? The base lines hold the pattern,
-    // so their own candidates are part of the fish and are never eliminated.
-    // This is the one gate the family cannot get wrong and stay sound, and it is
-    // the reason it is a fold over a container here rather than the chain of
-    // `cset.contains(c) || cset2.contains(c) || ...` terms each fish used to
-    // spell out at its own arity: a fold cannot be written with a term missing.
-    bool contains(const Cell &cell) const {
-        for (const auto *line : lines)
-            if (line->contains(cell)) return true;
-        return false;
+    using Mask = LineMask<CandidateSet>;
+
+    std::array<size_t, N> lines{};
+    std::array<Mask, N>   masks{};
+
+    // The base lines as a mask over their own kind. The base lines hold the
+    // pattern, so their own candidates are part of the fish and are never
+    // eliminated. This is the one gate the family cannot get wrong and stay
+    // sound, and it is built as a fold over every base line rather than spelled
+    // out as one term per line, each fish at its own arity: a fold cannot be
+    // written with a term missing.
+    Mask lines_mask() const {
+        Mask mask = 0;
+        for (size_t line : lines) mask |= Mask(Mask(1) << line);
+        return mask;
+    }
+
+    // The cross lines the base lines' candidates touch, as a mask.
+    Mask crosses() const {
+        Mask mask = 0;
+        for (Mask m : masks) mask |= m;
+        return mask;
+    }
+
+    // The k-th candidate cell of base line i, in walk order.
+    Coord candidate(size_t i, size_t k) const {
+        Mask m = masks[i];
+        for (; k > 0; --k) { assert(m); m &= m - 1; }
+        assert(m);
+        return cell_at<CandidateSet>(lines[i], std::countr_zero(m));
     }
 };
 
@@ -113,7 +216,7 @@ struct Bases {
 // default constructor, so a std::array of them cannot be filled after the fact.
 template<class CandidateSet, size_t N, size_t... I>
 std::array<Coord, N> anchors_of(const Bases<CandidateSet, N> &bases, std::index_sequence<I...>) {
-    return { bases.candidates[I][0].coord()... };
+    return { bases.candidate(I, 0)... };
 }
 
 template<class CandidateSet, size_t N>
@@ -121,119 +224,6 @@ std::array<Coord, N> anchors_of(const Bases<CandidateSet, N> &bases) {
     return anchors_of(bases, std::make_index_sequence<N>{});
 }
 
-// Does `cell` lie on any of `lines`? Takes any range of line pointers, so the
-// same fold serves the cover-as-vector a search builds and the cover-as-array a
-// recorded finding recovers.
-template<class Lines>
-bool on_any(const Lines &lines, const Cell &cell) {
-    for (const auto *line : lines)
-        if (line->contains(cell)) return true;
-    return false;
-}
-
-// The distinct cross lines that the first `count` base lines' candidates touch,
-// in first-encounter order: base line by base line, and within each line in the
-// order its candidates are walked.
-//
-// That order is load-bearing for a finned fish, where it decides which cover
-// subset for_each_cover tries first and so which pattern a first-hit search
-// records. It is deliberately *not* a set of pointers: a std::set here would
-// order by address, making the recorded pattern a function of the board's memory
-// layout.
-//
-// `count` is what lets a search prune a partial pattern: a plain fish rejects a
-// prefix whose cross lines already exceed its cover budget without building the
-// rest of the set.
-template<class EliminationSet, class CandidateSet, size_t N>
-std::vector<const EliminationSet *> crosses_of(const Board &board,
-        const Bases<CandidateSet, N> &bases, size_t count) {
-    assert(count <= N);
-
-    std::vector<const EliminationSet *> crosses;
-    for (size_t i = 0; i < count; i++)
-        for (auto const &c : bases.candidates[i]) {
-            const EliminationSet *e = &line_of<EliminationSet>(board, c);
-            if (std::find(crosses.begin(), crosses.end(), e) == crosses.end())
-                crosses.push_back(e);
-        }
-
-    return crosses;
-}
-
-// Recover a recorded fish's cover: the cross lines its base candidates lie on,
-// skipping the ones only a fin reaches. Every cover line comes back, and nothing
-// else can -- each was chosen out of the crosses, so it carries at least one base
-// candidate, and that candidate is on the cover and therefore not a fin -- which
-// is what the size assert states, and what makes this a recovery rather than a
-// guess. For a plain fish `fins` is empty and the cover is simply every cross
-// line the base candidates touch.
-//
-// That assert is a bound, not a restatement: the std::copy below writes into a
-// fixed-size array, so a cover that came back larger than N would overflow it. It
-// cannot -- find() required exactly N cross lines on this same board, and
-// SolverState re-analyzes after every mutation, so a finding is always applied to
-// the board its find ran on -- but the assert is the only thing standing between
-// that reasoning and a stack write, and asserts ship here (no -DNDEBUG). Left as
-// std::copy rather than copy_n deliberately: bounding the write would trade an
-// abort for a silent truncation, which is worse to debug.
-//
-// Note what is *not* done: sweeping every cross line for a *finned* fish, without
-// subtracting the fins, would drag in the line the fin sits on, which the fish
-// says nothing about.
-//
-// Sorted, and that is an output contract: act sweeps the cover in this order, so
-// it is the order a fish's elimination lines print in. The line types order by
-// index, which is the order the plain fish printed in before they shared this
-// code -- X-Wing swept the cover line through its anchor before the one through
-// its diagonal, and Swordfish swept a std::set of line pointers whose addresses
-// ascend with index because Board holds its lines in a vector. Neither is a
-// property to leave resting on memory layout, hence an explicit sort by index.
-template<class EliminationSet, class CandidateSet, size_t N>
-std::array<const EliminationSet *, N> cover_of(const Board &board,
-        const Bases<CandidateSet, N> &bases, const std::vector<Coord> &fins) {
-    std::vector<const EliminationSet *> cover;
-    for (size_t i = 0; i < N; i++)
-        for (auto const &c : bases.candidates[i]) {
-            if (std::find(fins.begin(), fins.end(), c.coord()) != fins.end()) continue;
-            const EliminationSet *e = &line_of<EliminationSet>(board, c);
-            if (std::find(cover.begin(), cover.end(), e) == cover.end())
-                cover.push_back(e);
-        }
-    assert(cover.size() == N);
-
-    std::sort(cover.begin(), cover.end(),
-              [](const EliminationSet *a, const EliminationSet *b) { return *a < *b; });
-
-    std::array<const EliminationSet *, N> sorted{};
-    std::copy(cover.begin(), cover.end(), sorted.begin());
-    return sorted;
-}
-
-// Would this fish eliminate `cell`? It holds the value, it lies on a cover line,
-// and it lies outside every base line. Both halves of every fish run through this
-// one predicate: find asks whether a region holds such a cell at all, act clears
-// the value from each one it finds, and the plain and finned fish differ only in
-// the region they ask about -- the cover lines themselves, versus the fin's nonet.
-template<class Cover, class CandidateSet, size_t N>
-bool eliminable(const Cell &cell, const Value &value, const Cover &cover,
-                const Bases<CandidateSet, N> &bases) {
-    if (!cell.isNote()) return false;
-    if (!cell.check(value)) return false;
-    if (!on_any(cover, cell)) return false;
-    return !bases.contains(cell);
-}
-
-// Does `region` hold anything this fish would eliminate? A fish that eliminates
-// nothing is not recorded: it is a true statement about the board that moves the
-// solver nowhere.
-template<class Region, class Cover, class CandidateSet, size_t N>
-bool any_eliminable(const Region &region, const Value &value, const Cover &cover,
-                    const Bases<CandidateSet, N> &bases) {
-    for (auto const &cell : region)
-        if (eliminable(cell, value, cover, bases)) return true;
-    return false;
-}
-
 // Grow `bases` -- already filled through `filled` lines -- by every ascending
 // choice of the lines still missing, and call `body(bases)` on each complete set
 // of N. `accept(bases, i)` gates line `i` as it is added, which is where a family
@@ -244,142 +234,144 @@ bool any_eliminable(const Region &region, const Value &value, const Cover &cover
 // reached and {r4,r1} is not. Stops at the first `body` returning true, which is
 // what makes every fish a first-hit search.
 template<class CandidateSet, size_t N, class Accept, class Body>
-bool extend_bases(const std::vector<CandidateSet> &csets, const Value &value,
+bool extend_bases(const typename LineMasks<LineOf<CandidateSet>::kBox>::Masks &base,
                   Bases<CandidateSet, N> &bases, size_t filled,
                   const Accept &accept, const Body &body) {
     assert(filled > 0);  // the anchor's own line fills bases.lines[0]
     if (filled == N) return body(bases);
 
-    for (auto const &next : csets) {
-        if (!(*bases.lines[filled - 1] < next)) continue;
-
-        bases.lines[filled] = &next;
-        bases.candidates[filled] = candidates(next, value);
+    for (size_t next = bases.lines[filled - 1] + 1; next < base.size(); next++) {
+        bases.lines[filled] = next;
+        bases.masks[filled] = base[next];
         if (!accept(bases, filled)) continue;
 
-        if (extend_bases(csets, value, bases, filled + 1, accept, body)) return true;
+        if (extend_bases(base, bases, filled + 1, accept, body)) return true;
     }
 
     return false;
 }
 
-// Every N-line subset of `crosses`, lexicographic by index, handed to `body` in
-// `cover`. At two base lines that is the (i, j) pair walk a finned X-Wing spells
-// out and at three the (i, j, k) triple walk a finned Swordfish spells out -- the
-// same subsets in the same order, which is what keeps a first-hit search
-// recording the pattern it recorded before this was shared. Stops at the first
-// `body` returning true.
-template<class EliminationSet, size_t N, class Body>
-bool for_each_cover(const std::vector<const EliminationSet *> &crosses,
-                    std::array<const EliminationSet *, N> &cover, size_t chosen, size_t from,
-                    const Body &body) {
+// Every N-line subset of `crosses` -- the first `count` entries -- lexicographic
+// by position, handed to `body` as a mask. At two base lines that is the (i, j)
+// pair walk a finned X-Wing once spelled out and at three the (i, j, k) triple
+// walk a finned Swordfish did -- the same subsets in the same order, which is
+// what keeps a first-hit search recording the pattern it recorded before this
+// was shared. Stops at the first `body` returning true.
+template<size_t N, class Mask, size_t Side, class Body>
+bool for_each_cover(const std::array<uint8_t, Side> &crosses, size_t count,
+                    Mask cover, size_t chosen, size_t from, const Body &body) {
     if (chosen == N) return body(cover);
 
     // Stop once too few lines remain to finish the subset.
-    for (size_t i = from; i + (N - chosen) <= crosses.size(); i++) {
-        cover[chosen] = crosses[i];
-        if (for_each_cover(crosses, cover, chosen + 1, i + 1, body)) return true;
-    }
+    for (size_t i = from; i + (N - chosen) <= count; i++)
+        if (for_each_cover<N>(crosses, count, Mask(cover | Mask(1) << crosses[i]), chosen + 1, i + 1, body))
+            return true;
 
     return false;
 }
 
-// Find a plain fish of N base lines, anchored on `cell` for `value`, with `cset`
-// the first base line and `csets` all the lines parallel to it. `record` turns the
-// pattern into the technique's own Finding; `name` is its output tag. find() stops
-// at the first hit, so `out` holds at most one entry (asserted below).
+// Find a plain fish of N base lines, anchored on `cell` for `value`, with the
+// line of kind CandidateSet through `cell` the first base line. `masks` are the
+// value's line masks. `record` turns the pattern into the technique's own
+// Finding, recorded in `out`, and returns it; `name` is its output tag. find()
+// stops at the first hit, so `out` holds at most one entry (asserted below).
 //
-// This is X-Wing at N=2 and Swordfish at N=3.
-template<size_t N, class CandidateSet, class EliminationSet, class Record>
-bool find_plain_fish(const Board &board, const Cell &cell, const Value &value,
-                     const CandidateSet &cset, const std::vector<CandidateSet> &csets,
+// This is X-Wing at N=2, Swordfish at N=3 and Jellyfish at N=4.
+template<size_t N, class CandidateSet, class Record>
+bool find_plain_fish(const BasicCell<LineOf<CandidateSet>::kBox> &cell, const Value &value,
+                     const LineMasks<LineOf<CandidateSet>::kBox> &masks,
                      const char *name, const Record &record, FindingList &out) {
+    using Mask = LineMask<CandidateSet>;
     assert(cell.isNote());
     assert(cell.check(value));
-    assert(cset.contains(cell));
+
+    const auto &base  = masks.template of<CandidateSet>();
+    const auto &cross = masks.template of<CrossOf<CandidateSet>>();
 
     // Confinement, checked as the pattern grows: N base lines whose candidates
     // fall on N cross lines. A prefix already touching more than N cross lines
     // cannot be completed into a fish, so it is rejected before the rest of the
-    // set is built.
+    // set is chosen.
     //
-    // This one budget subsumes the per-line candidate bounds the two plain fish
-    // used to spell out separately -- X-Wing's "exactly two per base line",
+    // This one budget subsumes the per-line candidate bounds the plain fish used
+    // to spell out separately -- X-Wing's "exactly two per base line",
     // Swordfish's "two or three" -- because a line's candidates for one value lie
     // one per cross line, so "at most N candidates in the line" and "at most N
     // cross lines touched" are the same bound. The floor is a separate matter and
     // is not a bound of the fish at all: a line holding a *single* candidate for
     // the value is a hidden single, a strictly cheaper deduction that fires much
     // earlier in the cascade, so the family starts at two per base line.
-    auto accept = [&](const Bases<CandidateSet, N> &b, size_t filled) {
-        if (b.candidates[filled].size() < 2) return false;
-        return crosses_of<EliminationSet>(board, b, filled + 1).size() <= N;
+    auto accept = [](const Bases<CandidateSet, N> &b, size_t filled) {
+        if (std::popcount(b.masks[filled]) < 2) return false;
+        Mask touched = 0;
+        for (size_t i = 0; i <= filled; i++) touched |= b.masks[i];
+        return size_t(std::popcount(touched)) <= N;
     };
 
     Bases<CandidateSet, N> bases;
-    bases.lines[0] = &cset;
-    bases.candidates[0] = candidates(cset, value);
+    bases.lines[0] = line_of<CandidateSet>(cell.coord());
+    bases.masks[0] = base[bases.lines[0]];
     if (!accept(bases, 0)) return false;
 
-    // If cell is not the first candidate, we've already considered this cset and
+    // If cell is not the first candidate, we've already considered this line and
     // found it unsuitable.
-    if (cell != bases.candidates[0][0]) return false;
+    if (size_t(std::countr_zero(bases.masks[0])) != cross_of<CandidateSet>(cell.coord())) return false;
 
-    return extend_bases(csets, value, bases, 1, accept, [&](const Bases<CandidateSet, N> &b) {
+    return extend_bases(base, bases, 1, accept, [&](const Bases<CandidateSet, N> &b) {
         // Exactly N cover lines. `accept` held the union at N or below, so what is
         // left to reject is a union that came out *short*: three base lines
         // sharing two cross lines, say. Vacuous at N=2 -- a first base line of
         // exactly two candidates touches two cross lines and the prune keeps it
-        // there -- and a live gate at N=3.
-        //
-        // Deliberately recomputed rather than carried out of `accept`, which
-        // evaluated the same walk one call earlier to test `<= N`. Handing the
-        // cover back would mean `accept` returning a value instead of a verdict,
-        // complicating extend_bases' contract for both families to save a walk over
-        // at most nine cells, and it does not show up in a corpus benchmark.
-        auto cover = crosses_of<EliminationSet>(board, b, N);
-        if (cover.size() != N) return false;
+        // there -- and a live gate from N=3.
+        const Mask cover = b.crosses();
+        if (size_t(std::popcount(cover)) != N) return false;
 
         // There is something to eliminate iff some cover line holds a candidate
         // for `value` outside the base lines. Counting ">N candidates in the line"
-        // is not equivalent at three base lines: a cover line hit by only two of
+        // is not equivalent from three base lines: a cover line hit by only two of
         // the three can have exactly three candidates, one of which lies outside
         // the pattern and is eliminable. (At two base lines it *is* equivalent,
         // every cover line carrying exactly one candidate per base line, which is
         // why X-Wing could ask the question by count.)
+        const Mask outside = Mask(~b.lines_mask());
         bool has_eliminations = false;
-        for (const auto *line : cover)
-            if (any_eliminable(*line, value, cover, b)) { has_eliminations = true; break; }
+        for (Mask m = cover; m; m &= m - 1)
+            if (cross[std::countr_zero(m)] & outside) { has_eliminations = true; break; }
         if (!has_eliminations) return false;
 
-        auto finding = record(b);
         assert(out.empty());
-        if (sVerbose) { std::cout << "  [f" << name << "] "; finding->print(std::cout); std::cout << std::endl; }
-        out.push_back(finding);
+        const Finding &finding = record(b);
+        if (sVerbose) { narration() << "  [f" << name << "] "; finding.print(narration()); narration() << std::endl; }
         return true;
     });
 }
 
-// Find a finned fish of N base lines, anchored on `cell` for `value`, with `cset`
-// the first base line and `csets` all the lines parallel to it. `record` turns the
-// pattern and its fins into the technique's own Finding; `name` is its output tag.
-// find() stops at the first hit, so `out` holds at most one entry (asserted
-// below).
+// Find a finned fish of N base lines, anchored on `cell` for `value`, with the
+// line of kind CandidateSet through `cell` the first base line. `masks` are the
+// value's line masks. `record` turns the pattern and its fins into the
+// technique's own Finding, recorded in `out`, and returns it; `name` is its
+// output tag. find() stops at the first hit, so `out` holds at most one entry
+// (asserted below).
 //
-// This is finned X-Wing at N=2 and finned Swordfish at N=3.
+// This is finned X-Wing at N=2, finned Swordfish at N=3 and finned Jellyfish at
+// N=4.
 //
 // Where a plain fish *derives* its cover -- rejecting unless the cross lines union
 // to exactly N -- a finned fish has to *choose* N cover lines out of the union and
 // bucket what is left over as fins. That choice is the whole difference in the
 // search, and it is why a finned position is invisible to find_plain_fish: the
 // union is N+1 cross lines or more, so its size test never matches.
-template<size_t N, class CandidateSet, class EliminationSet, class Record>
-bool find_finned_fish(const Board &board, const Cell &cell, const Value &value,
-                      const CandidateSet &cset, const std::vector<CandidateSet> &csets,
+template<size_t N, class CandidateSet, class Record>
+bool find_finned_fish(const BasicCell<LineOf<CandidateSet>::kBox> &cell, const Value &value,
+                      const LineMasks<LineOf<CandidateSet>::kBox> &masks,
                       const char *name, const Record &record, FindingList &out) {
+    constexpr size_t Box = LineOf<CandidateSet>::kBox;
+    using Mask = LineMask<CandidateSet>;
     assert(cell.isNote());
     assert(cell.check(value));
-    assert(cset.contains(cell));
+
+    const auto &base  = masks.template of<CandidateSet>();
+    const auto &cross = masks.template of<CrossOf<CandidateSet>>();
 
     // A line holding a single candidate for the value is a hidden single, a
     // strictly cheaper deduction that fires much earlier in the cascade. The fish
@@ -394,61 +386,67 @@ bool find_finned_fish(const Board &board, const Cell &cell, const Value &value,
     // that is deliberately not done.
     //
     // Note what is deliberately *absent*: find_plain_fish's upper bound of N
-    // candidates per base line. That bound is not an independent rule, it is the
+    // cross lines per prefix. That bound is not an independent rule, it is the
     // confinement requirement in disguise -- N+1 candidates in a base line cannot
     // fit N cover lines -- and confinement is exactly what a fin relaxes. Here an
-    // extra candidate is a candidate fin, so bounding the count would reject the
-    // positions this search exists to find. Soundness does not depend on the
+    // extra candidate is a candidate fin, so bounding the count at N would reject
+    // the positions this search exists to find. Soundness does not depend on the
     // bound: the either/or needs only "every fin false => each base line confined
     // to the cover => a true fish", which holds however many candidates a base
     // line started with.
+    //
+    // What *is* bounded is the union at N+Box, N+3 on a 9x9 board. The fins all
+    // sit in one nonet, so their cross lines lie in one band of Box; a prefix
+    // already touching N+Box+1 cross lines leaves Box+1 outside any cover of N,
+    // and can never be a finned fish however it is completed. That prune is what
+    // keeps the N=4 search from walking every set of four base lines, and it
+    // turns away nothing the one-nonet gate below would have accepted.
     auto accept = [](const Bases<CandidateSet, N> &b, size_t filled) {
-        return b.candidates[filled].size() >= 2;
+        if (std::popcount(b.masks[filled]) < 2) return false;
+        Mask touched = 0;
+        for (size_t i = 0; i <= filled; i++) touched |= b.masks[i];
+        return size_t(std::popcount(touched)) <= N + Box;
     };
 
     Bases<CandidateSet, N> bases;
-    bases.lines[0] = &cset;
-    bases.candidates[0] = candidates(cset, value);
+    bases.lines[0] = line_of<CandidateSet>(cell.coord());
+    bases.masks[0] = base[bases.lines[0]];
     if (!accept(bases, 0)) return false;
 
-    // If cell is not the first candidate, we've already considered this cset.
-    if (cell != bases.candidates[0][0]) return false;
+    // If cell is not the first candidate, we've already considered this line.
+    if (size_t(std::countr_zero(bases.masks[0])) != cross_of<CandidateSet>(cell.coord())) return false;
 
-    return extend_bases(csets, value, bases, 1, accept, [&](const Bases<CandidateSet, N> &b) {
-        auto crosses = crosses_of<EliminationSet>(board, b, N);
+    return extend_bases(base, bases, 1, accept, [&](const Bases<CandidateSet, N> &b) {
         // N base lines confined to N cross lines is a plain fish, and the plain
         // fish runs ahead of its finned variant in the cascade. A fin needs an
         // (N+1)th cross line to live on.
-        if (crosses.size() < N + 1) return false;
-
-        std::array<const EliminationSet *, N> cover{};
-        return for_each_cover(crosses, cover, 0, 0,
-                              [&](const std::array<const EliminationSet *, N> &chosen) {
-            // Split each base line's candidates against the chosen cover -- on it,
-            // or a fin outside it -- and note whether the line has anything on the
-            // cover at all. Every line is split before any verdict is reached, so
-            // the fins come out in base-line-major order however the verdict goes.
-            std::vector<Coord> fins;
-            bool all_covered = true;
-            for (size_t i = 0; i < N; i++) {
-                bool covered = false;
-                for (auto const &cand : b.candidates[i]) {
-                    if (on_any(chosen, cand)) { covered = true; continue; }
-                    fins.push_back(cand.coord());
-                }
-                if (!covered) all_covered = false;
-            }
+        if (size_t(std::popcount(b.crosses())) < N + 1) return false;
+
+        // The distinct cross lines the base candidates touch, in first-encounter
+        // order: base line by base line, and within each line in ascending order.
+        //
+        // That order is load-bearing, because it decides which cover subset
+        // for_each_cover tries first and so which pattern a first-hit search
+        // records. It is deliberately *not* the index order of the union mask:
+        // that would make the recorded pattern a function of the line numbering
+        // rather than of the walk.
+        std::array<uint8_t, Geometry<Box>::kSide> crosses{};
+        size_t count = 0;
+        Mask seen = 0;
+        for (Mask m : b.masks) {
+            for (Mask fresh = m & ~seen; fresh; fresh &= fresh - 1)
+                crosses[count++] = uint8_t(std::countr_zero(fresh));
+            seen |= m;
+        }
+
+        const Mask outside = Mask(~b.lines_mask());
+        return for_each_cover<N>(crosses, count, Mask(0), 0, 0, [&](Mask cover) {
             // A base line with nothing on the cover is not a fish: the "every fin
             // is false" branch would leave that line with no candidate at all,
             // which is a contradiction -- a different, and stronger, deduction
             // than the one a fish makes.
-            if (!all_covered) return false;
-            // Not a gate but an invariant: `crosses` holds only lines some base
-            // candidate lies on, and there are more than N of them, so whichever N
-            // are chosen as cover, a candidate is left outside them. The finless
-            // case -- a plain fish -- was already turned away by the crosses < N+1
-            // early-out above.
-            assert(!fins.empty());
+            for (Mask m : b.masks)
+                if (!(m & cover)) return false;
 
             // Every fin in one nonet is what licenses the elimination, and the
             // gate is exact rather than merely safe. An eliminable cell lies on a
@@ -459,78 +457,135 @@ bool find_finned_fish(const Board &board, const Cell &cell, const Value &value,
             // share that one nonet. Note the claim is about *eliminable* cells --
             // fins in a common base line are seen together by everything else on
             // that line, so "no cell sees them all" would simply be false. The
-            // argument does not depend on N, and was re-derived at three base
-            // lines rather than adapted from two.
-            const Nonet &fin_nonet = board.nonet(fins.front());
-            bool one_nonet = true;
-            for (auto const &f : fins)
-                if (&board.nonet(f) != &fin_nonet) { one_nonet = false; break; }
-            if (!one_nonet) return false;
+            // argument does not depend on N.
+            //
+            // One nonet is one band of cross lines and one band of base lines. A
+            // fin is always left -- the union is more than N cross lines, so
+            // whichever N are chosen, one is outside them -- so fin_crosses is
+            // never empty and its lowest bit names the band.
+            const Mask fin_crosses = Mask(b.crosses() & ~cover);
+            assert(fin_crosses);
+            const Mask cross_band = band_of<Box>(std::countr_zero(fin_crosses));
+            if (fin_crosses & ~cross_band) return false;
+            Mask fin_lines = 0;
+            for (size_t i = 0; i < N; i++)
+                if (b.masks[i] & ~cover) fin_lines |= Mask(Mask(1) << b.lines[i]);
+            const Mask line_band = band_of<Box>(std::countr_zero(fin_lines));
+            if (fin_lines & ~line_band) return false;
 
             // There is something to eliminate iff a cell of the fin's nonet holds
             // the value on a cover line, outside the base lines. Those are exactly
             // the cells that see every fin *and* would be eliminated by the fish,
             // so they are safe under either branch of the either/or.
-            if (!any_eliminable(fin_nonet, value, chosen, b)) return false;
+            bool has_eliminations = false;
+            for (Mask m = cover & cross_band; m; m &= m - 1)
+                if (cross[std::countr_zero(m)] & line_band & outside) { has_eliminations = true; break; }
+            if (!has_eliminations) return false;
+
+            // The fins, base line by base line, and within each line in the
+            // order its candidates are walked.
+            std::vector<Coord> fins;
+            for (size_t i = 0; i < N; i++)
+                for (Mask m = b.masks[i] & ~cover; m; m &= m - 1)
+                    fins.push_back(cell_at<CandidateSet>(b.lines[i], std::countr_zero(m)));
 
-            auto finding = record(b, std::move(fins));
             assert(out.empty());
-            if (sVerbose) { std::cout << "  [f" << name << "] "; finding->print(std::cout); std::cout << std::endl; }
-            out.push_back(finding);
+            const Finding &finding = record(b, std::move(fins));
+            if (sVerbose) { narration() << "  [f" << name << "] "; finding.print(narration()); narration() << std::endl; }
             return true;
         });
     });
 }
 
-// The base lines of a recorded fish, recovered from its anchors. The base lines
-// and the cover are always opposite kinds, so CandidateSet is derived from
-// EliminationSet rather than left for a caller to pass -- a mismatched pair (say
-// <Row, Row>) would compile and silently misbehave.
-template<class EliminationSet, size_t N>
-auto bases_of(const Board &board, const std::array<Coord, N> &anchors, const Value &value) {
-    using CandidateSet = std::conditional_t<std::is_same_v<EliminationSet, Column>, Row, Column>;
+// The unit an elimination is reported against is fully determined by
+// EliminationSet -- derive it, don't thread it through as a second source of
+// truth a caller could get wrong.
+template<class EliminationSet>
+constexpr Unit unit_of() {
+    return LineOf<EliminationSet>::kColumn ? Unit::Column : Unit::Row;
+}
+
+// Recover a recorded fish's cover: the cross lines its base candidates lie on,
+// skipping the ones only a fin reaches. Every cover line comes back, and nothing
+// else can -- each was chosen out of the crosses, so it carries at least one base
+// candidate, and that candidate is on the cover and therefore not a fin -- which
+// is what the size assert states, and what makes this a recovery rather than a
+// guess. For a plain fish `fins` is empty and the cover is simply every cross
+// line the base candidates touch.
+//
+// The assert holds because find() required exactly N cover lines on this same
+// board, and SolverState re-analyzes after every mutation, so a finding is always
+// applied to the board its find ran on.
+//
+// Note what is *not* done: taking every cross line for a *finned* fish, without
+// subtracting the fins, would drag in the line the fin sits on, which the fish
+// says nothing about.
+template<class CandidateSet, size_t N>
+LineMask<CandidateSet> cover_of(const Bases<CandidateSet, N> &bases, const std::vector<Coord> &fins) {
+    using Mask = LineMask<CandidateSet>;
+    Mask cover = 0;
+    for (size_t i = 0; i < N; i++) {
+        Mask m = bases.masks[i];
+        for (auto const &fin : fins)
+            if (line_of<CandidateSet>(fin) == bases.lines[i]) m &= Mask(~(Mask(1) << cross_of<CandidateSet>(fin)));
+        cover |= m;
+    }
+    assert(size_t(std::popcount(cover)) == N);
+    return cover;
+}
 
+// The base lines of a recorded fish, recovered from its anchors: the lines of
+// kind CandidateSet through each, with their candidates read off `masks`.
+template<class CandidateSet, size_t N>
+Bases<CandidateSet, N> bases_of(const LineMasks<LineOf<CandidateSet>::kBox> &masks, const std::array<Coord, N> &anchors) {
     Bases<CandidateSet, N> bases;
     for (size_t i = 0; i < N; i++) {
-        bases.lines[i] = &line_of<CandidateSet>(board, anchors[i]);
-        bases.candidates[i] = candidates(*bases.lines[i], value);
+        bases.lines[i] = line_of<CandidateSet>(anchors[i]);
+        bases.masks[i] = masks.template of<CandidateSet>()[bases.lines[i]];
     }
     return bases;
 }
 
-// The unit an elimination is reported against is fully determined by
-// EliminationSet -- derive it, don't thread it through as a second source of
-// truth a caller could get wrong.
+// Clear `value` from `coord`, and say so under `name`, against the line of kind
+// EliminationSet it was cleared from.
 template<class EliminationSet>
-constexpr Unit unit_of() {
-    return std::is_same_v<EliminationSet, Column> ? Unit::Column : Unit::Row;
+void eliminate(BasicBoard<LineOf<EliminationSet>::kBox> &board, const Coord &coord, const Value &value, const char *name) {
+    narration() << "[" << name << "] " << coord << " x" << value
+              << " [" << tag(unit_of<EliminationSet>()) << "]" << std::endl;
+    board.clear_note_at(coord, value);
 }
 
 // Apply one recorded plain fish: clear `value` from every cell of the cover that
 // is not on a base line. `name` is the technique's output tag.
+//
+// Cover lines are swept in ascending index, and each one's cells in walk order,
+// and that is an output contract: it is the order a fish's elimination lines
+// print in. It is the order the plain fish printed in before they shared this
+// code -- X-Wing swept the cover line through its anchor before the one through
+// its diagonal, and Swordfish swept a std::set of line pointers whose addresses
+// ascended with index because Board once held its lines in a vector -- and a mask
+// walked low bit first keeps it without resting on memory layout.
 template<size_t N, class EliminationSet>
-bool act_on_plain_fish(Board &board, const Value &value, const std::array<Coord, N> &anchors,
-                       const char *name) {
-    const auto bases = bases_of<EliminationSet>(board, anchors, value);
-    const auto cover = cover_of<EliminationSet>(board, bases, {});
-
-    // This sweeps each cover line *live* while clearing notes in it, where the
-    // pre-#58 X-Wing swept a vector snapshot of the line's candidates taken before
-    // any elimination. Equivalent, and it rests on two facts from elsewhere:
-    // Board::clear_note_at strikes one candidate in one cell and cascades nothing,
-    // and Cell::operator== compares coordinates only, so contains() is a coord
-    // test unaffected by notes changing under it. A future elimination that
-    // cascades would break this loop and not obviously.
+bool act_on_plain_fish(BasicBoard<LineOf<EliminationSet>::kBox> &board, const Value &value,
+                       const std::array<Coord, N> &anchors, const char *name) {
+    using CandidateSet = CrossOf<EliminationSet>;
+    using Mask = LineMask<CandidateSet>;
+    const LineMasks<LineOf<EliminationSet>::kBox> masks(board, value);
+    const auto bases = bases_of<CandidateSet>(masks, anchors);
+    const Mask cover = cover_of(bases, {});
+    const Mask outside = Mask(~bases.lines_mask());
+
+    // The masks are a snapshot taken before any elimination, which is sound
+    // because Board::clear_note_at strikes one candidate in one cell and cascades
+    // nothing: no elimination changes which other cells qualify.
     bool did_act = false;
-    for (const auto *line : cover)
-        for (auto const &cell : *line) {
-            if (!eliminable(cell, value, cover, bases)) continue;
-
-            std::cout << "[" << name << "] " << cell.coord() << " x" << value
-                      << " [" << tag(unit_of<EliminationSet>()) << "]" << std::endl;
-            board.clear_note_at(cell.coord(), value);
+    for (Mask c = cover; c; c &= c - 1) {
+        const size_t line = std::countr_zero(c);
+        for (Mask m = masks.template of<EliminationSet>()[line] & outside; m; m &= m - 1) {
+            eliminate<EliminationSet>(board, cell_at<EliminationSet>(line, std::countr_zero(m)), value, name);
             did_act = true;
         }
+    }
 
     return did_act;
 }
@@ -538,29 +593,40 @@ bool act_on_plain_fish(Board &board, const Value &value, const std::array<Coord,
 // Apply one recorded finned fish: clear `value` from the cells of the fin's nonet
 // that lie on a cover line and outside the base lines. `name` is the technique's
 // output tag.
+//
+// Unlike a plain fish's, these are swept in the nonet's own walk order, row-major,
+// whichever way the fish lies.
 template<size_t N, class EliminationSet>
-bool act_on_finned_fish(Board &board, const Value &value, const std::array<Coord, N> &anchors,
-                        const std::vector<Coord> &fins, const char *name) {
-    const auto bases = bases_of<EliminationSet>(board, anchors, value);
-    const auto cover = cover_of<EliminationSet>(board, bases, fins);
+bool act_on_finned_fish(BasicBoard<LineOf<EliminationSet>::kBox> &board, const Value &value,
+                        const std::array<Coord, N> &anchors, const std::vector<Coord> &fins, const char *name) {
+    constexpr size_t Box = LineOf<EliminationSet>::kBox;
+    using CandidateSet = CrossOf<EliminationSet>;
+    using Mask = LineMask<CandidateSet>;
+    const LineMasks<Box> masks(board, value);
+    const auto bases = bases_of<CandidateSet>(masks, anchors);
+    const Mask cover = cover_of(bases, fins);
+    const Mask outside = Mask(~bases.lines_mask());
     // find() proved this non-empty; front() below is undefined without it, and the
     // proof is on the far side of the find/apply boundary this finding crossed. So
     // restate it here, for the same reason cover_of asserts its own size: a
     // recorded finding's invariants are worth re-stating where they get used.
     assert(!fins.empty());
-    const Nonet &fin_nonet = board.nonet(fins.front());
+    const Coord &fin = fins.front();
 
     // The tag names the line the candidate is eliminated *from*; the fin's nonet
     // is what narrows which of that line's cells qualify.
     bool did_act = false;
-    for (auto const &cell : fin_nonet) {
-        if (!eliminable(cell, value, cover, bases)) continue;
-
-        std::cout << "[" << name << "] " << cell.coord() << " x" << value
-                  << " [" << tag(unit_of<EliminationSet>()) << "]" << std::endl;
-        board.clear_note_at(cell.coord(), value);
-        did_act = true;
-    }
+    const size_t row0 = fin.row() / Box * Box, column0 = fin.column() / Box * Box;
+    for (size_t row = row0; row < row0 + Box; row++)
+        for (size_t column = column0; column < column0 + Box; column++) {
+            const Coord coord(row, column);
+            const size_t line = line_of<CandidateSet>(coord), cross = cross_of<CandidateSet>(coord);
+            if (!(masks.template of<CandidateSet>()[line] >> cross & 1)) continue;   // holds the value
+            if (!(cover >> cross & 1) || !(outside >> line & 1)) continue;  // on the cover, off the bases
+
+            eliminate<EliminationSet>(board, coord, value, name);
+            did_act = true;
+        }
 
     return did_act;
 }
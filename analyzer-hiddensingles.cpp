@@ -2,14 +2,24 @@
 // See LICENSE for details of BSD 3-Clause License
 
 #include "analyzer-hiddensingles.h"
+#include "geometry.h"
 #include "board.h"
 #include "cell.h"
 #include "coord.h"
 #include "verbose.h"
 
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace {
 // File-local: Hidden Singles has no whitebox hooks, so nothing outside this TU
@@ -23,69 +33,160 @@ struct HiddenSingleFinding : Finding {
     void print(std::ostream &o) const override { o << coord << "#" << value << "[" << tag(unit) << "]"; }
 };
 
-// Is `value` a hidden single for `cell` within `set`? Returns the unit kind when
-// cell is the *only* candidate for value in set, nullopt otherwise. Was the
-// Analyzer::test_hidden_single member template; a pure query on the passed-in
-// cell/set, so it drops to a file-local free function with the technique port.
-template<class Set>
-std::optional<Unit> test_hidden_single(const Cell &cell, const Value &value, const Set &set) {
-    if (!cell.isNote()) return std::nullopt;
-    if (cell.notes().count() <= 1) return std::nullopt; // either a naked single, or an impossibility
-    if (!cell.check(value)) return std::nullopt;        // not a candidate for value any longer
-
-    for (auto const &other_cell : set) {
-        if (other_cell == cell) continue;               // do not consider the current cell
-        assert(other_cell.isNote() || other_cell.value() != value);
-        if (other_cell.isValue()) continue;             // only considering note cells
-        if (!other_cell.notes().check(value)) continue; // this note cell is _not_ a candidate
-
-        return std::nullopt;
+// The units side by side, one lane each, padded to a multiple of 16 lanes so
+// that a pass over them is a whole number of SSE2 (8-lane) or AVX2 (16-lane)
+// vectors of 16-bit masks: the 27 units of a 9x9 board take 32 lanes, the 48 of
+// a 16x16 board 48. kUnitLanes[k][u] is the k-th cell of unit u, in the
+// geometry's kUnitCells order; a padding lane reads the cell past the last, a
+// sentinel that holds no candidate.
+template<size_t Box>
+struct UnitLanes {
+    using G = Geometry<Box>;
+    using Mask = typename G::Notes;
+
+    static constexpr size_t kLanes = (G::kUnitCount + 15) / 16 * 16;
+    static constexpr size_t kSentinel = G::kCells;
+
+    using UnitMasks = std::array<Mask, kLanes>;
+    using CellMasks = std::array<Mask, G::kCells + 1>;
+    using Lane = std::conditional_t<(kSentinel <= 255), uint8_t, uint16_t>;
+
+    static constexpr std::array<std::array<Lane, kLanes>, G::kSide> kUnitLanes = [] {
+        std::array<std::array<Lane, kLanes>, G::kSide> lanes{};
+        for (size_t k = 0; k < G::kSide; ++k)
+            for (size_t u = 0; u < kLanes; ++u)
+                lanes[k][u] = static_cast<Lane>(u < G::kUnitCount ? G::kUnitCells[u][k] : kSentinel);
+        return lanes;
+    }();
+};
+
+// Fold one cell of every unit into the "seen once" and "seen twice"
+// accumulators, lane by lane: a digit seen before is now seen twice, and seen
+// at least once either way. The 16-bit masks of 9x9 and 16x16 go through the
+// vector units by hand; the 32-bit ones of 25x25 are left to the compiler.
+template<class UnitMasks>
+inline void accumulate(UnitMasks &once, UnitMasks &twice, const UnitMasks &seen) {
+    constexpr size_t kLanes = std::tuple_size_v<UnitMasks>;
+    [[maybe_unused]] constexpr bool kVector = std::is_same_v<typename UnitMasks::value_type, uint16_t>;
+#if defined(__AVX2__)
+    if constexpr (kVector) {
+        for (size_t u = 0; u < kLanes; u += 16) {
+            const __m256i m = _mm256_load_si256(reinterpret_cast<const __m256i *>(&seen[u]));
+            const __m256i o = _mm256_load_si256(reinterpret_cast<const __m256i *>(&once[u]));
+            const __m256i t = _mm256_load_si256(reinterpret_cast<const __m256i *>(&twice[u]));
+            _mm256_store_si256(reinterpret_cast<__m256i *>(&twice[u]), _mm256_or_si256(t, _mm256_and_si256(o, m)));
+            _mm256_store_si256(reinterpret_cast<__m256i *>(&once[u]), _mm256_or_si256(o, m));
+        }
+        return;
+    }
+#elif defined(__SSE2__)
+    if constexpr (kVector) {
+        for (size_t u = 0; u < kLanes; u += 8) {
+            const __m128i m = _mm_load_si128(reinterpret_cast<const __m128i *>(&seen[u]));
+            const __m128i o = _mm_load_si128(reinterpret_cast<const __m128i *>(&once[u]));
+            const __m128i t = _mm_load_si128(reinterpret_cast<const __m128i *>(&twice[u]));
+            _mm_store_si128(reinterpret_cast<__m128i *>(&twice[u]), _mm_or_si128(t, _mm_and_si128(o, m)));
+            _mm_store_si128(reinterpret_cast<__m128i *>(&once[u]), _mm_or_si128(o, m));
+        }
+        return;
+    }
+#endif
+    for (size_t u = 0; u < kLanes; ++u) {
+        twice[u] |= once[u] & seen[u];
+        once[u]  |= seen[u];
     }
-    return set.kind();
+}
+
+// For every unit, the digits exactly one of its cells holds as a candidate, as
+// a candidate mask; `masks` has each cell's candidates (0 for a value cell) and
+// a zero sentinel at the end. One pass per cell of a unit (nine for 9x9) over
+// all the units at once, in place of a popcount per (cell, candidate, unit).
+template<size_t Box>
+void once_per_unit(const typename UnitLanes<Box>::CellMasks &masks, typename UnitLanes<Box>::UnitMasks &exactly) {
+    using L = UnitLanes<Box>;
+    alignas(32) typename L::UnitMasks once{};
+    alignas(32) typename L::UnitMasks twice{};
+    alignas(32) typename L::UnitMasks seen;
+    for (size_t k = 0; k < L::G::kSide; ++k) {
+        for (size_t u = 0; u < L::kLanes; ++u) seen[u] = masks[L::kUnitLanes[k][u]];
+        accumulate(once, twice, seen);
+    }
+    for (size_t u = 0; u < L::kLanes; ++u) exactly[u] = once[u] & ~twice[u];
 }
 } // namespace
 
 // A hidden single arises when there is only one possible cell for a candidate.
 // https://www.stolaf.edu/people/hansonr/sudoku/explain.htm#scanning
-bool HiddenSingleTechnique::find(const Board &board, FindingList &out) const {
+template<size_t Box>
+bool BasicHiddenSingleTechnique<Box>::find(const Board &board, FindingList &out) const {
+    return find_in(board, Cells::all(), out);
+}
+
+template<size_t Box>
+std::optional<typename BasicHiddenSingleTechnique<Box>::Cells>
+BasicHiddenSingleTechnique<Box>::dirty_region(const Cells &changed) const {
+    Cells region = changed;
+    for (size_t index : changed) region |= Geometry<Box>::kPeers[index];
+    return region;
+}
+
+template<size_t Box>
+bool BasicHiddenSingleTechnique<Box>::find_in(const Board &board, const Cells &cells, FindingList &out) const {
+    using G = Geometry<Box>;
+    using Mask = typename G::Notes;
     assert(out.empty());
     bool did_find = false;
 
-    for (auto const &cell : board.cells()) {
-        // is this a note cell?
-        if (!cell.isNote()) continue;
-
-        // yes!
-        for (auto const &value : cell.notes().values()) { // for each candidate value in this note cell
-            // is this a hidden single in its row, column, or nonet?
-            auto unit = test_hidden_single(cell, value, board.row(cell));
-            if (!unit) unit = test_hidden_single(cell, value, board.column(cell));
-            if (!unit) unit = test_hidden_single(cell, value, board.nonet(cell));
-            if (!unit) continue;
-
-            // yes! let's record it. (No duplicate-coord guard: the bucket is
-            // cleared each analyze(), the outer loop visits each cell once, and we
-            // break after the first hidden single found for a cell -- so no coord
-            // can recur.)
-            auto finding = std::make_shared<HiddenSingleFinding>(cell.coord(), value, *unit);
-            if (sVerbose) { std::cout << "  [fHS] "; finding->print(std::cout); std::cout << std::endl; }
-            out.push_back(std::move(finding));
-            did_find = true;
-            break;  // we're not going to find any other HS among the rest of the candidates for this cell
-        }
+    typename UnitLanes<Box>::CellMasks masks{};
+    for (size_t i = 0; i < G::kCells; ++i) {
+        auto const &cell = board.cells()[i];
+        if (cell.isNote()) masks[i] = cell.notes().mask();
+    }
+    typename UnitLanes<Box>::UnitMasks exactly;
+    once_per_unit<Box>(masks, exactly);
+
+    for (size_t index : cells) {
+        // is this a note cell? a single candidate is a naked single, though,
+        // and none an impossibility (value cells have no candidates at all)
+        if (std::popcount(masks[index]) <= 1) continue;
+
+        // which of its candidates does no other cell of its row, column or
+        // nonet hold?
+        const CellUnits &u = G::kCellUnits[index];
+        const Mask row    = masks[index] & exactly[u.row];
+        const Mask column = masks[index] & exactly[G::kSide + u.column];
+        const Mask nonet  = masks[index] & exactly[2 * G::kSide + u.nonet];
+        const Mask hidden = row | column | nonet;
+        if (!hidden) continue;
+
+        // yes! let's record the least such candidate, under the first of its
+        // units in row / column / nonet order where it is hidden. (No
+        // duplicate-coord guard: the bucket is cleared each analyze() and the
+        // loop visits each cell once, so no coord can recur.)
+        const Mask bit = hidden & -hidden;
+        const Value value = static_cast<Value>(std::countr_zero(bit) + 1);
+        const Unit unit = row & bit ? Unit::Row : column & bit ? Unit::Column : Unit::Nonet;
+        auto const &finding = out.emplace<HiddenSingleFinding>(board.cells()[index].coord(), value, unit);
+        if (sVerbose) { narration() << "  [fHS] "; finding.print(narration()); narration() << std::endl; }
+        did_find = true;
     }
     return did_find;
 }
 
-bool HiddenSingleTechnique::apply(Board &board, FindingList &mine) const {
+template<size_t Box>
+bool BasicHiddenSingleTechnique<Box>::apply(Board &board, FindingList &mine) const {
     if (mine.empty()) return false;
 
     // singles can be acted on all at once
     for (auto const &f : mine) {
         auto const &hs = bucket_cast<HiddenSingleFinding>(*f);
-        std::cout << "[HS] " << hs.coord << " =" << hs.value << " [" << tag(hs.unit) << "]" << std::endl;
+        narration() << "[HS] " << hs.coord << " =" << hs.value << " [" << tag(hs.unit) << "]" << std::endl;
         board.set_value_at(hs.coord, hs.value);
     }
     mine.clear();
     return true;
 }
+
+template class BasicHiddenSingleTechnique<3>;
+template class BasicHiddenSingleTechnique<4>;
+template class BasicHiddenSingleTechnique<5>;
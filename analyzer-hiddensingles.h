@@ -8,7 +8,11 @@
 // (row, column, or nonet). Like Naked Singles, HS has no whitebox hooks, so the
 // concrete HiddenSingleFinding lives file-local in the .cpp; only the technique
 // class needs to be nameable here (registry() constructs it directly).
-class HiddenSingleTechnique : public Technique {
+template<size_t Box>
+class BasicHiddenSingleTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using typename BasicTechnique<Box>::Cells;
+
 public:
     const char *name() const override { return "HS"; }
     Tier        tier() const override { return Tier::Single; }
@@ -16,4 +20,12 @@ public:
 
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
+
+    // Whether a cell is a hidden single depends on its own candidates and on
+    // the candidates of its three units: so the changed cells and every peer
+    // of one.
+    std::optional<Cells> dirty_region(const Cells &changed) const override;
+    bool find_in(const Board &, const Cells &cells, FindingList &out) const override;
 };
+
+using HiddenSingleTechnique = BasicHiddenSingleTechnique<3>;
@@ -0,0 +1,106 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "analyzer-jellyfish.h"
+#include "analyzer-fish.h"
+#include "board.h"
+#include "row.h"
+#include "column.h"
+#include "cell.h"
+#include "coord.h"
+
+#include <array>
+#include <cassert>
+#include <memory>
+
+using analyzer_fish::act_on_plain_fish;
+using analyzer_fish::anchors_of;
+using analyzer_fish::find_plain_fish;
+using analyzer_fish::LineMasks;
+using analyzer_fish::may_have_bases;
+
+namespace {
+
+// Record what the shared worker found as a JellyfishFinding: one anchor per base
+// line, which is what apply() maps back to the base lines.
+template<class Bases>
+const Finding &make_finding(const Bases &b, const Value &value, bool by_row, FindingList &out) {
+    return out.emplace<JellyfishFinding>(value, anchors_of(b), by_row);
+}
+
+// The per-anchor search on the value's line masks, which find() builds once per
+// value rather than once per anchor.
+template<size_t Box>
+bool find_at(const BasicCell<Box> &cell, const Value &value, const LineMasks<Box> &masks, FindingList &out) {
+    // Try row-based (eliminations in columns); if not found, try column-based
+    // (eliminations in rows), as every fish does.
+    if (find_plain_fish<4, BasicRow<Box>>(cell, value, masks, BasicJellyfishTechnique<Box>::kName,
+                                [&](const auto &b) -> const Finding & { return make_finding(b, value, true, out); }, out))
+        return true;
+    return find_plain_fish<4, BasicColumn<Box>>(cell, value, masks, BasicJellyfishTechnique<Box>::kName,
+                                      [&](const auto &b) -> const Finding & { return make_finding(b, value, false, out); }, out);
+}
+
+} // namespace
+
+template<size_t Box>
+bool BasicJellyfishTechnique<Box>::find_jellyfish(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
+    assert(cell.isNote());
+    assert(cell.check(value));
+
+    return find_at(cell, value, LineMasks<Box>(board, value), out);
+}
+
+// https://www.sudokuwiki.org/Jelly_Fish_Strategy
+// Jellyfish is Swordfish with four rows/columns instead of three. When a
+// candidate appears 2-4 times in each of four rows (or columns), and all these
+// candidates lie in the same four columns (or rows), then all other candidates
+// for that value in those columns (or rows) can be eliminated.
+template<size_t Box>
+bool BasicJellyfishTechnique<Box>::find(const Board &board, FindingList &out) const {
+    assert(out.empty());
+
+    std::array<LineMasks<Box>, Geometry<Box>::kSide> masks;
+    for (Value value : value_range<Box>()) masks[value - 1] = LineMasks<Box>(board, value);
+
+    for (auto const &cell: board.cells()) {
+        // is this a note cell?
+        if (!cell.isNote()) continue;
+
+        // for each value in this cell...
+        for (auto const &value : cell.notes().values()) {
+            // let's see if we can anchor a Jellyfish pattern in this cell for this value;
+            // stop at the first one found
+            if (find_at(cell, value, masks[value - 1], out)) return true;
+        }
+    }
+
+    return false;
+}
+
+// Four base lines of two to four candidates each.
+template<size_t Box>
+bool BasicJellyfishTechnique<Box>::may_fire(const Board &board) const {
+    return may_have_bases(board, 4, 4);
+}
+
+template<size_t Box>
+bool BasicJellyfishTechnique<Box>::apply(Board &board, FindingList &mine) const {
+    if (mine.empty()) return false;
+    assert(mine.size() == 1);
+
+    auto const &jf = bucket_cast<JellyfishFinding>(*mine.front());
+
+    // Row-based pattern eliminates from columns; column-based, from rows.
+    bool did_act = jf.is_row_based
+        ? act_on_plain_fish<4, BasicColumn<Box>>(board, jf.value, jf.anchors, name())
+        : act_on_plain_fish<4, BasicRow<Box>>(board, jf.value, jf.anchors, this->name());
+
+    mine.clear();
+    assert(did_act);
+    return did_act;
+}
+
+template class BasicJellyfishTechnique<3>;
+template class BasicJellyfishTechnique<4>;
+template class BasicJellyfishTechnique<5>;
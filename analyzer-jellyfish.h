@@ -0,0 +1,71 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include "technique.h"
+#include "coord.h"
+#include "cell.h"  // Value
+
+#include <array>
+
+// Jellyfish: Swordfish widened from three base lines to four. For one value,
+// four base lines (all rows, or all columns) that each hold two to four
+// candidates for that value, whose cross lines union to exactly four. Every
+// other candidate for the value on those four cross lines can then be eliminated.
+//
+// The search is analyzer_fish::find_plain_fish at N=4, the worker X-Wing and
+// Swordfish instantiate at N=2 and N=3; see analyzer-fish.h.
+//
+// Jellyfish is *scan-fused* (docs/test-predicate-idiom.md), like every other
+// fish, so there is no separable test_ predicate. The seam is find_jellyfish
+// below, and JellyfishFinding is in this header, not file-local, because the
+// whitebox cases read its fields (mirroring SwordfishFinding).
+struct JellyfishFinding : Finding {
+    Value value;
+    // One anchor per base line: the first candidate cell encountered in each,
+    // which apply() maps back to the four base lines, as SwordfishFinding's do.
+    std::array<Coord, 4> anchors;
+    bool is_row_based;  // true if rows hold the pattern, false if columns do
+
+    JellyfishFinding(Value v, const std::array<Coord, 4> &a, bool row_based)
+        : value(v), anchors(a), is_row_based(row_based) { }
+    // No same()/dedup here: find() short-circuits at the first hit, so a bucket
+    // never holds two Jellyfish to compare.
+    // Format: "{a1,a2,a3,a4}#value[^c]" (c if row-based, r if column-based).
+    void print(std::ostream &o) const override {
+        o << "{";
+        bool is_first = true;
+        for (const auto &anchor : anchors) {
+            if (!is_first) o << ",";
+            is_first = false;
+            o << anchor;
+        }
+        o << "}"
+          << "#" << value << "[^" << (is_row_based ? "c" : "r") << "]";
+    }
+};
+
+template<size_t Box>
+class BasicJellyfishTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using Cell = BasicCell<Box>;
+
+public:
+    // Written once, for the reason XWingTechnique::kName gives.
+    static constexpr const char *kName = "JF";
+
+    const char *name() const override { return kName; }
+    Tier        tier() const override { return Tier::Advanced; }
+    bool  brace_each() const override { return true; }
+
+    bool find(const Board &, FindingList &out) const override;
+    bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
+
+    // Whitebox seam, NOT a leaked private: anchor the per-anchor search on a
+    // chosen cell of a crafted board and inspect the finding it records. Public
+    // *static*, for the reason SwordfishTechnique::find_swordfish gives.
+    static bool find_jellyfish(const Board &, const Cell &, const Value &, FindingList &out);
+};
+
+using JellyfishTechnique = BasicJellyfishTechnique<3>;
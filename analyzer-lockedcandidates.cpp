@@ -2,6 +2,7 @@
 // See LICENSE for details of BSD 3-Clause License
 
 #include "analyzer-lockedcandidates.h"
+#include "geometry.h"
 #include "board.h"
 #include "cell.h"
 #include "coord.h"
@@ -47,104 +48,83 @@ struct LockedCandidatesFinding : Finding {
     }
 };
 
+// The cells of `unit` (a row, column or nonet) of the cell at `coord`.
+template<size_t Box>
+const typename Geometry<Box>::Cells &unit_mask(Unit unit, const Coord &coord) {
+    using G = Geometry<Box>;
+    switch (unit) {
+    case Unit::Row:    return G::kRows[coord.row()];
+    case Unit::Column: return G::kColumns[coord.column()];
+    case Unit::Nonet:  break;
+    }
+    return G::kNonets[G::nonet_index(coord.row(), coord.column())];
+}
+
 // Find a locked candidate for (cell, value): all candidate cells for `value` in
-// set_to_consider must also lie in set_to_ignore, and acting must actually
-// eliminate something from the rest of set_to_ignore. Was
+// the `consider` unit of cell must also lie in its `ignore` unit, and acting
+// must actually eliminate something from the rest of the `ignore` unit. Was
 // Analyzer::find_locked_candidate; the member vector dedup is now a scan of
 // `out` (this technique's own bucket, so every entry downcasts to
 // LockedCandidatesFinding).
-template<class Set1, class Set2>
-bool find_locked_candidate(const Cell &cell, const Value &value,
-                           const Set1 &set_to_consider, const Set2 &set_to_ignore, FindingList &out) {
-    bool did_find = false;
-
-    std::vector<Coord> lc_coords;
-    lc_coords.push_back(cell.coord());
-
-    for (auto const &other_cell : set_to_consider) {
-        // is this a note cell?
-        if (!other_cell.isNote()) continue;
-
-        // yes! but is this the same cell?
-        if (other_cell == cell) continue;
-
-        // no! but is it a candidate for this value?
-        if (!other_cell.check(value)) continue;
-
-        // yes! but is it also a candidate?
-        if (std::find(set_to_ignore.begin(), set_to_ignore.end(), other_cell) != set_to_ignore.end()) {
-
-            // yes! record it
-            lc_coords.push_back(other_cell.coord());
-
-            // and continue the search
-            continue;
-        }
-
-        // oh, this was disqualifying: we found another candidate cell in the set to ignore
-        return did_find;
-    }
+//
+// Both conditions are mask tests on the value's candidate bitboard: the
+// candidates in `consider` must have nothing outside `ignore`, and `ignore`
+// must hold a candidate outside them.
+template<size_t Box>
+bool find_locked_candidate(const BasicBoard<Box> &board, const BasicCell<Box> &cell, const Value &value,
+                           Unit consider, Unit ignore, FindingList &out) {
+    using Cells = typename Geometry<Box>::Cells;
+    const Cells &holders = board.candidates(value);
+    const Cells &ignored = unit_mask<Box>(ignore, cell.coord());
+    const Cells locked = holders & unit_mask<Box>(consider, cell.coord());
+
+    // a candidate cell in the set to consider, outside the set to ignore, is disqualifying
+    if ((locked & ~ignored).any()) return false;
 
     // ensure that this set of locked candidates, if acted on, *would* have an effect
-    bool would_act = false;
-    for (auto const &other_cell : set_to_ignore) {
-        // is it a note cell?
-        if (!other_cell.isNote()) continue;
+    if ((holders & ignored & ~locked).empty()) return false;
 
-        // yes! but is it a candidate?
-        if (!other_cell.check(value)) continue;
-
-        // yes! but is it one of the locked candidates?
-        if (std::find(lc_coords.begin(), lc_coords.end(), other_cell.coord()) != lc_coords.end()) continue;
-
-        // no! we found a note cell that is in the rest of the "set_to_ignore"
-        // and also is a candidate for this value: we *would* act on it
-        would_act = true;
-        break;
+    // The anchor cell first, then the rest in unit order -- the order a walk of
+    // the set to consider recorded them in, and so the order they print in.
+    std::vector<Coord> lc_coords;
+    lc_coords.push_back(cell.coord());
+    for (size_t index : locked) {
+        if (index == Geometry<Box>::index(cell.coord())) continue;
+        lc_coords.push_back(board.cells()[index].coord());
     }
 
-    if (would_act) {
-        // but is this entry already recorded?
-        LockedCandidatesFinding lc(lc_coords, value, set_to_ignore.kind());
-        for (auto const &f : out) {
-            if (bucket_cast<LockedCandidatesFinding>(*f).same(lc)) return did_find;
-        }
-
-        // no! let's record it
-        if (sVerbose) { std::cout << "  [fLC] "; lc.print(std::cout); std::cout << std::endl; }
-        out.push_back(std::make_shared<LockedCandidatesFinding>(std::move(lc)));
-        did_find = true;
+    // but is this entry already recorded?
+    LockedCandidatesFinding lc(lc_coords, value, ignore);
+    for (auto const &f : out) {
+        if (bucket_cast<LockedCandidatesFinding>(*f).same(lc)) return false;
     }
 
-    return did_find;
+    // no! let's record it
+    if (sVerbose) { narration() << "  [fLC] "; lc.print(narration()); narration() << std::endl; }
+    out.emplace<LockedCandidatesFinding>(std::move(lc));
+    return true;
 }
 
-// Apply one recorded finding to one `set`, eliminating its value from every
-// cell of the set that is not itself a locked candidate. Was
+// Apply one recorded finding to its unit, eliminating its value from every
+// cell of the unit that is not itself a locked candidate. Was
 // Analyzer::act_on_locked_candidate(entry, set); the board is now the passed
 // reference (the member reached it through Analyzer's mBoard).
-template<class Set>
-bool act_on_locked_candidate(Board &board, const LockedCandidatesFinding &entry, const Set &set) {
-    bool did_act = false;
-
-    for (auto const &other_cell : set) {
-        // is this a note cell?
-        if (!other_cell.isNote()) continue;
-
-        // yes! but is it one of the locked candidate?
-        if (std::find(entry.coords.begin(), entry.coords.end(), other_cell.coord())
-                != entry.coords.end()) continue;
-
-        // no! but is it a candidate for the locked value?
-        if (!other_cell.check(entry.value)) continue;
-
-        // yes! we'll act
-        std::cout << "[LC] " << other_cell.coord() << " x" << entry.value << " [" << tag(entry.unit) << "]" << std::endl;
-        board.clear_note_at(other_cell.coord(), entry.value);
-        did_act = true;
+template<size_t Box>
+bool act_on_locked_candidate(BasicBoard<Box> &board, const LockedCandidatesFinding &entry) {
+    using Cells = typename Geometry<Box>::Cells;
+    Cells locked;
+    for (auto const &coord : entry.coords) locked.set(Geometry<Box>::index(coord));
+
+    // Walked in ascending cell order, which is the unit's own walk order, so the
+    // elimination lines print as a sweep of the unit would print them.
+    const Cells doomed = board.candidates(entry.value) & unit_mask<Box>(entry.unit, entry.coords.at(0)) & ~locked;
+    for (size_t index : doomed) {
+        const Coord &coord = board.cells()[index].coord();
+        narration() << "[LC] " << coord << " x" << entry.value << " [" << tag(entry.unit) << "]" << std::endl;
+        board.clear_note_at(coord, entry.value);
     }
 
-    return did_act;
+    return doomed.any();
 }
 } // namespace
 
@@ -155,7 +135,8 @@ bool act_on_locked_candidate(Board &board, const LockedCandidatesFinding &entry,
 // Form 2:
 // When a candidate is possible in a certain nonet and row/column, and it is not possible anywhere else in the same nonet,
 // then it is also not possible anywhere else in the same row/column
-bool LockedCandidatesTechnique::find(const Board &board, FindingList &out) const {
+template<size_t Box>
+bool BasicLockedCandidatesTechnique<Box>::find(const Board &board, FindingList &out) const {
     assert(out.empty());
     bool did_find = false;
 
@@ -167,39 +148,32 @@ bool LockedCandidatesTechnique::find(const Board &board, FindingList &out) const
         for (auto const &value : cell.notes().values()) {
 
             // form 1
-            did_find |= find_locked_candidate(cell, value, board.row(cell), board.nonet(cell), out);
-            did_find |= find_locked_candidate(cell, value, board.column(cell), board.nonet(cell), out);
+            did_find |= find_locked_candidate(board, cell, value, Unit::Row, Unit::Nonet, out);
+            did_find |= find_locked_candidate(board, cell, value, Unit::Column, Unit::Nonet, out);
 
             // form 2
-            did_find |= find_locked_candidate(cell, value, board.nonet(cell), board.row(cell), out);
-            did_find |= find_locked_candidate(cell, value, board.nonet(cell), board.column(cell), out);
+            did_find |= find_locked_candidate(board, cell, value, Unit::Nonet, Unit::Row, out);
+            did_find |= find_locked_candidate(board, cell, value, Unit::Nonet, Unit::Column, out);
         }
     }
 
     return did_find;
 }
 
-bool LockedCandidatesTechnique::apply(Board &board, FindingList &mine) const {
+template<size_t Box>
+bool BasicLockedCandidatesTechnique<Box>::apply(Board &board, FindingList &mine) const {
     if (mine.empty()) return false;
 
     bool did_act = false;
     for (auto const &f : mine) {
-        auto const &lc = bucket_cast<LockedCandidatesFinding>(*f);
-
-        switch (lc.unit) {
-        case Unit::Row:
-            did_act |= act_on_locked_candidate(board, lc, board.row(lc.coords.at(0)));
-            break;
-        case Unit::Column:
-            did_act |= act_on_locked_candidate(board, lc, board.column(lc.coords.at(0)));
-            break;
-        case Unit::Nonet:
-            did_act |= act_on_locked_candidate(board, lc, board.nonet(lc.coords.at(0)));
-            break;
-        }
+        did_act |= act_on_locked_candidate(board, bucket_cast<LockedCandidatesFinding>(*f));
     }
     mine.clear();
 
     assert(did_act);
     return did_act;
 }
+
+template class BasicLockedCandidatesTechnique<3>;
+template class BasicLockedCandidatesTechnique<4>;
+template class BasicLockedCandidatesTechnique<5>;
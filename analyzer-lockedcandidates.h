@@ -12,7 +12,10 @@
 // Like Naked/Hidden Singles, LC has no whitebox hooks, so the concrete
 // LockedCandidatesFinding lives file-local in the .cpp; only the technique class
 // needs to be nameable here (registry() constructs it directly).
-class LockedCandidatesTechnique : public Technique {
+template<size_t Box>
+class BasicLockedCandidatesTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+
 public:
     const char *name() const override { return "LC"; }
     Tier        tier() const override { return Tier::Advanced; }
@@ -21,3 +24,5 @@ public:
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
 };
+
+using LockedCandidatesTechnique = BasicLockedCandidatesTechnique<3>;
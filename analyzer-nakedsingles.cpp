@@ -23,34 +23,45 @@ struct NakedSingleFinding : Finding {
 
 // A naked single arises when there is only one possible candidate for a cell.
 // https://www.stolaf.edu/people/hansonr/sudoku/explain.htm#scanning
-bool NakedSingleTechnique::find(const Board &board, FindingList &out) const {
+template<size_t Box>
+bool BasicNakedSingleTechnique<Box>::find(const Board &board, FindingList &out) const {
+    return find_in(board, Cells::all(), out);
+}
+
+template<size_t Box>
+bool BasicNakedSingleTechnique<Box>::find_in(const Board &board, const Cells &cells, FindingList &out) const {
     assert(out.empty());
     bool did_find = false;
 
-    for (auto const &cell : board.cells()) {
+    for (size_t index : cells) {
+        auto const &cell = board.cells()[index];
         // is this a naked single?
         if (!cell.isNote() || cell.notes().count() != 1) continue;
 
         // yes! let's record it. (No duplicate-coord assert: the bucket is
         // cleared each analyze() and every cell has a distinct coord.)
-        auto finding = std::make_shared<NakedSingleFinding>(cell.coord(), cell.notes().values().at(0));
-        if (sVerbose) { std::cout << "  [fNS] "; finding->print(std::cout); std::cout << std::endl; }
-        out.push_back(std::move(finding));
+        auto const &finding = out.emplace<NakedSingleFinding>(cell.coord(), cell.notes().values().at(0));
+        if (sVerbose) { narration() << "  [fNS] "; finding.print(narration()); narration() << std::endl; }
         did_find = true;
     }
 
     return did_find;
 }
 
-bool NakedSingleTechnique::apply(Board &board, FindingList &mine) const {
+template<size_t Box>
+bool BasicNakedSingleTechnique<Box>::apply(Board &board, FindingList &mine) const {
     if (mine.empty()) return false;
 
     // singles can be acted on all at once
     for (auto const &f : mine) {
         auto const &ns = bucket_cast<NakedSingleFinding>(*f);
-        std::cout << "[NS] " << ns.coord << " =" << ns.value << std::endl;
+        narration() << "[NS] " << ns.coord << " =" << ns.value << std::endl;
         board.set_value_at(ns.coord, ns.value);
     }
     mine.clear();
     return true;
 }
+
+template class BasicNakedSingleTechnique<3>;
+template class BasicNakedSingleTechnique<4>;
+template class BasicNakedSingleTechnique<5>;
@@ -8,7 +8,11 @@
 // whitebox hooks, so the concrete NakedSingleFinding lives file-local in the
 // .cpp; only the technique class needs to be nameable here (registry()
 // constructs it directly).
-class NakedSingleTechnique : public Technique {
+template<size_t Box>
+class BasicNakedSingleTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using typename BasicTechnique<Box>::Cells;
+
 public:
     const char *name() const override { return "NS"; }
     Tier        tier() const override { return Tier::Single; }
@@ -16,4 +20,11 @@ public:
 
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
+
+    // A cell's candidate count is its own business: only a changed cell can
+    // have become a naked single.
+    std::optional<Cells> dirty_region(const Cells &changed) const override { return changed; }
+    bool find_in(const Board &, const Cells &cells, FindingList &out) const override;
 };
+
+using NakedSingleTechnique = BasicNakedSingleTechnique<3>;
@@ -0,0 +1,453 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "analyzer-subsets.h"
+#include "geometry.h"
+#include "board.h"
+#include "row.h"  // Row: the explicit test_ instantiations at file end
+#include "cell.h"
+#include "coord.h"
+#include "verbose.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace {
+// The largest subset, the same at every board size.
+constexpr size_t kMaxSize = SubsetTechnique::kMaxSize;
+
+constexpr const char *kNames[2][kMaxSize + 1] = {
+    { nullptr, nullptr, "NP", "NT", "NQ" },
+    { nullptr, nullptr, "HP", "HT", "HQ" },
+};
+
+// File-local: the whitebox hooks test the predicates, not the finding, so
+// nothing outside this TU needs to name or downcast SubsetFinding. print()
+// format: "{coord1,coord2,...}#{value1,value2,...}", cells and values ascending.
+template<size_t Box>
+struct SubsetFinding : Finding {
+    using G = Geometry<Box>;
+    using Cells = std::array<typename G::Index, kMaxSize>;
+    using Mask = typename G::Notes;
+
+    Cells cells;    // indices, ascending; the first `size` are meaningful
+    size_t size;
+    Mask values;    // candidate mask, bit (v - 1) for v
+
+    SubsetFinding(const Cells &c, size_t n, Mask v)
+        : cells(c), size(n), values(v) { }
+
+    Coord coord(size_t k) const { return G::coord(cells[k]); }
+
+    void print(std::ostream &o) const override {
+        o << "{";
+        for (size_t k = 0; k < size; ++k) o << (k ? "," : "") << coord(k);
+        o << "}#{";
+        bool first = true;
+        for (Mask m = values; m; m &= m - 1, first = false)
+            o << (first ? "" : ",") << static_cast<Value>(std::countr_zero(m) + 1);
+        o << "}";
+    }
+};
+
+// One unit's candidates both ways round, by position in the unit --
+// the geometry's kUnitCells order, which is also the order a unit view iterates
+// in. `cells[p]` is the candidate mask of the p-th cell (0 for a value cell),
+// and `places[v - 1]` the positions (bit p) of the cells holding v. A naked
+// subset is a search over the first, a hidden one the same search over the
+// second. A unit has as many cells as digits, so both are the same kind of mask.
+template<size_t Box>
+struct UnitTable {
+    using Mask = typename Geometry<Box>::Notes;
+    using Masks = std::array<Mask, Geometry<Box>::kSide>;
+
+    Masks cells{};
+    Masks places{};
+
+    void add(size_t p, Mask candidates) {
+        cells[p] = candidates;
+        for (Mask m = candidates; m; m &= m - 1) places[std::countr_zero(m)] |= Mask(Mask(1) << p);
+    }
+};
+
+// The union of the `chosen` items' masks, if they make a subset of `size`: each
+// one has 2..size bits, and together `size` bits. 0 if they do not.
+template<class Mask, size_t N>
+Mask subset_cover(const std::array<Mask, N> &masks, Mask chosen, size_t size) {
+    if (size_t(std::popcount(chosen)) != size) return 0;
+    Mask cover = 0;
+    for (Mask m = chosen; m; m &= m - 1) {
+        const Mask item = masks[std::countr_zero(m)];
+        if (std::popcount(item) < 2 || size_t(std::popcount(item)) > size) return 0;
+        cover |= item;
+    }
+    return size_t(std::popcount(cover)) == size ? cover : 0;
+}
+
+// Call found(chosen, cover) for every `size` items of `eligible` whose masks
+// together have `size` bits, with that union as `cover`. Subsets come in
+// lexicographic order of their items, and a branch is cut as soon as its union
+// outgrows `size`, so a unit with few candidates costs few unions.
+template<class Mask, size_t N, class F>
+void for_each_subset(const std::array<Mask, N> &masks, Mask eligible, size_t size, F &found,
+                     Mask chosen = 0, Mask cover = 0, size_t next = 0) {
+    if (size_t(std::popcount(chosen)) == size) {
+        if (size_t(std::popcount(cover)) == size) found(chosen, cover);
+        return;
+    }
+    for (size_t i = next; i < N; ++i) {
+        if (!(eligible >> i & 1)) continue;
+        const Mask wider = cover | masks[i];
+        if (size_t(std::popcount(wider)) > size) continue;
+        for_each_subset(masks, eligible, size, found, Mask(chosen | Mask(1) << i), wider, i + 1);
+    }
+}
+
+// The items whose masks have 2..size bits: the ones a subset of `size` can use.
+template<class Mask, size_t N>
+Mask eligible_items(const std::array<Mask, N> &masks, size_t size) {
+    Mask eligible = 0;
+    for (size_t i = 0; i < N; ++i) {
+        const size_t n = std::popcount(masks[i]);
+        if (n >= 2 && n <= size) eligible |= Mask(Mask(1) << i);
+    }
+    return eligible;
+}
+
+// Would the naked subset at `positions`, of `values`, eliminate anything in the
+// unit: does any other cell hold one of the values?
+template<size_t Box, class Mask = typename UnitTable<Box>::Mask>
+bool naked_acts(const UnitTable<Box> &unit, Mask positions, Mask values) {
+    for (size_t p = 0; p < Geometry<Box>::kSide; ++p)
+        if (!(positions >> p & 1) && (unit.cells[p] & values)) return true;
+    return false;
+}
+
+// Would the hidden subset of `values`, at `positions`, eliminate anything: does
+// one of its cells hold another candidate?
+template<size_t Box, class Mask = typename UnitTable<Box>::Mask>
+bool hidden_acts(const UnitTable<Box> &unit, Mask positions, Mask values) {
+    for (size_t p = 0; p < Geometry<Box>::kSide; ++p)
+        if ((positions >> p & 1) && (unit.cells[p] & ~values)) return true;
+    return false;
+}
+
+// The position of cell `index` within unit `unit`, which holds it.
+template<size_t Box>
+size_t position_in(size_t unit, size_t index) {
+    using G = Geometry<Box>;
+    const CellUnits &u = G::kCellUnits[index];
+    return unit < G::kSide ? u.column : unit < 2 * G::kSide ? u.row : u.nonet_position;
+}
+
+template<size_t Box>
+Unit unit_kind(size_t unit) {
+    using G = Geometry<Box>;
+    return unit < G::kSide ? Unit::Row : unit < 2 * G::kSide ? Unit::Column : Unit::Nonet;
+}
+
+// The units every one of `cells` lies in, ascending: a row, column or nonet
+// index as in the geometry's kUnitCells. At most two, since two cells share a
+// row or a column but not both.
+struct SharedUnits {
+    std::array<uint8_t, 2> units;
+    size_t count = 0;
+};
+
+template<size_t Box>
+using SubsetCells = typename SubsetFinding<Box>::Cells;
+
+template<size_t Box>
+SharedUnits shared_units(const SubsetCells<Box> &cells, size_t size) {
+    using G = Geometry<Box>;
+    const CellUnits &first = G::kCellUnits[cells[0]];
+    bool row = true, column = true, nonet = true;
+    for (size_t k = 1; k < size; ++k) {
+        const CellUnits &u = G::kCellUnits[cells[k]];
+        row    &= u.row == first.row;
+        column &= u.column == first.column;
+        nonet  &= u.nonet == first.nonet;
+    }
+    SharedUnits shared;
+    if (row)    shared.units[shared.count++] = first.row;
+    if (column) shared.units[shared.count++] = uint8_t(G::kSide + first.column);
+    if (nonet)  shared.units[shared.count++] = uint8_t(2 * G::kSide + first.nonet);
+    return shared;
+}
+
+// The positions of `cells` within `unit`, which holds them all.
+template<size_t Box, class Mask = typename UnitTable<Box>::Mask>
+Mask positions_in(size_t unit, const SubsetCells<Box> &cells, size_t size) {
+    Mask positions = 0;
+    for (size_t k = 0; k < size; ++k) positions |= Mask(Mask(1) << position_in<Box>(unit, cells[k]));
+    return positions;
+}
+
+// Is mask `a`'s list of bits, ascending, lexicographically before `b`'s? The
+// order a per-cell search tries value tuples in.
+template<class Mask>
+bool bits_before(Mask a, Mask b) {
+    for (; a && b; a &= a - 1, b &= b - 1) {
+        const int low_a = std::countr_zero(a), low_b = std::countr_zero(b);
+        if (low_a != low_b) return low_a < low_b;
+    }
+    return false;
+}
+
+// A subset found in unit `unit`, before it is recorded.
+template<size_t Box>
+struct Hit {
+    SubsetCells<Box> cells;
+    typename UnitTable<Box>::Mask values;
+    uint8_t unit;
+};
+
+// Read a unit view into a table, and the positions of `cells` in it; a cell
+// missing from the view leaves the positions short.
+template<size_t Box, class Set, class Mask = typename UnitTable<Box>::Mask>
+UnitTable<Box> unit_table(const Set &set, std::initializer_list<Coord> cells, Mask &positions) {
+    UnitTable<Box> table;
+    positions = 0;
+    size_t p = 0;
+    for (auto const &cell : set) {
+        if (cell.isNote()) table.add(p, cell.notes().mask());
+        if (std::find(cells.begin(), cells.end(), cell.coord()) != cells.end()) positions |= Mask(Mask(1) << p);
+        ++p;
+    }
+    return table;
+}
+
+// Do `cells` come strictly ascending, and number 2..4?
+bool well_formed(std::initializer_list<Coord> cells) {
+    if (cells.size() < SubsetTechnique::kMinSize || cells.size() > SubsetTechnique::kMaxSize) return false;
+    return std::adjacent_find(cells.begin(), cells.end(),
+                              [](const Coord &a, const Coord &b) { return !(a < b); }) == cells.end();
+}
+} // namespace
+
+template<size_t Box>
+template<class Set>
+bool BasicSubsetTechnique<Box>::test_naked_subset(std::initializer_list<Coord> cells, const Set &set) {
+    using Mask = typename UnitTable<Box>::Mask;
+    // are these 2..4 different cells, in order?
+    if (!well_formed(cells)) return false;
+
+    // yes! but are they all in the set?
+    Mask positions;
+    const UnitTable<Box> table = unit_table<Box>(set, cells, positions);
+    if (size_t(std::popcount(positions)) != cells.size()) return false;
+
+    // yes! but are they note cells with 2..N candidates, N between them?
+    const Mask values = subset_cover(table.cells, positions, cells.size());
+    if (!values) return false;
+
+    // yes! but would acting on them have an effect?
+    return naked_acts(table, positions, values);
+}
+
+template<size_t Box>
+template<class Set>
+bool BasicSubsetTechnique<Box>::test_hidden_subset(std::initializer_list<Coord> cells, std::initializer_list<Value> values,
+                                                   const Set &set) {
+    using Mask = typename UnitTable<Box>::Mask;
+    // are these 2..4 different cells and as many different values, each in order?
+    if (!well_formed(cells) || values.size() != cells.size()) return false;
+    if (std::adjacent_find(values.begin(), values.end(), std::greater_equal<Value>()) != values.end()) return false;
+
+    // yes! but are the cells all in the set?
+    Mask positions;
+    const UnitTable<Box> table = unit_table<Box>(set, cells, positions);
+    if (size_t(std::popcount(positions)) != cells.size()) return false;
+
+    // yes! but does every value lie in 2..N cells of the set, and all of them
+    // among these? (A stray cell carrying any one of them disqualifies the lot.)
+    Mask mask = 0;
+    for (Value value : values) mask |= Mask(Mask(1) << (value - 1));
+    if (subset_cover(table.places, mask, values.size()) != positions) return false;
+
+    // yes! but is it actionable (i.e. *not* a naked subset, with nothing else to strip)?
+    return hidden_acts(table, positions, mask);
+}
+
+template<size_t Box>
+BasicSubsetTechnique<Box>::BasicSubsetTechnique(Subset kind, size_t size) : mKind(kind), mSize(size) {
+    assert(size >= kMinSize && size <= kMaxSize);
+}
+
+template<size_t Box>
+const char *BasicSubsetTechnique<Box>::name() const { return kNames[mKind == Subset::Hidden][mSize]; }
+
+// https://www.stolaf.edu/people/hansonr/sudoku/explain.htm#subsets
+// When n candidates are possible in a certain set of n cells all in the same block, row,
+// or column, and no other candidates are possible in those cells, then those n candidates
+// are not possible elsewhere in that same block, row, or column. (Naked.)
+// When n candidates are possible in a certain set of n cells all in the same block, row, or column,
+// and those n candidates are not possible elsewhere in that same block, row, or column, then no other
+// candidates are possible in those cells. (Hidden.)
+template<size_t Box>
+bool BasicSubsetTechnique<Box>::find(const Board &board, FindingList &out) const {
+    using G = Geometry<Box>;
+    using Mask = typename UnitTable<Box>::Mask;
+    assert(out.empty());
+
+    // Each cell's candidates read once; a naked search needs no position masks.
+    std::array<Mask, G::kCells> masks;
+    for (size_t i = 0; i < G::kCells; ++i) {
+        auto const &cell = board.cells()[i];
+        masks[i] = cell.isNote() ? cell.notes().mask() : 0;
+    }
+    std::array<UnitTable<Box>, G::kUnitCount> tables;
+    for (size_t u = 0; u < G::kUnitCount; ++u)
+        for (size_t p = 0; p < G::kSide; ++p) {
+            const Mask candidates = masks[G::kUnitCells[u][p]];
+            if (mKind == Subset::Naked) tables[u].cells[p] = candidates;
+            else                        tables[u].add(p, candidates);
+        }
+
+    std::vector<Hit<Box>> hits;
+    for (size_t u = 0; u < G::kUnitCount; ++u) {
+        const UnitTable<Box> &table = tables[u];
+        auto cells_at = [&](Mask positions) {
+            SubsetCells<Box> cells{};
+            size_t k = 0;
+            for (Mask m = positions; m; m &= m - 1) cells[k++] = G::kUnitCells[u][std::countr_zero(m)];
+            return cells;
+        };
+
+        if (mKind == Subset::Naked) {
+            auto found = [&](Mask positions, Mask values) {
+                const SubsetCells<Box> cells = cells_at(positions);
+                const SharedUnits shared = shared_units<Box>(cells, mSize);
+                // a nonet's subset that also lies on a line was the line's to judge
+                if (u >= 2 * G::kSide && shared.count > 1) return;
+
+                // recorded under the first unit it would act in, if any
+                for (size_t s = 0; s < shared.count; ++s) {
+                    const size_t unit = shared.units[s];
+                    if (naked_acts(tables[unit], positions_in<Box>(unit, cells, mSize), values)) {
+                        hits.push_back({ cells, values, uint8_t(unit) });
+                        return;
+                    }
+                }
+            };
+            for_each_subset(table.cells, eligible_items(table.cells, mSize), mSize, found);
+        } else {
+            auto found = [&](Mask values, Mask positions) {
+                if (!hidden_acts(table, positions, values)) return;
+                const SubsetCells<Box> cells = cells_at(positions);
+                // a nonet's subset that the line through it hides as well was
+                // the line's to record
+                const SharedUnits shared = shared_units<Box>(cells, mSize);
+                if (u >= 2 * G::kSide && shared.count > 1) {
+                    const size_t line = shared.units[0];
+                    if (subset_cover(tables[line].places, values, mSize) == positions_in<Box>(line, cells, mSize)) return;
+                }
+                hits.push_back({ cells, values, uint8_t(u) });
+            };
+            for_each_subset(table.places, eligible_items(table.places, mSize), mSize, found);
+        }
+    }
+
+    // Recorded in the order a per-cell search finds them: by first cell, then
+    // -- hidden subsets -- by values, then by the kind of unit, row first.
+    const bool hidden = mKind == Subset::Hidden;
+    std::sort(hits.begin(), hits.end(), [hidden](const Hit<Box> &a, const Hit<Box> &b) {
+        if (a.cells[0] != b.cells[0]) return a.cells[0] < b.cells[0];
+        if (hidden && a.values != b.values) return bits_before(a.values, b.values);
+        if (a.unit / G::kSide != b.unit / G::kSide) return a.unit / G::kSide < b.unit / G::kSide;
+        return a.cells < b.cells;
+    });
+
+    for (auto const &hit : hits) {
+        auto const &finding = out.emplace<SubsetFinding<Box>>(hit.cells, mSize, hit.values);
+        if (sVerbose) { narration() << "  [f" << name() << "] "; finding.print(narration()); narration() << std::endl; }
+    }
+    return !out.empty();
+}
+
+// A hidden subset of N is N values of one unit, each in two to N of its cells:
+// the board's position masks are the unit tables' `places`, ready-made. A naked
+// one is N cells of two to N candidates each, which the board indexes only at
+// two: a naked pair is two bivalue cells that see each other.
+template<size_t Box>
+bool BasicSubsetTechnique<Box>::may_fire(const Board &board) const {
+    using G = Geometry<Box>;
+    if (mKind == Subset::Naked) {
+        if (mSize != 2) return true;
+        const typename G::Cells &bivalue = board.bivalue();
+        for (size_t index : bivalue)
+            if ((G::kPeers[index] & bivalue).any()) return true;
+        return false;
+    }
+
+    for (size_t u = 0; u < G::kUnitCount; ++u) {
+        size_t members = 0;
+        for (Value value : value_range<Box>()) {
+            const size_t n = std::popcount(board.positions(u, value));
+            members += n >= 2 && n <= mSize;
+        }
+        if (members >= mSize) return true;
+    }
+    return false;
+}
+
+template<size_t Box>
+bool BasicSubsetTechnique<Box>::apply(Board &board, FindingList &mine) const {
+    using G = Geometry<Box>;
+    using Mask = typename UnitTable<Box>::Mask;
+    if (mine.empty()) return false;
+
+    bool did_act = false;
+    for (auto const &f : mine) {
+        auto const &subset = bucket_cast<SubsetFinding<Box>>(*f);
+
+        if (mKind == Subset::Naked) {
+            // the subset's values, from every other cell of every unit its
+            // cells share
+            const SharedUnits shared = shared_units<Box>(subset.cells, subset.size);
+            for (size_t s = 0; s < shared.count; ++s) {
+                const size_t unit = shared.units[s];
+                for (size_t index : G::kUnitCells[unit]) {
+                    if (std::find(subset.cells.begin(), subset.cells.begin() + subset.size, index)
+                        != subset.cells.begin() + subset.size) continue;
+                    const Coord coord = G::coord(index);
+                    for (Mask m = subset.values; m; m &= m - 1) {
+                        const Value value = static_cast<Value>(std::countr_zero(m) + 1);
+                        if (!board.clear_note_at(coord, value)) continue;  // absent note -> no-op
+                        narration() << "[" << name() << "] " << coord << " x" << value << " [" << tag(unit_kind<Box>(unit)) << "]" << std::endl;
+                        did_act = true;
+                    }
+                }
+            }
+        } else {
+            // every other candidate, from the subset's cells
+            for (size_t k = 0; k < subset.size; ++k) {
+                const Coord coord = subset.coord(k);
+                for (Value value : value_range<Box>()) {
+                    if (subset.values >> (value - 1) & 1) continue;
+                    if (!board.clear_note_at(coord, value)) continue;  // absent note -> no-op
+                    narration() << "[" << name() << "] " << coord << " x" << value << " "; subset.print(narration()); narration() << std::endl;
+                    did_act = true;
+                }
+            }
+        }
+    }
+    mine.clear();
+
+    assert(did_act);
+    return did_act;
+}
+
+// Explicit instantiations so the whitebox test (tests/unit/test_analyzer.cpp) can
+// link the predicates on Row directly. Their in-TU callers are inlined at -O3, and
+// g++ then emits no out-of-line copy for the external reference from the test TU
+// to link against. See docs/test-predicate-idiom.md.
+template class BasicSubsetTechnique<3>;
+template class BasicSubsetTechnique<4>;
+template class BasicSubsetTechnique<5>;
+template bool SubsetTechnique::test_naked_subset<Row>(std::initializer_list<Coord>, const Row &);
+template bool SubsetTechnique::test_hidden_subset<Row>(std::initializer_list<Coord>, std::initializer_list<Value>, const Row &);
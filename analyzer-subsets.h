@@ -0,0 +1,78 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include "technique.h"
+#include "coord.h"
+#include "cell.h"  // Value used in the test_ contracts below
+
+#include <cstddef>
+#include <initializer_list>
+
+// Naked and hidden subsets: pairs, triples and quads, as one engine.
+//
+// A *naked* subset is N note cells of one unit (row, column, or nonet) whose
+// candidates, taken together, are just N values. Those N cells must hold those N
+// values between them, so the values can be stripped from every other cell of
+// the unit -- of every unit the N cells share. A *hidden* subset is the same
+// rule read the other way round: N values whose candidates in one unit all fall
+// in just N cells. Those cells must hold those values, so every other candidate
+// can be stripped from them.
+//
+// The two are the same search on a unit's two candidate tables -- naked over
+// the cells' candidate masks, hidden over the values' position masks -- so one
+// worker enumerates both, as bitmask unions: N items whose union has N bits.
+// Each member holds 2..N candidates (naked) or lies in 2..N cells (hidden);
+// fewer is a single, which the singles earlier in the cascade have taken.
+//
+// One technique per (kind, size), each with its own tag, bucket and cascade
+// place: NP, NT and NQ for naked pairs, triples and quads; HP, HT and HQ for
+// hidden ones. A subset that lies in two units (a row and a nonet, say) is
+// recorded once, under the line: the nonet scan skips what the line scan
+// judges, which is why a naked subset's actionability counts every unit its
+// cells share.
+//
+// The subsets are *given-tuple* shaped (docs/test-predicate-idiom.md): the
+// tuple is the N cells, and for a hidden subset the N values. The predicates
+// below judge such a tuple within one unit; find() runs the same mask tests
+// over all the units (27 on a 9x9 board) at once.
+enum class Subset { Naked, Hidden };
+
+template<size_t Box>
+class BasicSubsetTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+
+public:
+    static constexpr size_t kMinSize = 2;
+    static constexpr size_t kMaxSize = 4;
+
+    BasicSubsetTechnique(Subset kind, size_t size);
+
+    const char *name() const override;
+    Tier        tier() const override { return Tier::Advanced; }
+    bool  brace_each() const override { return true; }
+
+    bool find(const Board &, FindingList &out) const override;
+    bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
+
+    // Tested contracts, NOT leaked privates: are `cells` a genuine, actionable
+    // naked subset within `set`? Are `values` hidden in `cells` within `set`,
+    // with something to strip? Both want 2..4 cells in strictly ascending order
+    // (and strictly ascending values): find() only ever forms them that way,
+    // but a direct test caller can pass anything, so the predicates guard the
+    // precondition themselves. Templated on the unit type; an explicit Row
+    // instantiation in the .cpp forces an out-of-line symbol so the gcc -O3
+    // cross-TU reference from the test links (see docs/test-predicate-idiom.md).
+    template<class Set>
+    static bool test_naked_subset(std::initializer_list<Coord> cells, const Set &set);
+    template<class Set>
+    static bool test_hidden_subset(std::initializer_list<Coord> cells, std::initializer_list<Value> values,
+                                   const Set &set);
+
+private:
+    Subset mKind;
+    size_t mSize;
+};
+
+using SubsetTechnique = BasicSubsetTechnique<3>;
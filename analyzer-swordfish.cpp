@@ -9,37 +9,48 @@
 #include "cell.h"
 #include "coord.h"
 
+#include <array>
 #include <cassert>
 #include <memory>
 
 using analyzer_fish::act_on_plain_fish;
 using analyzer_fish::anchors_of;
 using analyzer_fish::find_plain_fish;
+using analyzer_fish::LineMasks;
+using analyzer_fish::may_have_bases;
 
 namespace {
 
 // Record what the shared worker found as a SwordfishFinding: one anchor per base
 // line, which is what apply() maps back to the base lines.
 template<class Bases>
-std::shared_ptr<Finding> make_finding(const Bases &b, const Value &value, bool by_row) {
-    return std::make_shared<SwordfishFinding>(value, anchors_of(b), by_row);
+const Finding &make_finding(const Bases &b, const Value &value, bool by_row, FindingList &out) {
+    return out.emplace<SwordfishFinding>(value, anchors_of(b), by_row);
+}
+
+// The per-anchor search on the value's line masks, which find() builds once per
+// value rather than once per anchor.
+template<size_t Box>
+bool find_at(const BasicCell<Box> &cell, const Value &value, const LineMasks<Box> &masks, FindingList &out) {
+    // Try row-based Swordfish (eliminations in columns); if not found, try
+    // column-based Swordfish (eliminations in rows). The base lines' kind cannot
+    // be deduced from the argument list, so it is named -- the same call shape
+    // every fish uses.
+    if (find_plain_fish<3, BasicRow<Box>>(cell, value, masks, BasicSwordfishTechnique<Box>::kName,
+                                [&](const auto &b) -> const Finding & { return make_finding(b, value, true, out); }, out))
+        return true;
+    return find_plain_fish<3, BasicColumn<Box>>(cell, value, masks, BasicSwordfishTechnique<Box>::kName,
+                                      [&](const auto &b) -> const Finding & { return make_finding(b, value, false, out); }, out);
 }
 
 } // namespace
 
-bool SwordfishTechnique::find_swordfish(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
+template<size_t Box>
+bool BasicSwordfishTechnique<Box>::find_swordfish(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
     assert(cell.isNote());
     assert(cell.check(value));
 
-    // Try row-based Swordfish (eliminations in columns); if not found, try
-    // column-based Swordfish (eliminations in rows). EliminationSet cannot be
-    // deduced from the argument list, so both are named -- the same call shape all
-    // four fish now use.
-    if (find_plain_fish<3, Row, Column>(board, cell, value, board.row(cell), board.rows(), kName,
-                                        [&](const auto &b) { return make_finding(b, value, true); }, out))
-        return true;
-    return find_plain_fish<3, Column, Row>(board, cell, value, board.column(cell), board.columns(), kName,
-                                           [&](const auto &b) { return make_finding(b, value, false); }, out);
+    return find_at(cell, value, LineMasks<Box>(board, value), out);
 }
 
 // https://www.sudokuwiki.org/Sword_Fish_Strategy
@@ -47,9 +58,13 @@ bool SwordfishTechnique::find_swordfish(const Board &board, const Cell &cell, co
 // When a candidate appears 2-3 times in each of three rows (or columns),
 // and all these candidates lie in the same three columns (or rows),
 // then all other candidates for that value in those columns (or rows) can be eliminated.
-bool SwordfishTechnique::find(const Board &board, FindingList &out) const {
+template<size_t Box>
+bool BasicSwordfishTechnique<Box>::find(const Board &board, FindingList &out) const {
     assert(out.empty());
 
+    std::array<LineMasks<Box>, Geometry<Box>::kSide> masks;
+    for (Value value : value_range<Box>()) masks[value - 1] = LineMasks<Box>(board, value);
+
     for (auto const &cell: board.cells()) {
         // is this a note cell?
         if (!cell.isNote()) continue;
@@ -58,14 +73,21 @@ bool SwordfishTechnique::find(const Board &board, FindingList &out) const {
         for (auto const &value : cell.notes().values()) {
             // let's see if we can anchor a Swordfish pattern in this cell for this value;
             // stop at the first one found
-            if (find_swordfish(board, cell, value, out)) return true;
+            if (find_at(cell, value, masks[value - 1], out)) return true;
         }
     }
 
     return false;
 }
 
-bool SwordfishTechnique::apply(Board &board, FindingList &mine) const {
+// Three base lines of two or three candidates each.
+template<size_t Box>
+bool BasicSwordfishTechnique<Box>::may_fire(const Board &board) const {
+    return may_have_bases(board, 3, 3);
+}
+
+template<size_t Box>
+bool BasicSwordfishTechnique<Box>::apply(Board &board, FindingList &mine) const {
     if (mine.empty()) return false;
     assert(mine.size() == 1);
 
@@ -73,10 +95,14 @@ bool SwordfishTechnique::apply(Board &board, FindingList &mine) const {
 
     // Row-based pattern eliminates from columns; column-based, from rows.
     bool did_act = sf.is_row_based
-        ? act_on_plain_fish<3, Column>(board, sf.value, sf.anchors, name())
-        : act_on_plain_fish<3, Row>(board, sf.value, sf.anchors, name());
+        ? act_on_plain_fish<3, BasicColumn<Box>>(board, sf.value, sf.anchors, name())
+        : act_on_plain_fish<3, BasicRow<Box>>(board, sf.value, sf.anchors, this->name());
 
     mine.clear();
     assert(did_act);
     return did_act;
 }
+
+template class BasicSwordfishTechnique<3>;
+template class BasicSwordfishTechnique<4>;
+template class BasicSwordfishTechnique<5>;
@@ -53,7 +53,11 @@ struct SwordfishFinding : Finding {
     }
 };
 
-class SwordfishTechnique : public Technique {
+template<size_t Box>
+class BasicSwordfishTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using Cell = BasicCell<Box>;
+
 public:
     // Written once, for the reason XWingTechnique::kName gives.
     static constexpr const char *kName = "SF";
@@ -64,6 +68,7 @@ public:
 
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
 
     // Whitebox seam, NOT a leaked private: anchor the per-anchor search on a
     // chosen cell of a crafted board and inspect the finding it records --
@@ -76,3 +81,5 @@ public:
     // XWingTechnique::find_xwing.
     static bool find_swordfish(const Board &, const Cell &, const Value &, FindingList &out);
 };
+
+using SwordfishTechnique = BasicSwordfishTechnique<3>;
@@ -10,11 +10,14 @@
 #include "coord.h"
 
 #include <array>
+#include <bit>
 #include <cassert>
 #include <memory>
 
 using analyzer_fish::act_on_plain_fish;
 using analyzer_fish::find_plain_fish;
+using analyzer_fish::LineMasks;
+using analyzer_fish::may_have_bases;
 
 namespace {
 
@@ -24,46 +27,57 @@ namespace {
 // X-Wing predates the one-anchor-per-base-line convention the other three fish
 // record with, and its print format is documented output, so it keeps its own
 // pair. The anchor is the first candidate of the first base line and the diagonal
-// the *second* candidate of the second; candidates() walks a line in ascending
-// order, so that is the far corner rather than merely another cell of the
+// the *second* candidate of the second; a line's candidates ascend along it, so
+// that is the far corner rather than merely another cell of the
 // pattern. apply() recovers the base lines from the two of them together, one
 // each, exactly as the other fish recover theirs from one anchor per line.
 template<class Bases>
-std::shared_ptr<Finding> make_finding(const Bases &b, const Value &value, bool by_row) {
+const Finding &make_finding(const Bases &b, const Value &value, bool by_row, FindingList &out) {
     // Confinement to two cover lines, plus the floor of two candidates per base
     // line, leaves each base line with exactly two candidates -- so the far
     // corner is at [1], and this is an invariant of the search rather than a
     // property of this particular board.
-    assert(b.candidates[0].size() == 2);
-    assert(b.candidates[1].size() == 2);
+    assert(std::popcount(b.masks[0]) == 2);
+    assert(std::popcount(b.masks[1]) == 2);
 
-    return std::make_shared<XWingFinding>(value, b.candidates[0][0].coord(),
-                                                 b.candidates[1][1].coord(), by_row);
+    return out.emplace<XWingFinding>(value, b.candidate(0, 0), b.candidate(1, 1), by_row);
+}
+
+// The per-anchor search on the value's line masks, which find() builds once per
+// value rather than once per anchor.
+template<size_t Box>
+bool find_at(const BasicCell<Box> &cell, const Value &value, const LineMasks<Box> &masks, FindingList &out) {
+    // Try row-based (eliminations in columns); if not found, try column-based
+    // (eliminations in rows). The base lines' kind cannot be deduced from the
+    // argument list, so it is named -- the same call shape every fish uses.
+    if (find_plain_fish<2, BasicRow<Box>>(cell, value, masks, BasicXWingTechnique<Box>::kName,
+                                [&](const auto &b) -> const Finding & { return make_finding(b, value, true, out); }, out))
+        return true;
+    return find_plain_fish<2, BasicColumn<Box>>(cell, value, masks, BasicXWingTechnique<Box>::kName,
+                                      [&](const auto &b) -> const Finding & { return make_finding(b, value, false, out); }, out);
 }
 
 } // namespace
 
-bool XWingTechnique::find_xwing(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
+template<size_t Box>
+bool BasicXWingTechnique<Box>::find_xwing(const Board &board, const Cell &cell, const Value &value, FindingList &out) {
     assert(cell.isNote());
     assert(cell.check(value));
 
-    // Try row-based (eliminations in columns); if not found, try column-based
-    // (eliminations in rows). EliminationSet cannot be deduced from the argument
-    // list, so both are named -- the same call shape all four fish now use.
-    if (find_plain_fish<2, Row, Column>(board, cell, value, board.row(cell), board.rows(), kName,
-                                        [&](const auto &b) { return make_finding(b, value, true); }, out))
-        return true;
-    return find_plain_fish<2, Column, Row>(board, cell, value, board.column(cell), board.columns(), kName,
-                                           [&](const auto &b) { return make_finding(b, value, false); }, out);
+    return find_at(cell, value, LineMasks<Box>(board, value), out);
 }
 
 // https://www.sudokuwiki.org/x_wing_strategy
 // When there are only two possible cells for a value in each of two different rows,
 // and these candidates lie also in the same columns, then all other candidates for
 // this value in the columns can be eliminated.
-bool XWingTechnique::find(const Board &board, FindingList &out) const {
+template<size_t Box>
+bool BasicXWingTechnique<Box>::find(const Board &board, FindingList &out) const {
     assert(out.empty());
 
+    std::array<LineMasks<Box>, Geometry<Box>::kSide> masks;
+    for (Value value : value_range<Box>()) masks[value - 1] = LineMasks<Box>(board, value);
+
     for (auto const &cell: board.cells()) {
         // is this a note cell?
         if (!cell.isNote()) continue;
@@ -72,14 +86,21 @@ bool XWingTechnique::find(const Board &board, FindingList &out) const {
         for (auto const &value : cell.notes().values()) {
             // let's see if we can anchor an X-Wing pattern in this cell for this value;
             // stop at the first one found
-            if (find_xwing(board, cell, value, out)) return true;
+            if (find_at(cell, value, masks[value - 1], out)) return true;
         }
     }
 
     return false;
 }
 
-bool XWingTechnique::apply(Board &board, FindingList &mine) const {
+// Two base lines of exactly two candidates each.
+template<size_t Box>
+bool BasicXWingTechnique<Box>::may_fire(const Board &board) const {
+    return may_have_bases(board, 2, 2);
+}
+
+template<size_t Box>
+bool BasicXWingTechnique<Box>::apply(Board &board, FindingList &mine) const {
     if (mine.empty()) return false;
     assert(mine.size() == 1);
 
@@ -90,10 +111,14 @@ bool XWingTechnique::apply(Board &board, FindingList &mine) const {
 
     // Row-based pattern eliminates from columns; column-based, from rows.
     bool did_act = xw.is_row_based
-        ? act_on_plain_fish<2, Column>(board, xw.value, anchors, name())
-        : act_on_plain_fish<2, Row>(board, xw.value, anchors, name());
+        ? act_on_plain_fish<2, BasicColumn<Box>>(board, xw.value, anchors, name())
+        : act_on_plain_fish<2, BasicRow<Box>>(board, xw.value, anchors, this->name());
 
     mine.clear();
     assert(did_act);
     return did_act;
 }
+
+template class BasicXWingTechnique<3>;
+template class BasicXWingTechnique<4>;
+template class BasicXWingTechnique<5>;
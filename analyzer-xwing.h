@@ -12,7 +12,7 @@
 // lines can then be eliminated.
 //
 // The search is analyzer_fish::find_plain_fish at N=2, shared with Swordfish since
-// #58; see analyzer-fish.h for the rule the four fish have in common and for why
+// #58; see analyzer-fish.h for the rule the six fish have in common and for why
 // the plain and finned halves of the family keep separate workers.
 //
 // X-Wing is *scan-fused* (docs/test-predicate-idiom.md), so it has no separable
@@ -35,7 +35,11 @@ struct XWingFinding : Finding {
     }
 };
 
-class XWingTechnique : public Technique {
+template<size_t Box>
+class BasicXWingTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using Cell = BasicCell<Box>;
+
 public:
     // The technique's tag, written once. name() returns it, and find_xwing hands
     // it to the shared worker, which prints both the find line and the
@@ -49,6 +53,7 @@ public:
 
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
 
     // Whitebox seam, NOT a leaked private: anchor the per-anchor search on a
     // chosen cell of a crafted board and inspect the finding it records --
@@ -58,3 +63,5 @@ public:
     // is stateless and this touches no instance data.
     static bool find_xwing(const Board &, const Cell &, const Value &, FindingList &out);
 };
+
+using XWingTechnique = BasicXWingTechnique<3>;
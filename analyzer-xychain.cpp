@@ -2,128 +2,82 @@
 // See LICENSE for details of BSD 3-Clause License
 
 #include "analyzer-xychain.h"
+#include "geometry.h"
 #include "board.h"
-#include "row.h"
-#include "column.h"
-#include "nonet.h"
 #include "cell.h"
 #include "coord.h"
 #include "verbose.h"
 
-#include <algorithm>
+#include <array>
 #include <cassert>
-#include <memory>
+#include <cstdint>
 #include <set>
-#include <unordered_set>
 #include <vector>
 
 namespace {
 
-// The chain under construction, as the search holds it: the cells themselves,
-// not their coordinates. Recovering a Cell from a Coord takes Board::at, which
-// is reserved to Board's friends and a technique is not one; rather than reach
-// for that lookup through some other door, the search keeps what it already had
-// in hand and pays the Cell -> Coord conversion once, at the point a chain is
-// actually recorded.
+// The chain under construction, as cell indices in chain order, plus the same
+// cells as a mask so "already on the chain" is one bit test. A chain visits
+// distinct cells, so it never holds more than the board's (81 on a 9x9 board) and
+// a fixed array does: the search allocates nothing until a chain is actually
+// recorded.
 //
-// Only element 0 points at a cell the board owns (the anchor find_xychain was
-// handed). Every later element points into a `std::unordered_set<Cell>` of
-// selected candidates, so it is a *snapshot* of that cell taken when
-// select_chain_candidates copied it in, not a live board cell. That is
-// equivalent here only because find is a pure query: nothing mutates the board
-// between the copy and the read.
-//
-// Lifetime: each frame's candidate set outlives the calls that frame makes, and
-// every push_back in extend_chain is popped before that frame exits, so a pointer
-// is only ever dereferenced while the set holding it is alive (see extend_chain's
-// loop). The one push that is never popped is find_xychain's anchor, element 0,
-// which needs no such guarantee: it points into the board, not into a frame.
-using ChainCells = std::vector<const Cell *>;
-
-std::vector<Coord> coords_of(const ChainCells &chain) {
+// `value` is the candidate the anchor was entered on. The chain closes when the
+// last cell's exit value is that same candidate.
+template<size_t Box>
+struct Chain {
+    using G = Geometry<Box>;
+
+    std::array<typename G::Index, G::kCells> cells;
+    size_t length = 0;
+    typename G::Cells visited;
+    Value value;
+
+    void push(size_t index) { cells[length++] = static_cast<typename G::Index>(index); visited.set(index); }
+    void pop() { visited.reset(cells[--length]); }
+    size_t front() const { return cells[0]; }
+    size_t back() const { return cells[length - 1]; }
+};
+
+template<size_t Box>
+std::vector<Coord> coords_of(const BasicBoard<Box> &board, const Chain<Box> &chain) {
     std::vector<Coord> coords;
-    coords.reserve(chain.size());
-    for (const auto *cell : chain) coords.push_back(cell->coord());
+    coords.reserve(chain.length);
+    for (size_t i = 0; i < chain.length; i++) coords.push_back(board.cells()[chain.cells[i]].coord());
     return coords;
 }
 
-bool on_chain(const ChainCells &chain, const Coord &coord) {
-    return std::any_of(chain.begin(), chain.end(),
-                       [&coord](const Cell *c) { return c->coord() == coord; });
-}
-
-// Score `chain`: validate that it links up and that the far end's candidate is
-// also a candidate for the initial cell, then collect the off-chain cells that
-// would lose `value`. An empty set means "not actionable" -- either the chain does
-// not close or it eliminates nothing, a distinction the caller does not need.
-// File-local because no whitebox case calls it (see analyzer-xychain.h).
+// Score `chain`, whose last cell exits on `value`: does the chain close, and which
+// off-chain cells would lose `value` if it does? An empty set means "not
+// actionable" -- either the chain does not close or it eliminates nothing, a
+// distinction the caller does not need. File-local because no whitebox case calls
+// it (see analyzer-xychain.h).
+//
+// Closing is one comparison. extend_chain only ever links a cell on the candidate
+// the previous one exits on, so the chain links up by construction, and walking
+// it from the anchor's entry value lands on `value`; the chain closes exactly when
+// the two are the same candidate. (Walking it from the anchor's other value
+// instead can only exit on the complement of `value`, never on `value` itself, so
+// no other direction closes it either.)
 //
 // Collecting the coords rather than counting them lets the finding carry its own
 // effect, so apply() replays what this saw instead of rediscovering it.
-std::set<Coord> test_xychain(const Board &board, const Value &value, const ChainCells &chain) {
-    // validate that the chain chains properly, and that the end candidate value is also a
-    // candidate for the initial cell.
-    Value other_value = value;
-    for (const auto *cell : chain) {
-        Value this_value = other_value;
-
-        assert(cell->isNote());
-        assert(cell->notes().count() == 2);
-        if (!cell->check(this_value)) return {};
-        other_value = cell->other_value(this_value);
-    }
-    // is the last "other_value" is the incoming candidate value
-    if (other_value != value) return {};
-
-    // yes! collect eliminations
-    std::set<Coord> eliminations;
-    for (const auto &cell : board.cells()) {
-        // is this a note cell?
-        if (!cell.isNote()) continue;
-
-        // yes! but is value a candidate for it?
-        if (!cell.check(value)) continue;
+template<size_t Box>
+std::set<Coord> test_xychain(const BasicBoard<Box> &board, const Value &value, const Chain<Box> &chain) {
+    if (value != chain.value) return {};
 
-        // yes! but is it on the chain?
-        if (on_chain(chain, cell.coord())) continue;
+    // yes! collect eliminations: the cells holding value that see both ends --
+    // one AND of the ends' peer masks -- less any that are on the chain itself.
+    auto doomed = board.candidates(value)
+                & Geometry<Box>::common_peers(chain.front(), chain.back())
+                    & ~chain.visited;
 
-        // no! but can it see both ends?
-        if (!board.see_each_other(cell.coord(), chain.front()->coord())) continue;
-        if (!board.see_each_other(cell.coord(), chain.back()->coord())) continue;
-
-        // yes! collect it
-        eliminations.insert(cell.coord());
-    }
+    std::set<Coord> eliminations;
+    for (size_t index : doomed) eliminations.insert(board.cells()[index].coord());
 
     return eliminations;
 }
 
-template<class Set>
-void select_chain_candidates(const Cell &current, Value value, const Set &set, const std::unordered_set<Coord> &visited, std::unordered_set<Cell> &chain_candidates) {
-    assert(set.contains(current));
-
-    for (auto const &cell : set) {
-        // is this not the current cell
-        if (cell == current) continue;
-
-        // yes! but has it been visited before?
-        if (visited.count(cell.coord())) continue;
-
-        // yes! but is it a note?
-        if (!cell.isNote()) continue;
-
-        // yes! but does it have only two candidates?
-        if (cell.notes().count() != 2) continue;
-
-        // yes! but does it have value as candidate?
-        if (!cell.check(value)) continue;
-
-        // yes! ok, this is a bona fide chain candidate; record it
-        // unordered_set automatically handles duplicates
-        chain_candidates.insert(cell);
-    }
-}
-
 // Extend `chain` by one cell in every direction it can go, and recurse, stopping
 // the moment an actionable chain of exactly `max_len` cells is met.
 // `incoming_link_value` is the candidate the previous link resolved into `cell`,
@@ -132,8 +86,8 @@ void select_chain_candidates(const Cell &current, Value value, const Set &set, c
 //
 // Only chains of exactly `max_len` are tested, not every chain met on the way
 // down. Shorter ones were already tested -- and found not actionable, or find()
-// would have stopped -- on an earlier sweep, so re-testing them would repeat an
-// O(cells) scan per node for a result already known.
+// would have stopped -- on an earlier sweep, so re-testing them would repeat the
+// test per node for a result already known.
 //
 // A plain recursive function, not a lambda: the std::function was there only so
 // the lambda could name itself for the recursive call, and cost a heap allocation
@@ -142,96 +96,75 @@ void select_chain_candidates(const Cell &current, Value value, const Set &set, c
 // under a capture-all, so an accidental read of the anchor from inside the
 // recursion would have compiled silently. Here the anchor is not in scope at all.
 //
-// The two accumulators find_xychain owns -- the chain under construction and the
-// visited set -- are threaded by reference rather than captured.
-bool extend_chain(const Board &board, const Cell &cell, Value incoming_link_value,
-                  ChainCells &chain, std::unordered_set<Coord> &visited, FindingList &out,
-                  size_t max_len) {
+// The chain find_xychain owns is threaded by reference rather than captured.
+template<size_t Box>
+bool extend_chain(const BasicBoard<Box> &board, const BasicCell<Box> &cell, Value incoming_link_value,
+                  Chain<Box> &chain, FindingList &out, size_t max_len) {
     assert(cell.isNote());
     assert(cell.check(incoming_link_value));
     assert(cell.notes().count() == 2);
     assert(out.empty());
 
     // Structural depth bound. It is *unreachable* as the code stands: the recursive
-    // call below is made only from the `else` of `chain.size() == max_len`, so it
+    // call below is made only from the `else` of `chain.length == max_len`, so it
     // always arrives with room to spare, and find_xychain asserts max_len >= 2 so the
     // initial one-cell chain clears it too. Kept rather than deleted because it is
     // the bound a reader looks for, and because a refactor that moved the length test
     // out of the loop would need it back immediately -- without it, a max_len of 1
     // would enumerate every path while testing none of them.
-    if (chain.size() >= max_len) return false;
+    if (chain.length >= max_len) return false;
 
-    // select cells that can see current cell and share its "other" value
+    // the bi-value cells that see the current cell, hold its "other" value, and are
+    // not on the chain yet: one AND of four masks, the board's bivalue index among
+    // them, where it used to be three unit walks collecting copies of cells into a
+    // hash set, then a sort
     Value common_link_value = cell.other_value(incoming_link_value);
-    std::unordered_set<Cell> candidates;
-    select_chain_candidates(cell, common_link_value, board.row(cell), visited, candidates);
-    select_chain_candidates(cell, common_link_value, board.column(cell), visited, candidates);
-    select_chain_candidates(cell, common_link_value, board.nonet(cell), visited, candidates);
-
-    // Walk the candidates coord-sorted, not in the set's own order. `candidates`
-    // is an unordered_set, so its own order is unspecified and differs between
-    // standard libraries, and this technique stops at the first actionable chain it
-    // meets: among the equal-length chains this frame could reach, which one gets
-    // recorded IS this order. It is a result, not a presentation detail.
+    using G = Geometry<Box>;
+    auto candidates = G::kPeers[G::index(cell.coord())]
+                    & board.bivalue()
+                    & board.candidates(common_link_value)
+                    & ~chain.visited;
+
+    // Walk the candidates in coord order. This technique stops at the first
+    // actionable chain it meets, so among the equal-length chains this frame could
+    // reach, which one gets recorded IS this order. It is a result, not a
+    // presentation detail. A cell set iterates in ascending cell index, which is
+    // row-major and so exactly Coord order: the order is a property of the mask,
+    // where it used to take a sort over a hash set whose own order was unspecified
+    // and differed between standard libraries (#53).
     //
-    // Chain length no longer rides on it -- find() sweeps lengths from short to
-    // long, so a chain recorded here is the shortest actionable one on the board
-    // whatever order this frame walks in. What is left to this sort is the choice
-    // among chains of that same shortest length, which is the whole of what #53
-    // asked to have pinned.
+    // Chain length does not ride on it -- find() sweeps lengths from short to long,
+    // so a chain recorded here is the shortest actionable one on the board whatever
+    // order this frame walks in. What is left to this order is the choice among
+    // chains of that same shortest length.
     //
     // test_xychain_visit_order pins it (tests/unit/test_analyzer.cpp): a crafted
     // board offering several equal-length continuations, asserting the coord-least
-    // is the one recorded. What it pins is the *direction* of this ordering, and it
-    // pins that on every toolchain -- reversing the comparator sorts descending, and
-    // since a standard library varies the candidate set's iteration order but not its
-    // contents, and coords within it are unique, the reversed result is identical
-    // everywhere.
-    //
-    // What no test can pin is that a sort happens at all. Delete it and the order
-    // becomes unspecified rather than wrong, so the case may pass by coincidence. It
-    // does fail on libc++, where this board's candidates leave the bucket in a
-    // non-coord order, but that is one hash table's behaviour and not something to
-    // rest on. Deleting it changes no corpus board on this toolchain either, so the
-    // black-box suite cannot see it. That asymmetry is inherent, and it is what #53
-    // closes against rather than something left undone.
-    //
-    // `candidates` outlives every recursive call made from this frame, so the
-    // pointers pushed below stay valid for as long as they are on the chain,
-    // and `ordered` only holds pointers into it.
-    std::vector<const Cell *> ordered;
-    ordered.reserve(candidates.size());
-    for (const Cell &c : candidates) ordered.push_back(&c);
-    std::sort(ordered.begin(), ordered.end(),
-              [](const Cell *a, const Cell *b) { return a->coord() < b->coord(); });
-
-    for (const auto *next_cell_ptr : ordered) {
-        const Cell &next_cell = *next_cell_ptr;
+    // is the one recorded.
+    for (size_t next : candidates) {
+        const BasicCell<Box> &next_cell = board.cells()[next];
         // proactively extend the chain with next_cell
-        chain.push_back(&next_cell);
-        visited.insert(next_cell.coord());
+        chain.push(next);
 
         Value next_link_value = next_cell.other_value(common_link_value);
         bool done = false;
-        if (chain.size() == max_len) {
+        if (chain.length == max_len) {
             // at the length under test: is the chain valid, and would acting on it
             // have an impact?
             std::set<Coord> eliminations = test_xychain(board, next_link_value, chain);
             if (!eliminations.empty()) {
-                auto finding = std::make_shared<const XYChainFinding>(
-                    next_link_value, coords_of(chain), std::move(eliminations));
-                if (sVerbose) { std::cout << "  [fXY] "; finding->print(std::cout); std::cout << std::endl; }
-                out.push_back(finding);
+                auto const &finding = out.emplace<XYChainFinding>(
+                    next_link_value, coords_of(board, chain), std::move(eliminations));
+                if (sVerbose) { narration() << "  [fXY] "; finding.print(narration()); narration() << std::endl; }
                 done = true;
             }
         } else {
             // not yet: go deeper
-            done = extend_chain(board, next_cell, common_link_value, chain, visited, out, max_len);
+            done = extend_chain(board, next_cell, common_link_value, chain, out, max_len);
         }
 
         // backtrack
-        chain.pop_back();
-        visited.erase(next_cell.coord());
+        chain.pop();
 
         // stop at the first actionable chain: acting on it moves the state forward,
         // and SolverState::act re-runs analyze(), so anything else this frame could
@@ -254,11 +187,12 @@ bool extend_chain(const Board &board, const Cell &cell, Value incoming_link_valu
 // mutates the board between it and here, and there is only ever one finding. Hence
 // the assert rather than a skip -- a failure here means the finding and the board
 // disagree, which no legitimate path produces.
-bool act_on_xychain(Board &board, const XYChainFinding &entry) {
+template<size_t Box>
+bool act_on_xychain(BasicBoard<Box> &board, const XYChainFinding &entry) {
     bool did_act = false;
 
     for (const auto &coord : entry.eliminations) {
-        std::cout << "[XY] " << coord << " x" << entry.value
+        narration() << "[XY] " << coord << " x" << entry.value
                   << " ({" << entry.chain.front() << ":..:" << entry.chain.back() << "}#" << entry.value << ")" << std::endl;
         bool cleared = board.clear_note_at(coord, entry.value);
         assert(cleared);
@@ -280,7 +214,8 @@ void XYChainFinding::print(std::ostream &outs) const {
          << "x" << eliminations.size();
 }
 
-bool XYChainTechnique::find_xychain(const Board &board, const Cell &cell, const Value &value, size_t max_len, FindingList &out) {
+template<size_t Box>
+bool BasicXYChainTechnique<Box>::find_xychain(const Board &board, const Cell &cell, const Value &value, size_t max_len, FindingList &out) {
     assert(cell.isNote());
     assert(cell.notes().count() == 2);
     assert(cell.check(value));
@@ -288,13 +223,11 @@ bool XYChainTechnique::find_xychain(const Board &board, const Cell &cell, const
 
     if (!out.empty()) return false;   // already found; find()'s sweep is over
 
-    ChainCells chain;
-    std::unordered_set<Coord> visited;
+    Chain<Box> chain;
+    chain.value = value;
+    chain.push(Geometry<Box>::index(cell.coord()));
 
-    chain.push_back(&cell);
-    visited.insert(cell.coord());
-
-    return extend_chain(board, cell, value, chain, visited, out, max_len);
+    return extend_chain(board, cell, value, chain, out, max_len);
 }
 
 // https://www.sudokuwiki.org/XY_Chains
@@ -326,7 +259,8 @@ bool XYChainTechnique::find_xychain(const Board &board, const Cell &cell, const
 // Nothing is forbidden by this. A long chain is still found -- just not while a
 // shorter one exists. That is the difference between ordering the search and
 // capping it: a cap would lose the boards whose only chain is long.
-bool XYChainTechnique::find(const Board &board, FindingList &out) const {
+template<size_t Box>
+bool BasicXYChainTechnique<Box>::find(const Board &board, FindingList &out) const {
     assert(out.empty());
 
     // A chain visits distinct bi-value cells, so it cannot be longer than there are
@@ -347,11 +281,10 @@ bool XYChainTechnique::find(const Board &board, FindingList &out) const {
     // almost always holds an actionable chain, which is a hit, not a sweep.
     //
     // Tallies deliberately omitted. They were here, and they were corpus-sized, so they
-    // would have expired exactly the way the count in analyzer-ywing.cpp's sort comment
+    // would have expired exactly the way the count in analyzer-ywing.cpp's old sort comment
     // did (#63). Re-derive with the same counters if the figures matter.
-    size_t bivalue = 0;
-    for (const auto &cell : board.cells())
-        if (cell.isNote() && cell.notes().count() == 2) bivalue++;
+    const auto &cells = board.bivalue();
+    size_t bivalue = cells.count();
 
     // Starting at 2 costs one anchor scan that cannot yield, and says so more
     // plainly than starting at 3 would. A two-cell chain needs c1 = {X,a} and
@@ -360,14 +293,9 @@ bool XYChainTechnique::find(const Board &board, FindingList &out) const {
     // pair is cheaper in the cascade and analyze() stops at the first firing
     // technique, so a board that offers one never reaches here.
     for (size_t max_len = 2; max_len <= bivalue && out.empty(); max_len++) {
-        for (const auto &cell : board.cells()) {
-            // is this a note cell?
-            if (!cell.isNote()) continue;
-
-            // yes! but does it have only two candidates?
-            if (cell.notes().count() != 2) continue;
-
-            // yes! attempt to build chains from this cell for each candidate value
+        for (size_t index : cells) {
+            // attempt to build chains from this bi-value cell for each candidate value
+            const Cell &cell = board.cells()[index];
             auto values = cell.notes().values();
             if (find_xychain(board, cell, values[0], max_len, out)) break;
             if (find_xychain(board, cell, values[1], max_len, out)) break;
@@ -378,7 +306,18 @@ bool XYChainTechnique::find(const Board &board, FindingList &out) const {
     return !out.empty();
 }
 
-bool XYChainTechnique::apply(Board &board, FindingList &mine) const {
+// Every link of a chain is two bivalue cells that see each other, and even the
+// shortest chain has one.
+template<size_t Box>
+bool BasicXYChainTechnique<Box>::may_fire(const Board &board) const {
+    const auto &bivalue = board.bivalue();
+    for (size_t index : bivalue)
+        if ((Geometry<Box>::kPeers[index] & bivalue).any()) return true;
+    return false;
+}
+
+template<size_t Box>
+bool BasicXYChainTechnique<Box>::apply(Board &board, FindingList &mine) const {
     if (mine.empty()) return false;
     assert(mine.size() == 1);
 
@@ -390,3 +329,7 @@ bool XYChainTechnique::apply(Board &board, FindingList &mine) const {
     assert(did_act);
     return did_act;
 }
+
+template class BasicXYChainTechnique<3>;
+template class BasicXYChainTechnique<4>;
+template class BasicXYChainTechnique<5>;
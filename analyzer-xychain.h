@@ -45,7 +45,7 @@ struct XYChainFinding : Finding {
     // nor the order of the [XY] lines depends on it. Only "{front:..:back}" does.
     //
     // The unspecified-order problem #53 filed is a different one and is pinned
-    // elsewhere: see the sort in extend_chain.
+    // elsewhere: see the candidate order in extend_chain.
     XYChainFinding(Value v, std::vector<Coord> c, std::set<Coord> e)
         : value(v), chain(std::move(c)), eliminations(std::move(e)) {
         if (chain.size() > 1 && chain.back() < chain.front())
@@ -56,7 +56,11 @@ struct XYChainFinding : Finding {
     void print(std::ostream &) const override;
 };
 
-class XYChainTechnique : public Technique {
+template<size_t Box>
+class BasicXYChainTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using Cell = BasicCell<Box>;
+
 public:
     const char *name() const override { return "XY"; }
     Tier        tier() const override { return Tier::Advanced; }
@@ -64,6 +68,7 @@ public:
 
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
 
     // Whitebox seam, NOT a leaked private: anchor the chain search on one cell and
     // one of its two candidates, so a case can drive detection on a crafted
@@ -79,3 +84,5 @@ public:
     // which is how find() stops its sweep.
     static bool find_xychain(const Board &, const Cell &, const Value &, size_t max_len, FindingList &out);
 };
+
+using XYChainTechnique = BasicXYChainTechnique<3>;
@@ -16,7 +16,7 @@
 // YW is *given-tuple* shaped (docs/test-predicate-idiom.md): the pattern is the
 // triple (pivot, wing1, wing2), so test_ywing below is its public predicate. It
 // is the lone non-templated test_ predicate, so no explicit instantiation is
-// needed (contrast test_naked_pair<Row>). YWingFinding is in this header, not
+// needed (contrast test_naked_subset<Row>). YWingFinding is in this header, not
 // file-local, because the whitebox cases read its fields.
 struct YWingFinding : Finding {
     Value value;                    // candidate eliminated from cells seeing both wings
@@ -38,7 +38,11 @@ struct YWingFinding : Finding {
     }
 };
 
-class YWingTechnique : public Technique {
+template<size_t Box>
+class BasicYWingTechnique : public BasicTechnique<Box> {
+    using typename BasicTechnique<Box>::Board;
+    using Cell = BasicCell<Box>;
+
 public:
     const char *name() const override { return "YW"; }
     Tier        tier() const override { return Tier::Advanced; }
@@ -46,6 +50,7 @@ public:
 
     bool find(const Board &, FindingList &out) const override;
     bool apply(Board &, FindingList &mine) const override;
+    bool may_fire(const Board &) const override;
 
     // Tested contracts, NOT leaked privates. test_ywing: is (pivot, wing1, wing2)
     // a genuine, actionable Y-Wing (and if so, what value does it eliminate)?
@@ -59,3 +64,5 @@ public:
     static bool test_ywing(const Board &, const Cell &pivot, const Cell &wing1, const Cell &wing2, std::optional<Value> &out_value);
     static bool find_ywing(const Board &, const Cell &pivot, FindingList &out);
 };
+
+using YWingTechnique = BasicYWingTechnique<3>;
@@ -4,10 +4,19 @@
 #include "analyzer.h"
 #include "techniques.h"
 #include "board.h"
+#include "instrumentation.h"
+#include "verbose.h"
 
 #include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <iostream>
 #include <iterator>
 #include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
 #include <string_view>
 
 // The stateless techniques, built once and shared by every Analyzer. This list
@@ -16,28 +25,35 @@
 // kCascade literal above it, which the assert cross-checks -- and several more
 // elsewhere; techniques.h enumerates every site. Deliberately no count here: one
 // unenforced copy of that number is enough, and it belongs next to the list.
-const std::vector<std::unique_ptr<Technique>> &Analyzer::registry() {
+template<size_t Box>
+const std::vector<std::unique_ptr<BasicTechnique<Box>>> &BasicAnalyzer<Box>::registry() {
     // Canonical cascade order. Order is a correctness property, not a style
     // convention -- the cheapest technique that fires must fire first -- so it is
     // spelled out here once and checked against the built registry below, rather
     // than left implicit in the sequence of push_backs.
     [[maybe_unused]] static constexpr const char *kCascade[] = {
-        "NS", "HS", "NP", "LC", "HP", "XW", "SC", "YW", "SF", "FX", "FS", "XY",
+        "NS", "HS", "NP", "LC", "HP", "NT", "HT", "NQ", "HQ", "XW", "SC", "YW", "SF", "JF", "FX", "FS", "FJ", "XY",
     };
     static const std::vector<std::unique_ptr<Technique>> reg = [] {
         std::vector<std::unique_ptr<Technique>> r;
-        r.push_back(std::make_unique<NakedSingleTechnique>());
-        r.push_back(std::make_unique<HiddenSingleTechnique>());
-        r.push_back(std::make_unique<NakedPairTechnique>());
-        r.push_back(std::make_unique<LockedCandidatesTechnique>());
-        r.push_back(std::make_unique<HiddenPairTechnique>());
-        r.push_back(std::make_unique<XWingTechnique>());
-        r.push_back(std::make_unique<ColorChainTechnique>());
-        r.push_back(std::make_unique<YWingTechnique>());
-        r.push_back(std::make_unique<SwordfishTechnique>());
-        r.push_back(std::make_unique<FinnedXWingTechnique>());
-        r.push_back(std::make_unique<FinnedSwordfishTechnique>());
-        r.push_back(std::make_unique<XYChainTechnique>());
+        r.push_back(std::make_unique<BasicNakedSingleTechnique<Box>>());
+        r.push_back(std::make_unique<BasicHiddenSingleTechnique<Box>>());
+        r.push_back(std::make_unique<BasicSubsetTechnique<Box>>(Subset::Naked, 2));
+        r.push_back(std::make_unique<BasicLockedCandidatesTechnique<Box>>());
+        r.push_back(std::make_unique<BasicSubsetTechnique<Box>>(Subset::Hidden, 2));
+        r.push_back(std::make_unique<BasicSubsetTechnique<Box>>(Subset::Naked, 3));
+        r.push_back(std::make_unique<BasicSubsetTechnique<Box>>(Subset::Hidden, 3));
+        r.push_back(std::make_unique<BasicSubsetTechnique<Box>>(Subset::Naked, 4));
+        r.push_back(std::make_unique<BasicSubsetTechnique<Box>>(Subset::Hidden, 4));
+        r.push_back(std::make_unique<BasicXWingTechnique<Box>>());
+        r.push_back(std::make_unique<BasicColorChainTechnique<Box>>());
+        r.push_back(std::make_unique<BasicYWingTechnique<Box>>());
+        r.push_back(std::make_unique<BasicSwordfishTechnique<Box>>());
+        r.push_back(std::make_unique<BasicJellyfishTechnique<Box>>());
+        r.push_back(std::make_unique<BasicFinnedXWingTechnique<Box>>());
+        r.push_back(std::make_unique<BasicFinnedSwordfishTechnique<Box>>());
+        r.push_back(std::make_unique<BasicFinnedJellyfishTechnique<Box>>());
+        r.push_back(std::make_unique<BasicXYChainTechnique<Box>>());
         assert(r.size() == std::size(kCascade));
         for (size_t i = 0; i < r.size(); ++i)
             assert(std::string_view(r[i]->name()) == kCascade[i]);
@@ -46,7 +62,138 @@ const std::vector<std::unique_ptr<Technique>> &Analyzer::registry() {
     return reg;
 }
 
-void Analyzer::analyze() {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+uint64_t elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+// Process-wide rather than per-thread: set once from the command line, before
+// any solving (or any pool thread) starts, and only read after that.
+bool sVerifyIncremental = false;
+
+std::string render(const FindingList &findings) {
+    std::ostringstream out;
+    for (auto const &finding : findings) { finding->print(out); out << ' '; }
+    return out.str();
+}
+
+// Re-run an incremental search as a full one and insist on the same findings
+// in the same order. The full search is a re-derivation, so it narrates
+// nothing.
+template<size_t Box>
+void verify_incremental(const BasicTechnique<Box> &tech, const BasicBoard<Box> &board, const FindingList &incremental) {
+    FindingList full;
+    const bool verbose = sVerbose;
+    sVerbose = false;
+    tech.find(board, full);
+    sVerbose = verbose;
+
+    const bool agree = render(full) == render(incremental);
+    if (!agree) {
+        std::cerr << "incremental " << tech.name() << " diverged from a full rescan" << std::endl
+                  << "  full:        " << render(full) << std::endl
+                  << "  incremental: " << render(incremental) << std::endl;
+        // Not assert: the check is asked for at run time, NDEBUG or not.
+        std::abort();
+    }
+}
+
+// A search the prefilter skipped, run anyway: it must come up empty.
+template<size_t Box>
+void verify_skip(const BasicTechnique<Box> &tech, const BasicBoard<Box> &board) {
+    FindingList full;
+    const bool verbose = sVerbose;
+    sVerbose = false;
+    tech.find(board, full);
+    sVerbose = verbose;
+
+    if (!full.empty()) {
+        std::cerr << tech.name() << "'s prefilter skipped a search that finds something" << std::endl
+                  << "  full:        " << render(full) << std::endl;
+        std::abort();
+    }
+}
+} // namespace
+
+template<size_t Box>
+void BasicAnalyzer<Box>::set_verify_incremental(bool verify) {
+    sVerifyIncremental = verify;
+}
+
+// One technique's search, into its own bucket: none at all when its prefilter
+// rules it out, incremental when its last search left the rest of the board
+// clean, full otherwise (see analyze()).
+template<size_t Box>
+bool BasicAnalyzer<Box>::find(size_t i) {
+    const Technique &tech = *registry()[i];
+    ScanMark &scan = mScans[i];
+
+    SolveStats *stats = stats_sink();
+    const bool timed = stats && stats->timed();
+    const auto start = timed ? Clock::now() : Clock::time_point();
+
+    // A skipped search is an empty one, and leaves the board as clean for the
+    // technique as an empty search would. The prefilter's own time is the
+    // technique's find time: it is what the cascade paid to pass it by.
+    if (!tech.may_fire(mBoard)) {
+        if (stats) {
+            TechniqueStats &t = (*stats)[i];
+            ++t.finds;
+            ++t.skips;
+            if (timed) t.find_ns += elapsed_ns(start);
+        }
+        if (sVerifyIncremental) verify_skip(tech, mBoard);
+
+        scan = { mBoard.stamp(), true };
+        return false;
+    }
+
+    std::optional<typename Geometry<Box>::Cells> region;
+    if (scan.clean) region = tech.dirty_region(mBoard.changed_since(scan.stamp));
+
+    bool did_find = region ? tech.find_in(mBoard, *region, mFindings[i])
+                           : tech.find(mBoard, mFindings[i]);
+
+    // Timed before verification, which is a second, full search the run would
+    // not otherwise make.
+    if (stats) {
+        TechniqueStats &t = (*stats)[i];
+        ++t.finds;
+        t.hits += did_find;
+        if (timed) t.find_ns += elapsed_ns(start);
+    }
+    if (region && sVerifyIncremental) verify_incremental(tech, mBoard, mFindings[i]);
+
+    scan = { mBoard.stamp(), !did_find };
+    return did_find;
+}
+
+// One technique's apply(), counted into the stats sink when there is one: what
+// it placed and removed is read off the board's counts rather than asked of the
+// technique, so every technique is measured the same way.
+template<size_t Box>
+bool BasicAnalyzer<Box>::apply(size_t i) {
+    SolveStats *stats = stats_sink();
+    if (!stats) return registry()[i]->apply(mBoard, mFindings[i]);
+
+    const size_t note_cells = mBoard.note_cells_count();
+    const size_t notes = mBoard.notes_count();
+    const auto start = stats->timed() ? Clock::now() : Clock::time_point();
+
+    bool did_act = registry()[i]->apply(mBoard, mFindings[i]);
+
+    TechniqueStats &t = (*stats)[i];
+    if (stats->timed()) t.apply_ns += elapsed_ns(start);
+    t.applies += did_act;
+    t.placements += note_cells - mBoard.note_cells_count();
+    t.eliminations += notes - mBoard.notes_count();
+    return did_act;
+}
+
+template<size_t Box>
+void BasicAnalyzer<Box>::analyze() {
     // No note-filtering pass here: Board::set_value_at maintains the peer
     // invariant at every placement, so this is a pure query over a board that
     // already holds it (see #8).
@@ -63,10 +210,11 @@ void Analyzer::analyze() {
     assert(mFindings.size() == reg.size());
     bool did_find = false;
     for (size_t i = 0; i < reg.size() && !did_find; ++i)
-        did_find = reg[i]->find(mBoard, mFindings[i]);
+        did_find = find(i);
 }
 
-bool Analyzer::act(const bool singles_only) {
+template<size_t Box>
+bool BasicAnalyzer<Box>::act(const bool singles_only) {
     bool did_act = false;
 
     // Same cascade order as analyze(). Single-tier techniques always run;
@@ -75,7 +223,12 @@ bool Analyzer::act(const bool singles_only) {
     assert(mFindings.size() == reg.size());  // lockstep index; see analyze()
     for (size_t i = 0; i < reg.size() && !did_act; ++i) {
         if (reg[i]->tier() == Tier::Advanced && singles_only) continue;
-        did_act = reg[i]->apply(mBoard, mFindings[i]);
+        did_act = apply(i);
+
+        // Everything it found is on the board now, and every cell that changed
+        // for it is stamped after its search: the board is clean for it again
+        // outside what changed since.
+        if (did_act && mFindings[i].empty()) mScans[i].clean = true;
     }
 
     return did_act;
@@ -87,7 +240,8 @@ namespace {
 // in its own braces, which is what brace_each() selects. All framing (tag,
 // count, separators, per-item braces) lives here, so every technique's line is
 // laid out by the same code and only the per-finding body differs.
-void print_section(std::ostream &outs, const Technique &tech, const FindingList &findings) {
+template<size_t Box>
+void print_section(std::ostream &outs, const BasicTechnique<Box> &tech, const FindingList &findings) {
     outs << "[" << tech.name() << "](" << findings.size() << ") {";
     bool is_first = true;
     for (auto const &finding : findings) {
@@ -100,12 +254,13 @@ void print_section(std::ostream &outs, const Technique &tech, const FindingList
 }
 } // namespace
 
-std::ostream &operator<<(std::ostream &outs, Analyzer const &a) {
+template<size_t Box>
+std::ostream &operator<<(std::ostream &outs, BasicAnalyzer<Box> const &a) {
     // One line per technique, in cascade order, separated -- not terminated -- by
     // endl. The dump deliberately does not end in a newline: SolverState's
     // operator<< streams the analyzer last and appends nothing, so the separator
     // form (not a terminator) is what keeps the trailing byte off.
-    const auto &reg = Analyzer::registry();
+    const auto &reg = BasicAnalyzer<Box>::registry();
     assert(a.mFindings.size() == reg.size());  // lockstep index; see analyze()
     for (size_t i = 0; i < reg.size(); ++i) {
         if (i > 0) outs << std::endl;
@@ -114,3 +269,10 @@ std::ostream &operator<<(std::ostream &outs, Analyzer const &a) {
 
     return outs;
 }
+
+template class BasicAnalyzer<3>;
+template class BasicAnalyzer<4>;
+template class BasicAnalyzer<5>;
+template std::ostream &operator<<(std::ostream &, BasicAnalyzer<3> const &);
+template std::ostream &operator<<(std::ostream &, BasicAnalyzer<4> const &);
+template std::ostream &operator<<(std::ostream &, BasicAnalyzer<5> const &);
@@ -9,12 +9,23 @@
 #include <memory>
 #include <vector>
 
-class Analyzer {
+template<size_t Box> class BasicAnalyzer;
+template<size_t Box> std::ostream &operator<<(std::ostream &, BasicAnalyzer<Box> const &);
+
+// The analyzer for boards of box size Box (see geometry.h): the same cascade at
+// every size, over that size's instances of the techniques. Analyzer is the
+// 9x9 one.
+template<size_t Box>
+class BasicAnalyzer {
 public:
-    Analyzer(Board &board) : mFindings(registry().size()), mBoard(board) { }
+    using Board = BasicBoard<Box>;
+    using Technique = BasicTechnique<Box>;
+
+    BasicAnalyzer(Board &board) : mFindings(registry().size()), mScans(registry().size()), mBoard(board) { }
 
-    Analyzer(Board &board, Analyzer const &other)
+    BasicAnalyzer(Board &board, BasicAnalyzer const &other)
         : mFindings(other.mFindings)
+        , mScans(other.mScans)
         , mBoard(board) { }
 
     // The only sanctioned way to copy an Analyzer is the rebinding constructor
@@ -24,14 +35,28 @@ public:
     // it (which also suppresses the implicit move ctor) so any accidental copy,
     // e.g. a =default'd SolverState, fails to compile rather than silently
     // aliasing the wrong board.
-    Analyzer(const Analyzer &) = delete;
-    Analyzer &operator=(const Analyzer &) = delete;
+    BasicAnalyzer(const BasicAnalyzer &) = delete;
+    BasicAnalyzer &operator=(const BasicAnalyzer &) = delete;
 
+    // Find the cheapest technique that fires, as findings in its bucket. A
+    // technique that can localize (Technique::dirty_region) searches only the
+    // cells the board's changes since its last search could have affected,
+    // whenever that last search left nothing behind: it found nothing, or
+    // everything it found has since been applied. Otherwise it searches the
+    // whole board. Either way the findings, and their order, are the same. And
+    // a technique whose prefilter (Technique::may_fire) says it cannot fire is
+    // not searched at all.
     void analyze();
 
+    // Verification mode: redo every incremental search as a full one and abort
+    // if the two disagree, and every search a prefilter skipped, aborting if it
+    // finds anything. Process-wide, for every board size; set it before any
+    // solving starts.
+    static void set_verify_incremental(bool verify);
+
     bool act(const bool singles_only);
 
-    friend std::ostream& operator<< (std::ostream& outs, Analyzer const &);
+    friend std::ostream& operator<< <Box>(std::ostream& outs, BasicAnalyzer const &);
 
     // Whitebox unit tests reach mFindings through this friend, so the
     // rebinding-ctor regression test can prove the one hand-written member copy
@@ -41,24 +66,40 @@ public:
     // production code depends on it.
     friend struct AnalyzerTest;
 
-private:
     //** technique registry
     // The solving techniques, constructed once and shared by every Analyzer.
     // Function-local static (defined in analyzer.cpp): built on first use, and
     // -- crucially -- never copied per state, so no technique can be dropped by
-    // a missed copy in the rebinding ctor. Private: analyze(), act() and
-    // operator<< all reach it via membership or friendship, and nothing else
-    // needs to (AnalyzerTest does not -- see the friend declaration above).
+    // a missed copy in the rebinding ctor. Public, read-only, for what reports
+    // on the techniques rather than runs them: SolveStats labels its rows with
+    // their names (see instrumentation.h). Every size's registry holds the same
+    // techniques in the same order.
     static const std::vector<std::unique_ptr<Technique>> &registry();
 
+private:
     // Per-state findings, one bucket per registry() technique, indexed parallel
-    // to it. The only member carried forward across the state copy (see issue #7
-    // lifecycle decision), and the only one the rebinding ctor has to name.
+    // to it. Carried forward across the state copy (see issue #7 lifecycle
+    // decision), and with mScans below the only members the rebinding ctor names.
     // Declared before mBoard so that ctor's init list is legal under -Wreorder;
     // the rebinding-ctor regression test guards the one hand-written
     // mFindings(other.mFindings) copy.
     std::vector<FindingList> mFindings;
 
+    // Per-technique record of its last search, indexed like mFindings: the
+    // board's stamp() when it searched, and whether the board outside what has
+    // changed since is known to hold none of its findings (see analyze()).
+    // Carried across the state copy with the findings they describe.
+    struct ScanMark {
+        uint32_t stamp = 0;
+        bool clean = false;
+    };
+    std::vector<ScanMark> mScans;
+
+    bool find(size_t i);
+    bool apply(size_t i);
+
 private:
     Board &mBoard;
 };
+
+using Analyzer = BasicAnalyzer<3>;
@@ -0,0 +1,333 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "batch.h"
+#include "board.h"
+#include "canonical.h"
+#include "geometry.h"
+#include "instrumentation.h"
+#include "search.h"
+#include "solver.h"
+#include "store.h"
+#include "verbose.h"
+#include "workpool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// How many boards are read before the block is solved and its results written.
+// Large enough that the pool's per-block thread start-up is noise next to the
+// solving, small enough that a huge corpus streams in bounded memory and the
+// first results appear promptly.
+const size_t kBlockSize = 4096;
+
+// The result lines of recently solved puzzles, keyed by their canonical form
+// (see canonical.h), holding at most `capacity` and evicting the least recently
+// used. Shared by the pool's workers, hence the lock: a lookup and an insert
+// are each one short critical section. Two workers missing on the same puzzle
+// at once both solve it, which costs time but not correctness -- they solve
+// the same canonical board, so the second insert finds the first's entry.
+class SolutionCache {
+public:
+    explicit SolutionCache(size_t capacity) : mCapacity(capacity) { }
+
+    bool find(const std::string &key, std::string &result) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mIndex.find(key);
+        if (it == mIndex.end()) return false;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        result = it->second->second;
+        return true;
+    }
+
+    void insert(const std::string &key, const std::string &result) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mIndex.count(key)) return;
+        mEntries.emplace_front(key, result);
+        mIndex.emplace(key, mEntries.begin());
+        if (mEntries.size() > mCapacity) {
+            mIndex.erase(mEntries.back().first);
+            mEntries.pop_back();
+        }
+    }
+
+private:
+    using Entries = std::list<std::pair<std::string, std::string>>;   // most recent first
+
+    size_t mCapacity;
+    std::mutex mMutex;
+    Entries mEntries;
+    std::unordered_map<std::string, Entries::iterator> mIndex;
+};
+
+// Solve one board description of box size Box -- a '.' and then one symbol per
+// cell, as Board reads it -- and write its single result line (newline
+// included).
+template<size_t Box = 3>
+void solve_board(const std::string &desc, const BatchOptions &options, std::ostream &out) {
+    if (options.count > 0) {
+        try {
+            out << count_solutions(BasicBoard<Box>(desc), options.count) << '\n';
+        }
+        catch (const std::runtime_error &e) {
+            out << "invalid: " << e.what() << '\n';
+        }
+        return;
+    }
+
+    typename BasicSolver<Box>::ptr solver;
+    try {
+        // Deltas: batch never steps back, so a per-step state copy would buy
+        // nothing; the journal costs a few bytes per change instead.
+        solver = std::make_unique<BasicSolver<Box>>(desc, History::Deltas);
+    }
+    catch (const std::runtime_error &e) {
+        out << "invalid: " << e.what() << '\n';
+        return;
+    }
+    // Grading reads what the solve applied off the board's own statistics, so
+    // those are gathered per board and added into the run's afterwards. They are
+    // timed only when the run's are: a grade needs just the counts.
+    SolveStats *run_stats = stats_sink();
+    std::optional<SolveStats> board_stats;
+    if (options.grade) {
+        board_stats.emplace(run_stats != nullptr);
+        set_stats_sink(&*board_stats);
+    }
+    if (SolveStats *stats = stats_sink()) stats->add_board();
+
+    solver->solve();
+    if (board_stats) {
+        set_stats_sink(run_stats);
+        if (run_stats) *run_stats += *board_stats;
+    }
+    if (solver->solved()) {
+        solver->print_line(out);
+        if (board_stats) board_stats->print_grade(out);
+        out << '\n';
+        return;
+    }
+    if (!options.search) {
+        out << "unsolved\n";
+        return;
+    }
+
+    size_t guesses = 0;
+    if (solver->finish_by_search(guesses)) {
+        solver->print_line(out);
+        out << " guesses: " << guesses << '\n';
+    } else {
+        out << "no solution\n";
+    }
+}
+
+// The result line for canonical puzzle `cells`, read from `store` if it holds
+// the puzzle and solved otherwise. A result the store did not hold is added to
+// it; the store keeps the grade whether or not this run prints one, so such a
+// puzzle is solved graded and the grade dropped afterwards if not asked for.
+std::string solve_canonical(const std::string &cells, const BatchOptions &options, SolutionStore *store) {
+    std::ostringstream solved;
+    if (!store) {
+        solve_board("." + cells, options, solved);
+        return solved.str();
+    }
+
+    const size_t n = Geometry<3>::kCells;
+    const SolutionStore::Key key = SolutionStore::pack(cells);
+    SolutionStore::Entry entry;
+    if (store->find(key, entry) && (entry.solved || !options.search)) {
+        if (SolveStats *stats = stats_sink()) stats->add_reused_board();
+        if (entry.solved) {
+            std::string result(n, '.');
+            SolutionStore::unpack(entry.solution, result.data());
+            if (options.grade) result += entry.grade;
+            return result + '\n';
+        }
+        return "unsolved\n";
+    }
+
+    BatchOptions graded = options;
+    graded.grade = true;
+    solve_board("." + cells, graded, solved);
+    std::string result = solved.str();
+
+    // The cascade solved it when the line is a grid the search did not finish;
+    // anything else is a stall, whatever the search then made of it.
+    const bool grid = result.size() > n && std::isdigit(static_cast<unsigned char>(result[0]));
+    if (grid && result.compare(n, 9, " guesses:") != 0) {
+        const std::string_view line(result);
+        store->append(key, true, line.substr(0, n), line.substr(n, line.size() - n - 1));
+        if (!options.grade) result.erase(n, result.size() - n - 1);
+    } else {
+        store->append(key, false, {}, {});
+    }
+    return result;
+}
+
+// Solve one 81-cell board description through `cache` and `store`, either of
+// which may be absent. What is solved, cached and stored is the board's
+// canonical form, so every symmetry of a puzzle shares one entry; a board that
+// does not load is reported as it is, since the error names the unit it found
+// the fault in. The result's leading grid, when it has one, is in the canonical
+// orientation, and goes back to the board's own.
+void solve_cached(const std::string &desc, const BatchOptions &options, SolutionCache *cache,
+                  SolutionStore *store, std::ostream &out) {
+    std::optional<Board> board;
+    try {
+        board.emplace(desc);
+    }
+    catch (const std::runtime_error &e) {
+        out << "invalid: " << e.what() << '\n';
+        return;
+    }
+
+    // No proper puzzle has fewer than 17 givens, and a board with few is where
+    // canonicalize is slow (see canonical.h), so such a board is solved as it is.
+    if (board->solved().count() < 17) return solve_board(desc, options, out);
+
+    const Canonical canonical = canonicalize(*board);
+    std::string result;
+    if (cache && cache->find(canonical.cells, result)) {
+        if (SolveStats *stats = stats_sink()) stats->add_reused_board();
+    } else {
+        result = solve_canonical(canonical.cells, options, store);
+        if (cache) cache->insert(canonical.cells, result);
+    }
+
+    const size_t cells = Geometry<3>::kCells;
+    if (result.size() > cells && std::isdigit(static_cast<unsigned char>(result[0])))
+        result.replace(0, cells, canonical.symmetry.restore(result.substr(0, cells)));
+    out << result;
+}
+
+// Solve one board line and write its single result line (newline included).
+void solve_line(const std::string &board, const BatchOptions &options, SolutionCache *cache,
+                SolutionStore *store, std::ostream &out) {
+    // A stream with no buffer is permanently bad, so every insertion into it is
+    // rejected up front -- the cheapest way to discard the narration. One per
+    // thread, since the narration stream itself is per-thread (see verbose.h);
+    // setting it on every board is a pointer store, and keeps pool workers,
+    // which start with the std::cout default, silent from their first board.
+    thread_local std::ostream discard(nullptr);
+    set_narration(discard);
+
+    // The larger sizes go by their length, with or without a leading '.' (the
+    // same rule as for the 81-cell form below); any other length is read as
+    // the 81-cell form, and rejected if it is not one. They are solved as they
+    // are: the canonical form, and so the cache and the store, are 9x9 only
+    // (see canonical.h).
+    auto large = [&](size_t n) -> std::optional<std::string> {
+        if (board.size() != n && !(board.size() == n + 1 && board[0] == '.')) return std::nullopt;
+        std::string desc = ".";
+        desc += board.substr(board.size() - n);
+        return desc;
+    };
+    if (auto desc = large(Geometry<4>::kCells)) return solve_board<4>(*desc, options, out);
+    if (auto desc = large(Geometry<5>::kCells)) return solve_board<5>(*desc, options, out);
+
+    // Board reads the 81-cell form behind a leading '.'; accept the line with or
+    // without one. Only an 82-character line can already carry it -- an
+    // 81-character line starting with '.' is a board whose first cell is empty.
+    const std::string desc = board.size() == 82 && board[0] == '.' ? board : "." + board;
+
+    // A count is not a solution, so --count leaves the store out. A grade takes
+    // the canonical path even with neither: the cascade's path, and so the
+    // grade, can differ between images of one puzzle, and the canonical image
+    // is the one every image shares.
+    if (store && options.count > 0) store = nullptr;
+    if (cache || store || (options.grade && options.count == 0))
+        return solve_cached(desc, options, cache, store, out);
+    solve_board(desc, options, out);
+}
+
+// Solve one block of boards on `jobs` threads and write their results in
+// block order. Each task renders its result into its own slot, so the workers
+// share nothing but the read-only block and the registry -- and `stats`, when
+// gathering: each task records into its own SolveStats and adds it in under
+// the lock, once per board.
+void solve_block(const std::vector<std::string> &boards, const BatchOptions &options,
+                 SolutionCache *cache, SolutionStore *store, SolveStats *stats, std::ostream &out) {
+    if (options.jobs <= 1) {
+        set_stats_sink(stats);
+        for (auto const &board : boards) solve_line(board, options, cache, store, out);
+        set_stats_sink(nullptr);
+        return;
+    }
+
+    std::vector<std::string> results(boards.size());
+    std::mutex stats_mutex;
+    parallel_for(boards.size(), options.jobs, [&](size_t i) {
+        std::ostringstream result;
+        if (!stats) {
+            solve_line(boards[i], options, cache, store, result);
+        } else {
+            SolveStats board_stats;
+            set_stats_sink(&board_stats);
+            solve_line(boards[i], options, cache, store, result);
+            set_stats_sink(nullptr);
+            std::lock_guard<std::mutex> lock(stats_mutex);
+            *stats += board_stats;
+        }
+        results[i] = result.str();
+    });
+    for (auto const &result : results) out << result;
+}
+
+} // namespace anonymous
+
+int run_batch(std::istream &in, std::ostream &out, const BatchOptions &options) {
+    std::optional<SolveStats> stats;
+    if (options.stats != StatsFormat::None) stats.emplace();
+    SolveStats *sink = stats ? &*stats : nullptr;
+    std::optional<SolutionCache> cache;
+    if (options.cache > 0) cache.emplace(options.cache);
+    SolutionCache *solutions = cache ? &*cache : nullptr;
+    std::optional<SolutionStore> store;
+    if (!options.store.empty()) {
+        try {
+            store.emplace(options.store);
+        }
+        catch (const std::runtime_error &e) {
+            std::cerr << "error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    SolutionStore *stored = store ? &*store : nullptr;
+
+    std::vector<std::string> boards;
+    std::string line;
+    while (std::getline(in, line)) {
+        line.erase(std::remove_if(line.begin(), line.end(), [](unsigned char c){ return std::isspace(c); }),
+                   line.end());
+        if (line.empty() || line[0] == '#') continue;
+
+        boards.push_back(line);
+        if (boards.size() == kBlockSize) {
+            solve_block(boards, options, solutions, stored, sink, out);
+            if (stored) stored->flush();
+            boards.clear();
+        }
+    }
+    solve_block(boards, options, solutions, stored, sink, out);
+    if (stored) stored->flush();
+    out.flush();
+
+    if (options.stats == StatsFormat::Table) stats->print_table(std::cerr);
+    if (options.stats == StatsFormat::Json)  stats->print_json(std::cerr);
+
+    set_narration(std::cout);
+    return 0;
+}
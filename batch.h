@@ -0,0 +1,84 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+// Batch mode: solve a stream of boards without the REPL.
+//
+// Each input line is one board in the 81-cell form (digits 1-9 for givens, '.'
+// or '0' for empty cells; whitespace is ignored and a leading '.' is
+// optional). Blank lines and lines starting with '#' are skipped. For every
+// board, exactly one line is written to `out`, in input order:
+//
+//   <81 digits>            the solved grid
+//   unsolved               the cascade stalled before finishing the board
+//   invalid: <reason>      the board did not load (the REPL's load error text)
+//
+// With `search` set, a board the cascade stalls on is finished by backtracking
+// (see search.h) instead, from the candidates the cascade left:
+//
+//   <81 digits> guesses: N the grid the search found, and the guesses it took
+//   no solution            the search proved there is none
+//
+// With `count` set (non-zero), boards are not solved at all: each line is the
+// number of solutions the board has, counted no further than `count` -- so
+// `count` = 2 checks uniqueness -- or the invalid: line.
+//
+// Solving is silent: the narration stream (see verbose.h) is pointed at a
+// discarding stream for the duration, so no "Step #N:" or "[XX] ..." lines are
+// produced.
+//
+// `jobs` is the number of threads solving at once (see workpool.h); the output
+// is identical for every value, order included. Boards are read and solved a
+// block at a time, so memory stays bounded on an arbitrarily long stream.
+// Returns the process exit status: 0 once the whole stream has been read,
+// whatever the per-board outcomes were; 1 if the store (below) does not open.
+//
+// With `grade` set, a board the cascade solves carries its difficulty after the
+// grid (see SolveStats::print_grade), from the same silent solve:
+//
+//   <81 digits> grade: <score> <hardest> <tag>:<n> ...
+//
+// Every other line is as without it. The cascade can take a different path
+// through each image of one puzzle, applying a technique more often on one than
+// another, so what is graded is the board's canonical form (see canonical.h):
+// every symmetry of a puzzle gets the same grade. A guesses count under `grade`
+// is the canonical puzzle's too.
+//
+// With `cache` set (non-zero), 81-cell boards go through a cache of the last
+// `cache` distinct puzzles solved, keyed by canonical form (see canonical.h):
+// a board that is a relabeling, transpose or band/stack permutation of one
+// solved recently is answered from the cache, its grid mapped back to the
+// board's orientation, instead of running the cascade again. To keep the output
+// independent of which symmetry arrived first, and of `jobs`, a miss solves the
+// canonical puzzle rather than the board as given. The grid is the same either
+// way -- a proper puzzle has one solution -- but the path there, and so a
+// guesses count, is the canonical puzzle's.
+//
+// With `store` set to a path, results also persist across runs in a solution
+// store there (see store.h), keyed by canonical form the same way: a board whose
+// canonical puzzle is held is answered from the store's memory map, and one
+// that is not is solved, graded, and appended to the store's log for the next
+// run. The store takes the canonical path even without `cache`. A stored stall
+// is answered "unsolved" without a solve, unless `search` asks for the search to
+// finish it. --count lines do not use the store.
+//
+// `stats` asks for per-technique statistics over the whole run (see
+// instrumentation.h), written to std::cerr once the last result is out, as a
+// table or as JSON; the results on `out` are unchanged.
+enum class StatsFormat { None, Table, Json };
+
+struct BatchOptions {
+    size_t jobs = 1;
+    bool search = false;
+    size_t count = 0;
+    bool grade = false;
+    size_t cache = 0;
+    std::string store;
+    StatsFormat stats = StatsFormat::None;
+};
+
+int run_batch(std::istream &in, std::ostream &out, const BatchOptions &options = {});
@@ -0,0 +1,343 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+//
+// Microbenchmarks for the technique registry.
+//
+// The correctness suites (tests/run.sh, tests/unit) say nothing about speed,
+// and a whole-solve timing (batch --stats) blurs a regression in one technique
+// into the cascade around it. This times each Analyzer::registry() entry on its
+// own, on the positions it actually fires on:
+//
+//   1. Every board of the corpus files is stepped through the cascade by hand
+//      -- the first technique that finds something applies it, as in act() --
+//      and the position each technique first fires on, per board, is kept as
+//      that technique's snapshot (up to --snapshots of them).
+//   2. Each technique's find() is timed over its snapshots, a full search of
+//      the board each time, and so is its apply() of what find() recorded, on
+//      a fresh copy of the board each time (the copy is not timed).
+//   3. Each measurement is repeated in --rounds rounds, each long enough to
+//      dwarf the clock's resolution; the report is the mean ns/op over the
+//      rounds, with their standard deviation and the fastest round.
+//   4. Unless --only narrows the run, a board copy, a walk over every cell and
+//      a solve step under either history (see solver.h) are timed the same
+//      way, on the corpus boards as loaded (up to --snapshots of them): the
+//      costs the board's layout sets.
+//
+// The snapshots are a fixed function of the corpus, so two builds benchmarked
+// on the same files time the same work. Framework-free, like the unit tests.
+
+#include "analyzer.h"
+#include "board.h"
+#include "solver.h"
+#include "technique.h"
+#include "verbose.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// The techniques consult this application-global before narrating; it is
+// normally defined in the REPL main, which this binary does not link.
+thread_local bool sVerbose = false;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+// The board on one corpus line: either the whole line (batch mode's shape, see
+// batch.h), or notes.txt's middle field, "date - r1 r2 .. r9 - tags". Comments,
+// headers and blank lines have no board and come back empty.
+std::string board_on(const std::string &line) {
+    std::string field = line;
+    const size_t dash = line.find(" - ");
+    if (dash != std::string::npos) {
+        const size_t end = line.find(" - ", dash + 3);
+        field = line.substr(dash + 3, end == std::string::npos ? std::string::npos : end - dash - 3);
+    }
+
+    std::string cells;
+    for (char c : field) if (c != ' ') cells += c;
+    if (cells.size() != Board::width * Board::height) return "";
+    for (char c : cells) if (c != '.' && (c < '1' || c > '9')) return "";
+    return cells;
+}
+
+// Step `board` through the cascade until it is solved or stalls, keeping the
+// position each technique first fires on.
+void collect(Board board, size_t limit, std::vector<std::vector<Board>> &snapshots) {
+    const auto &reg = Analyzer::registry();
+    std::vector<bool> seen(reg.size(), false);
+
+    for (;;) {
+        FindingList findings;
+        size_t i = 0;
+        while (i < reg.size() && !reg[i]->find(board, findings)) ++i;
+        if (i == reg.size()) return;
+
+        if (!seen[i] && snapshots[i].size() < limit) snapshots[i].push_back(board);
+        seen[i] = true;
+        if (!reg[i]->apply(board, findings)) return;
+    }
+}
+
+// One operation's timings, in ns/op, one per round.
+struct Samples {
+    std::vector<double> rounds;
+
+    double mean() const {
+        double sum = 0;
+        for (double r : rounds) sum += r;
+        return sum / rounds.size();
+    }
+    double stddev() const {
+        if (rounds.size() < 2) return 0;
+        const double m = mean();
+        double sum = 0;
+        for (double r : rounds) sum += (r - m) * (r - m);
+        return std::sqrt(sum / (rounds.size() - 1));
+    }
+    double best() const { return *std::min_element(rounds.begin(), rounds.end()); }
+};
+
+// Long enough per round that the clock reads (two per round for find(), two
+// per operation for apply()) are noise.
+constexpr uint64_t kRoundNs = 20'000'000;
+
+// Time `pass`, which performs `ops` operations, in rounds of as many passes as
+// it takes to fill kRoundNs.
+template<typename Pass>
+Samples time_passes(Pass pass, size_t ops, size_t rounds) {
+    // Calibrate: double the passes per round until one round lasts kRoundNs.
+    size_t passes = 1;
+    for (;;) {
+        const auto start = Clock::now();
+        for (size_t p = 0; p < passes; ++p) pass();
+        if (elapsed_ns(start) >= kRoundNs / 4 || passes >= (size_t(1) << 20)) break;
+        passes *= 2;
+    }
+    passes *= 4;
+
+    Samples samples;
+    for (size_t r = 0; r < rounds; ++r) {
+        const auto start = Clock::now();
+        for (size_t p = 0; p < passes; ++p) pass();
+        samples.rounds.push_back(double(elapsed_ns(start)) / (passes * ops));
+    }
+    return samples;
+}
+
+Samples time_find(const Technique &tech, const std::vector<Board> &boards, size_t rounds) {
+    return time_passes([&]() {
+        for (auto const &board : boards) {
+            FindingList findings;
+            tech.find(board, findings);
+        }
+    }, boards.size(), rounds);
+}
+
+// The two things every solve does to a whole board regardless of technique:
+// copy it (a SolverState per step, a Board per apply() above), and walk all of
+// its cells. Both track the size of Cell, which is why they are here.
+Samples time_copy(const std::vector<Board> &boards, size_t rounds) {
+    return time_passes([&]() {
+        for (auto const &board : boards) {
+            Board copy(board);
+            asm volatile("" : : "r"(&copy) : "memory");
+        }
+    }, boards.size(), rounds);
+}
+
+// A whole solve of each board, through Solver::solve_one_step under `history`,
+// per step taken: each step copies or journals the state and re-analyzes, so
+// this is where a board copy's cost lands in a real solve. The load and first
+// analysis of each board are counted in with its steps.
+Samples time_steps(const std::vector<std::string> &descs, History history, size_t rounds) {
+    size_t steps = 0;
+    for (auto const &desc : descs) {
+        Solver solver(desc, history);
+        while (solver.solve_one_step(false)) ++steps;
+    }
+    return time_passes([&]() {
+        for (auto const &desc : descs) {
+            Solver solver(desc, history);
+            while (solver.solve_one_step(false)) { }
+        }
+    }, steps, rounds);
+}
+
+Samples time_scan(const std::vector<Board> &boards, size_t rounds) {
+    return time_passes([&]() {
+        for (auto const &board : boards) {
+            size_t notes = 0;
+            for (auto const &cell : board.cells())
+                if (cell.isNote()) notes += cell.notes().count();
+            asm volatile("" : : "r"(notes));
+        }
+    }, boards.size(), rounds);
+}
+
+Samples time_apply(const Technique &tech, const std::vector<Board> &boards, size_t rounds) {
+    // What there is to apply on each snapshot, found once: apply() consumes its
+    // list, so each operation gets a copy, along with its copy of the board.
+    std::vector<FindingList> found(boards.size());
+    for (size_t b = 0; b < boards.size(); ++b) tech.find(boards[b], found[b]);
+
+    Samples samples;
+    for (size_t r = 0; r < rounds; ++r) {
+        uint64_t ns = 0, ops = 0;
+        while (ns < kRoundNs) {
+            for (size_t b = 0; b < boards.size(); ++b) {
+                Board board(boards[b]);
+                FindingList findings(found[b]);
+
+                const auto start = Clock::now();
+                tech.apply(board, findings);
+                ns += elapsed_ns(start);
+                ++ops;
+            }
+        }
+        samples.rounds.push_back(double(ns) / ops);
+    }
+    return samples;
+}
+
+void usage(const char *name) {
+    std::cerr << "usage: " << name << " [--rounds N] [--snapshots N] [--only TAG] corpus..." << std::endl
+              << "  --rounds N     timed rounds per measurement (default 10)" << std::endl
+              << "  --snapshots N  positions kept per technique (default 64)" << std::endl
+              << "  --only TAG     benchmark only the technique tagged TAG (e.g. XY)" << std::endl;
+}
+
+bool parse_size(const char *arg, size_t &out) {
+    try {
+        size_t used = 0;
+        const unsigned long n = std::stoul(arg, &used);
+        if (arg[used] != '\0' || n == 0) return false;
+        out = n;
+        return true;
+    }
+    catch (const std::logic_error &) {
+        return false;
+    }
+}
+
+} // namespace anonymous
+
+int main(int argc, char *argv[]) {
+    size_t rounds = 10, limit = 64;
+    std::string only;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--rounds") && i + 1 < argc && parse_size(argv[i + 1], rounds)) {
+            ++i;
+        } else if (!std::strcmp(argv[i], "--snapshots") && i + 1 < argc && parse_size(argv[i + 1], limit)) {
+            ++i;
+        } else if (!std::strcmp(argv[i], "--only") && i + 1 < argc) {
+            only = argv[++i];
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // apply() narrates its action lines whatever sVerbose says; a stream with
+    // no buffer swallows them, as in batch mode (see batch.cpp).
+    std::ostream discard(nullptr);
+    set_narration(discard);
+
+    const auto &reg = Analyzer::registry();
+    std::vector<std::vector<Board>> snapshots(reg.size());
+    std::vector<Board> givens;
+    std::vector<std::string> descs;
+    size_t boards = 0;
+    for (auto const &file : files) {
+        std::ifstream in(file);
+        if (!in) {
+            std::cerr << "cannot read " << file << std::endl;
+            return 1;
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            const std::string cells = board_on(line);
+            if (cells.empty()) continue;
+
+            std::string desc = ".";
+            desc += cells;
+            try {
+                Board board(desc);
+                if (givens.size() < limit) {
+                    givens.push_back(board);
+                    descs.push_back(desc);
+                }
+                collect(board, limit, snapshots);
+                ++boards;
+            }
+            catch (const std::runtime_error &e) {
+                std::cerr << file << ": skipping " << cells << ": " << e.what() << std::endl;
+            }
+        }
+    }
+
+    std::cout << "Technique microbenchmarks over " << boards << " board(s), "
+              << rounds << " round(s) each:" << std::endl
+              << std::left << std::setw(6) << "tech" << std::right << std::setw(6) << "pos"
+              << std::setw(14) << "find ns/op" << std::setw(10) << "+-sd%" << std::setw(12) << "best"
+              << std::setw(14) << "apply ns/op" << std::setw(10) << "+-sd%" << std::setw(12) << "best"
+              << std::endl;
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < reg.size(); ++i) {
+        const Technique &tech = *reg[i];
+        if (!only.empty() && only != tech.name()) continue;
+
+        std::cout << std::left << std::setw(6) << tech.name() << std::right
+                  << std::setw(6) << snapshots[i].size();
+        if (snapshots[i].empty()) {
+            std::cout << std::setw(14) << "-" << std::endl;
+            continue;
+        }
+
+        const Samples find = time_find(tech, snapshots[i], rounds);
+        const Samples apply = time_apply(tech, snapshots[i], rounds);
+        std::cout << std::setw(14) << find.mean() << std::setw(10) << 100 * find.stddev() / find.mean()
+                  << std::setw(12) << find.best()
+                  << std::setw(14) << apply.mean() << std::setw(10) << 100 * apply.stddev() / apply.mean()
+                  << std::setw(12) << apply.best() << std::endl;
+    }
+
+    if (!only.empty()) return 0;
+    const Samples copy = time_copy(givens, rounds);
+    const Samples scan = time_scan(givens, rounds);
+    const Samples snapshots_step = time_steps(descs, History::Snapshots, rounds);
+    const Samples deltas_step = time_steps(descs, History::Deltas, rounds);
+    std::cout << std::endl
+              << "Whole-board operations over " << givens.size() << " board(s) (sizeof(Cell) = "
+              << sizeof(Cell) << "):" << std::endl
+              << std::left << std::setw(12) << "op" << std::right
+              << std::setw(14) << "ns/op" << std::setw(10) << "+-sd%" << std::setw(12) << "best" << std::endl;
+    for (auto const &[name, samples] : { std::pair{"copy", copy}, std::pair{"scan", scan},
+                                         std::pair{"step/snap", snapshots_step},
+                                         std::pair{"step/delta", deltas_step} })
+        std::cout << std::left << std::setw(12) << name << std::right
+                  << std::setw(14) << samples.mean() << std::setw(10) << 100 * samples.stddev() / samples.mean()
+                  << std::setw(12) << samples.best() << std::endl;
+    return 0;
+}
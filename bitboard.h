@@ -0,0 +1,92 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+// A set of board cells, one bit per cell: bit (row * 9 + column), so bit order
+// is row-major cell order, which is also the order Row, Column and Nonet walk
+// their cells in. Iterating a Bitboard therefore visits cells in exactly the
+// order a walk over the corresponding unit would have -- the property that lets
+// an analyzer trade a unit walk for a mask without changing what it records.
+//
+// 81 bits do not fit one machine word, so the set is two: cells 0..63 in the
+// low word, cells 64..80 in the low 17 bits of the high word. The bits above
+// cell 80 are always zero; operator~ is the only operation that could set them,
+// and it masks them off, so count() and equality never see them.
+class Bitboard {
+public:
+    static constexpr size_t kCells = 81;
+
+    constexpr Bitboard() = default;
+
+    static constexpr Bitboard all() { return Bitboard(~uint64_t(0), kHighMask); }
+    static constexpr Bitboard cell(size_t index) { Bitboard b; b.set(index); return b; }
+
+    constexpr bool test(size_t index) const {
+        assert(index < kCells);
+        return index < 64 ? (mLow >> index) & 1 : (mHigh >> (index - 64)) & 1;
+    }
+    constexpr void set(size_t index) {
+        assert(index < kCells);
+        if (index < 64) mLow  |= uint64_t(1) << index;
+        else            mHigh |= uint64_t(1) << (index - 64);
+    }
+    constexpr void reset(size_t index) {
+        assert(index < kCells);
+        if (index < 64) mLow  &= ~(uint64_t(1) << index);
+        else            mHigh &= ~(uint64_t(1) << (index - 64));
+    }
+
+    constexpr size_t count() const { return std::popcount(mLow) + std::popcount(mHigh); }
+    constexpr bool empty() const { return (mLow | mHigh) == 0; }
+    constexpr bool any() const { return !empty(); }
+
+    // The lowest cell in the set, which must not be empty.
+    constexpr size_t first() const {
+        assert(any());
+        return mLow ? std::countr_zero(mLow) : 64 + std::countr_zero(mHigh);
+    }
+
+    constexpr Bitboard operator&(const Bitboard &o) const { return Bitboard(mLow & o.mLow, mHigh & o.mHigh); }
+    constexpr Bitboard operator|(const Bitboard &o) const { return Bitboard(mLow | o.mLow, mHigh | o.mHigh); }
+    constexpr Bitboard operator^(const Bitboard &o) const { return Bitboard(mLow ^ o.mLow, mHigh ^ o.mHigh); }
+    constexpr Bitboard operator~() const { return Bitboard(~mLow, ~mHigh & kHighMask); }
+    constexpr Bitboard &operator&=(const Bitboard &o) { mLow &= o.mLow; mHigh &= o.mHigh; return *this; }
+    constexpr Bitboard &operator|=(const Bitboard &o) { mLow |= o.mLow; mHigh |= o.mHigh; return *this; }
+    constexpr bool operator==(const Bitboard &o) const = default;
+
+    // Walks the cell indices of the set in ascending order. It iterates a copy,
+    // so the set it came from can change under the loop without disturbing it.
+    class Iterator {
+    public:
+        constexpr Iterator(uint64_t low, uint64_t high) : mLow(low), mHigh(high) { }
+
+        constexpr size_t operator*() const {
+            return mLow ? std::countr_zero(mLow) : 64 + std::countr_zero(mHigh);
+        }
+        constexpr Iterator &operator++() {
+            if (mLow) mLow &= mLow - 1;
+            else      mHigh &= mHigh - 1;
+            return *this;
+        }
+        constexpr bool operator==(const Iterator &o) const = default;
+
+    private:
+        uint64_t mLow, mHigh;
+    };
+
+    constexpr Iterator begin() const { return Iterator(mLow, mHigh); }
+    constexpr Iterator end() const { return Iterator(0, 0); }
+
+private:
+    static constexpr uint64_t kHighMask = (uint64_t(1) << (kCells - 64)) - 1;
+
+    constexpr Bitboard(uint64_t low, uint64_t high) : mLow(low), mHigh(high) { }
+
+    uint64_t mLow = 0;    // cells 0..63
+    uint64_t mHigh = 0;   // cells 64..80, in bits 0..16
+};
@@ -12,21 +12,22 @@
 #include <cassert>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 
 namespace {
 // Reject a board where any digit repeats within a unit (row, column, or
 // nonet). The analyzers assume a logically consistent board; enforcing that
 // at load time keeps a contradictory board from ever reaching them.
 template <typename Subsets>
-void reject_duplicate_values(Subsets &subsets, const char *unit_kind) {
-    for (auto &subset : subsets) {
-        std::array<bool, static_cast<size_t>(kNine)> seen{};
+void reject_duplicate_values(const Subsets &subsets, const char *unit_kind) {
+    for (auto const &subset : subsets) {
+        std::array<bool, std::tuple_size_v<Subsets>> seen{};
         for (auto &cell : subset) {
             if (!cell.isValue()) continue;
             size_t i = static_cast<size_t>(cell.value()) - 1;   // 1..9 -> 0..8
             if (seen[i]) {
                 throw std::runtime_error(
-                    std::string("invalid board: value ") + std::to_string(cell.value())
+                    std::string("invalid board: value ") + symbol(cell.value())
                     + " appears more than once in a " + unit_kind);
             }
             seen[i] = true;
@@ -35,30 +36,50 @@ void reject_duplicate_values(Subsets &subsets, const char *unit_kind) {
 }
 } // namespace
 
+template<size_t Box>
 bool parse_rcv(const std::string &entry, size_t &row, size_t &col, Value &val) {
     if (entry.size() != 3) return false;
 
-    if (entry[0] < '1' || entry[0] > '9') return false;
-    if (entry[1] < '1' || entry[1] > '9') return false;
-    if (entry[2] < '1' || entry[2] > '9') return false;
+    const int r = symbol_digit(entry[0], Geometry<Box>::kSide);
+    const int c = symbol_digit(entry[1], Geometry<Box>::kSide);
+    const int v = symbol_digit(entry[2], Geometry<Box>::kSide);
+    if (!r || !c || !v) return false;
 
-    row = entry[0] - '1';
-    col = entry[1] - '1';
-    val = static_cast<Value>(entry[2] - '0');
+    row = r - 1;
+    col = c - 1;
+    val = static_cast<Value>(v);
     return true;
 }
 
-void Board::record_entry_form1(const std::string &entry) {
+template bool parse_rcv<3>(const std::string &, size_t &, size_t &, Value &);
+template bool parse_rcv<4>(const std::string &, size_t &, size_t &, Value &);
+template bool parse_rcv<5>(const std::string &, size_t &, size_t &, Value &);
+
+namespace {
+// The symbols a board of `side` digits takes, for an error message: "digits
+// 1-9" for 9x9, "1-G" or "1-P" for the larger sizes.
+std::string symbols_hint(size_t side) {
+    if (side == 9) return "digits 1-9";
+    std::string hint = "1-";
+    hint += kSymbols[side - 1];
+    return hint;
+}
+} // namespace
+
+template<size_t Box>
+void BasicBoard<Box>::record_entry_form1(const std::string &entry) {
     size_t row, col;
     Value val;
-    if (!parse_rcv(entry, row, col, val))
-        throw std::runtime_error("cannot parse entry \"" + entry + "\": expected 3 digits 1-9 (row, column, value)");
+    if (!parse_rcv<Box>(entry, row, col, val))
+        throw std::runtime_error("cannot parse entry \"" + entry + "\": expected 3 " + (Box == 3 ? "" : "symbols ")
+                                 + symbols_hint(width) + " (row, column, value)");
 
     if (!set_value_at(row, col, val))
         throw std::runtime_error("cell (" + std::to_string(row + 1) + "," + std::to_string(col + 1) + ") set more than once");
 }
 
-void Board::record_entries_form1(const std::string &entries) {
+template<size_t Box>
+void BasicBoard<Box>::record_entries_form1(const std::string &entries) {
     size_t ofsb = 0, ofse = 0;
     while (ofse != std::string::npos) {
         ofse = entries.find(';', ofsb);
@@ -68,53 +89,50 @@ void Board::record_entries_form1(const std::string &entries) {
     }
 }
 
-void Board::record_entries_form2(const std::string &entries) {
+template<size_t Box>
+void BasicBoard<Box>::record_entries_form2(const std::string &entries) {
     if (entries.size() != width * height)
         throw std::runtime_error("expected " + std::to_string(width * height) + " cells, got " + std::to_string(entries.size()));
 
     size_t index = 0;
     for (auto &c : mCells) {
-        switch (entries[index]) {
-        case '0':
-        case '.': // it's a note entry
-            break;
-
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9': // it's a value entry
+        const char entry = entries[index];
+        if (entry != '0' && entry != '.') { // it's a value entry
+            const int digit = symbol_digit(entry, width);
+            if (!digit) // don't know what to do with this
+                throw std::runtime_error(std::string("invalid character '") + entry + "' at position " + std::to_string(index + 1)
+                                         + " (use " + symbols_hint(width) + " or '.')");
+
             // Unlike form-1 (which can list the same cell twice), form-2 visits
             // every cell exactly once and each starts as a note, so set_value_at
             // cannot report an already-set cell here. Assert the invariant rather
             // than carry a throw that can never fire.
-            {
-                bool did_set = set_value_at(c.coord(), static_cast<Value>(entries[index] - '0'));
-                assert(did_set);
-                (void)did_set;
-            }
-            break;
-
-        default: // don't know what to do with this
-            throw std::runtime_error(std::string("invalid character '") + entries[index] + "' at position " + std::to_string(index + 1) + " (use digits 1-9 or '.')");
+            bool did_set = set_value_at(c.coord(), static_cast<Value>(digit));
+            assert(did_set);
+            (void)did_set;
         }
         index++;
     }
 }
 
-Board::Board(const std::string &board_desc)
-    : mNoteCellsCount(width * height)
-    , mNotesCount(mNoteCellsCount * kNine) {
-    for (size_t row = 0; row < height; row++) {
-        for (size_t col = 0; col < width; col++) {
-            mCells.push_back(Cell(row, col));
-        }
-    }
-    rebuild_subsets();
+namespace {
+// A fresh board's cells, each a note cell at its own coordinate. Built through
+// an index_sequence because Cell has no default constructor, so the array
+// cannot be filled after the fact.
+template<size_t Box, size_t... I>
+std::array<BasicCell<Box>, sizeof...(I)> initial_cells(std::index_sequence<I...>) {
+    return { BasicCell<Box>(I / Geometry<Box>::kSide, I % Geometry<Box>::kSide)... };
+}
+} // namespace
+
+template<size_t Box>
+BasicBoard<Box>::BasicBoard(const std::string &board_desc)
+    : mCells(initial_cells<Box>(std::make_index_sequence<width * height>{}))
+    , mNoteCellsCount(width * height)
+    , mNotesCount(mNoteCellsCount * G::kSide) {
+    // Every cell starts as a note holding every candidate.
+    mCandidates.fill(Cells::all());
+    for (auto &unit : mPositions) unit.fill(G::kAllDigits);
 
     // Reject an empty description before indexing board_desc[0] below.
     if (board_desc.empty()) throw std::runtime_error("no board provided");
@@ -129,69 +147,57 @@ Board::Board(const std::string &board_desc)
         break;
 
     default:
-        throw std::runtime_error("board must start with ';' (row,column,value form) or '.' (81-cell form)");
+        throw std::runtime_error("board must start with ';' (row,column,value form) or '.' ("
+                                 + std::to_string(G::kCells) + "-cell form)");
     }
 
-    reject_duplicate_values(mRows,    "row");
-    reject_duplicate_values(mColumns, "column");
-    reject_duplicate_values(mNonets,  "nonet");
+    // What the user reads calls a larger board's nonets boxes.
+    reject_duplicate_values(rows(),    "row");
+    reject_duplicate_values(columns(), "column");
+    reject_duplicate_values(nonets(),  Box == 3 ? "nonet" : "box");
 }
 
-Board::Board(const Board &other)
+template<size_t Box>
+BasicBoard<Box>::BasicBoard(const BasicBoard &other)
     : mCells(other.mCells)
     , mNoteCellsCount(other.mNoteCellsCount)
-    , mNotesCount(other.mNotesCount) {
-
-    rebuild_subsets();
-}
-
-void Board::rebuild_subsets() {
-    assert(mCells.size() == width * height);
-
-    mRows.clear();
-    mColumns.clear();
-    mNonets.clear();
-
-    for (size_t row = 0; row < height; row++) {
-        Row r(*this, row);
-        mRows.push_back(r);
-    }
-    assert(mRows.size() == height);
-
-    for (size_t col = 0; col < width; col++) {
-        Column c(*this, col);
-        mColumns.push_back(c);
-    }
-    assert(mColumns.size() == width);
-
-    for (size_t row = 0; row < height; row += Nonet::height) {
-        for (size_t col = 0; col < width; col += Nonet::width) {
-            Coord c(row, col);
-            Nonet n(*this, c);
-            mNonets.push_back(n);
-        }
+    , mNotesCount(other.mNotesCount)
+    , mCandidates(other.mCandidates)
+    , mSolved(other.mSolved)
+    , mBivalue(other.mBivalue)
+    , mPositions(other.mPositions)
+    , mStamp(other.mStamp)
+    , mCellStamps(other.mCellStamps) { }
+
+template<size_t Box>
+void BasicBoard<Box>::print(std::ostream &out) const {
+    size_t cnt = 1;
+    for (auto const &c : mCells) {
+        if (c.isValue()) out << c.value();
+        else             out << '.';
+        if (cnt++ % width == 0) out <<  " ";
     }
-    assert(mNonets.size() == (height / Nonet::height) * (width / Nonet::width));
+    out << std::endl;
 }
 
-void Board::print(std::ostream &out) const {
-    size_t cnt = 1;
+template<size_t Box>
+void BasicBoard<Box>::print_line(std::ostream &out) const {
     for (auto const &c : mCells) {
         if (c.isValue()) out << c.value();
         else             out << '.';
-        if (cnt++ % 9 == 0) out <<  " ";
     }
-    out << std::endl;
 }
 
 // Machine-readable candidate dump, one logical row per line. Each line is the
 // sentinel '~' followed by 9 whitespace-separated fields, one per cell in
-// column order. A solved cell's field is its digit; a note cell's field is the
-// concatenation of its remaining candidate digits (1-9, ascending). The
+// column order (16 or 25 on the larger boards). A solved cell's field is its
+// digit; a note cell's field is the concatenation of its remaining candidate
+// digits (1-9, ascending; the larger boards' symbols in the same order). The
 // sentinel keeps these lines distinct from the ASCII board, the 'p' grid, and
 // the analyzer summary, so test harnesses can grep them unambiguously. A cell
 // with no candidates left (a contradiction) prints an empty field as '-'.
-void Board::print_candidates(std::ostream &out) const {
+template<size_t Box>
+void BasicBoard<Box>::print_candidates(std::ostream &out) const {
     for (size_t row = 0; row < height; row++) {
         out << '~';
         for (size_t col = 0; col < width; col++) {
@@ -201,8 +207,8 @@ void Board::print_candidates(std::ostream &out) const {
                 out << c.value();
             } else {
                 bool any = false;
-                for (Value v : value_range()) {
-                    if (c.check(v)) { out << static_cast<int>(v); any = true; }
+                for (Value v : value_range<Box>()) {
+                    if (c.check(v)) { out << v; any = true; }
                 }
                 if (!any) out << '-';
             }
@@ -211,60 +217,147 @@ void Board::print_candidates(std::ostream &out) const {
     }
 }
 
-bool Board::clear_note_at(size_t row, size_t col, const Value &value) {
+template<size_t Box>
+bool BasicBoard<Box>::clear_note_at(size_t row, size_t col, const Value &value) {
     return clear_note_at(Coord(row, col), value);
 }
 
-bool Board::clear_note_at(const Coord &coord, const Value &value) {
+template<size_t Box>
+bool BasicBoard<Box>::clear_note_at(const Coord &coord, const Value &value) {
     auto &cell = at(coord);
 
     if (!cell.isNote()) return false;
     if (!cell.check(value)) return false;
 
+    const size_t index = G::index(coord);
+    if (mJournal) mJournal->push_back({ static_cast<typename G::Index>(index), static_cast<uint8_t>(value), false, {} });
+
     cell.set(value, false);
     mNotesCount--;
+    mCandidates[value - 1].reset(index);
+    set_position(index, value, false);
+    update_bivalue(index);
+    touch(index);
 
     return true;
 }
 
-bool Board::set_value_at(size_t row, size_t col, const Value &value) {
+template<size_t Box>
+bool BasicBoard<Box>::set_value_at(size_t row, size_t col, const Value &value) {
     return set_value_at(Coord(row, col), value);
 }
 
-template<class Set>
-void Board::clear_peer_notes(const Coord &coord, const Value &value, const Set &set) {
-    for (auto const &other_cell : set) {
-        // One gate, not two: Cell::check is isNote() && ..., so this already
-        // skips value cells as well as note cells that no longer hold `value`.
-        if (!other_cell.check(value)) continue;
-
-        if (sVerbose) std::cout << "  [FNv] " << other_cell.coord() << " x" << value
-                  << " " << tag(set.kind()) << "(" << coord << ")" << std::endl;
-        clear_note_at(other_cell.coord(), value);
+template<size_t Box>
+void BasicBoard<Box>::clear_peer_notes(const Coord &coord, const Value &value, Unit unit, const Cells &cells) {
+    // The placed cell left every candidate bitboard in set_value_at, so this is
+    // exactly the unit's peers still holding `value`: note cells only, as the
+    // bitboard holds no value cells. Ascending, which is the unit's walk order.
+    for (size_t index : mCandidates[value - 1] & cells) {
+        const Coord &other = mCells[index].coord();
+        if (sVerbose) narration() << "  [FNv] " << other << " x" << value
+                  << " " << tag(unit) << "(" << coord << ")" << std::endl;
+        clear_note_at(other, value);
     }
 }
 
-bool Board::set_value_at(const Coord &coord, const Value &value) {
+template<size_t Box>
+bool BasicBoard<Box>::set_value_at(const Coord &coord, const Value &value) {
     auto &cell = at(coord);
 
     if (!cell.isNote()) return false;
 
+    const size_t index = G::index(coord);
+    if (mJournal) mJournal->push_back({ static_cast<typename G::Index>(index), static_cast<uint8_t>(value), true, cell.notes() });
+
     mNotesCount -= cell.notes().count();
     mNoteCellsCount--;
+    for (auto const &v : cell.notes().values()) {
+        mCandidates[v - 1].reset(index);
+        set_position(index, v, false);
+    }
+    mSolved.set(index);
     cell.set(value);
+    update_bivalue(index);
+    touch(index);
 
     // Restore the peer invariant this placement just broke: no note cell may
     // hold a value placed in a cell it sees. Doing it here, at the one
     // chokepoint every placement passes through, is what keeps the board
     // self-consistent without the analyzer sweeping for it (see board.h).
-    clear_peer_notes(coord, value, nonet(coord));
-    clear_peer_notes(coord, value, column(coord));
-    clear_peer_notes(coord, value, row(coord));
+    const CellUnits &u = G::kCellUnits[index];
+    clear_peer_notes(coord, value, Unit::Nonet,  G::kNonets[u.nonet]);
+    clear_peer_notes(coord, value, Unit::Column, G::kColumns[u.column]);
+    clear_peer_notes(coord, value, Unit::Row,    G::kRows[u.row]);
 
     return true;
 }
 
-Cell &Board::at(size_t row, size_t col) {
+template<size_t Box>
+void BasicBoard<Box>::undo(std::vector<Change> &journal, size_t mark) {
+    assert(mark <= journal.size());
+
+    // Newest first, each change reversed by hand rather than through the
+    // mutators: they would journal the reversal, and set_value_at has no
+    // inverse to call. Either way the counts and bitboards move with the cell.
+    while (journal.size() > mark) {
+        const Change &change = journal.back();
+        Cell &cell = mCells[change.index];
+        const Value value = static_cast<Value>(change.value);
+
+        if (change.placement) {
+            assert(cell.isValue() && cell.value() == value);
+            cell.unset(change.notes);
+            mNoteCellsCount++;
+            mNotesCount += change.notes.count();
+            for (auto const &v : change.notes.values()) {
+                mCandidates[v - 1].set(change.index);
+                set_position(change.index, v, true);
+            }
+            mSolved.reset(change.index);
+        } else {
+            assert(cell.isNote() && !cell.check(value));
+            cell.set(value, true);
+            mNotesCount++;
+            mCandidates[value - 1].set(change.index);
+            set_position(change.index, value, true);
+        }
+        update_bivalue(change.index);
+        touch(change.index);
+
+        journal.pop_back();
+    }
+}
+
+template<size_t Box>
+void BasicBoard<Box>::set_position(size_t index, const Value &value, bool on) {
+    // The cell's bit in its row, in its column, and in its nonet.
+    const CellUnits &u = G::kCellUnits[index];
+    auto flip = [on](Mask &mask, size_t position) {
+        const Mask bit = static_cast<Mask>(Mask(1) << position);
+        mask = on ? (mask | bit) : (mask & ~bit);
+    };
+    flip(mPositions[u.row][value - 1],                    u.column);
+    flip(mPositions[G::kSide + u.column][value - 1],      u.row);
+    flip(mPositions[2 * G::kSide + u.nonet][value - 1],   u.nonet_position);
+}
+
+template<size_t Box>
+void BasicBoard<Box>::update_bivalue(size_t index) {
+    const Cell &cell = mCells[index];
+    if (cell.isNote() && cell.notes().count() == 2) mBivalue.set(index);
+    else                                             mBivalue.reset(index);
+}
+
+template<size_t Box>
+typename BasicBoard<Box>::Cells BasicBoard<Box>::changed_since(uint32_t stamp) const {
+    Cells changed;
+    for (size_t i = 0; i < mCellStamps.size(); ++i)
+        if (mCellStamps[i] > stamp) changed.set(i);
+    return changed;
+}
+
+template<size_t Box>
+typename BasicBoard<Box>::Cell &BasicBoard<Box>::at(size_t row, size_t col) {
     assert(row < height);
     assert(col < width);
 
@@ -273,7 +366,8 @@ Cell &Board::at(size_t row, size_t col) {
     return c;
 }
 
-const Cell &Board::at(size_t row, size_t col) const {
+template<size_t Box>
+const typename BasicBoard<Box>::Cell &BasicBoard<Box>::at(size_t row, size_t col) const {
     assert(row < height);
     assert(col < width);
 
@@ -282,42 +376,72 @@ const Cell &Board::at(size_t row, size_t col) const {
     return c;
 }
 
-const Row &Board::row(const Cell &c) const {
+template<size_t Box>
+BasicRow<Box> BasicBoard<Box>::row(const Cell &c) const {
     return row(c.coord());
 }
 
-const Column &Board::column(const Cell &c) const {
+template<size_t Box>
+BasicColumn<Box> BasicBoard<Box>::column(const Cell &c) const {
     return column(c.coord());
 }
 
-const Nonet &Board::nonet(const Cell &c) const {
+template<size_t Box>
+BasicNonet<Box> BasicBoard<Box>::nonet(const Cell &c) const {
     return nonet(c.coord());
 }
 
-const Row &Board::row(const Coord &coord) const {
-    return mRows.at(coord.row());
+template<size_t Box>
+BasicRow<Box> BasicBoard<Box>::row(const Coord &coord) const {
+    return Row(*this, coord.row());
 }
 
-const Column &Board::column(const Coord &coord) const {
-    return mColumns.at(coord.column());
+template<size_t Box>
+BasicColumn<Box> BasicBoard<Box>::column(const Coord &coord) const {
+    return Column(*this, coord.column());
 }
 
-const Nonet &Board::nonet(const Coord &coord) const {
-    size_t nonetRow = (coord.row() / 3) * 3;
-    size_t nonetCol = (coord.column() / 3) * 3;
+template<size_t Box>
+BasicNonet<Box> BasicBoard<Box>::nonet(const Coord &coord) const {
+    return Nonet(*this, coord);
+}
 
-    return mNonets.at(nonetRow + nonetCol / 3);
+template<size_t Box>
+std::array<BasicRow<Box>, BasicBoard<Box>::height> BasicBoard<Box>::rows() const {
+    std::array<Row, height> rows;
+    for (size_t i = 0; i < height; i++) rows[i] = Row(*this, i);
+    return rows;
 }
 
-std::optional<Unit> Board::see_each_other(const Coord &coord1, const Coord &coord2) const {
-    if      (row(coord1)    == row(coord2))    return Unit::Row;
-    else if (column(coord1) == column(coord2)) return Unit::Column;
-    else if (nonet(coord1)  == nonet(coord2))  return Unit::Nonet;
+template<size_t Box>
+std::array<BasicColumn<Box>, BasicBoard<Box>::width> BasicBoard<Box>::columns() const {
+    std::array<Column, width> columns;
+    for (size_t i = 0; i < width; i++) columns[i] = Column(*this, i);
+    return columns;
+}
+
+template<size_t Box>
+std::array<BasicNonet<Box>, Geometry<Box>::kSide> BasicBoard<Box>::nonets() const {
+    std::array<Nonet, G::kSide> nonets;
+    for (size_t i = 0; i < nonets.size(); i++)
+        nonets[i] = Nonet(*this, Coord((i / Box) * Nonet::height, (i % Box) * Nonet::width));
+    return nonets;
+}
+
+template<size_t Box>
+std::optional<Unit> BasicBoard<Box>::see_each_other(const Coord &coord1, const Coord &coord2) const {
+    const CellUnits &u1 = G::kCellUnits[G::index(coord1)];
+    const CellUnits &u2 = G::kCellUnits[G::index(coord2)];
+
+    if      (u1.row    == u2.row)    return Unit::Row;
+    else if (u1.column == u2.column) return Unit::Column;
+    else if (u1.nonet  == u2.nonet)  return Unit::Nonet;
 
     return std::nullopt;
 }
 
-std::optional<Unit> Board::any_see_each_other(const std::vector<Coord> &coords) const {
+template<size_t Box>
+std::optional<Unit> BasicBoard<Box>::any_see_each_other(const std::vector<Coord> &coords) const {
     for (size_t i = 0; i < coords.size(); ++i) {
         for (size_t j = i + 1; j < coords.size(); ++j) {
             if (auto unit = see_each_other(coords[i], coords[j])) {
@@ -329,22 +453,36 @@ std::optional<Unit> Board::any_see_each_other(const std::vector<Coord> &coords)
     return std::nullopt;
 }
 
-std::ostream& operator<<(std::ostream& outs, const Board &b) {
+template<size_t Box>
+std::ostream& operator<<(std::ostream& outs, const BasicBoard<Box> &b) {
+    // A rule: each cell's field, 2 * Box - 1 wide, closed by '+', and each
+    // nonet's run of them opened by one more, so nonets meet at a "++".
+    auto rule = [](char fill) {
+        std::string line;
+        for (size_t n = 0; n < Box; n++) {
+            line += '+';
+            for (size_t j = 0; j < Box; j++) {
+                line.append(2 * Box - 1, fill);
+                line += '+';
+            }
+        }
+        return line;
+    };
+    const std::string heavy = rule('='), light = rule('-');
+
     for (size_t i = 0; i < b.height; i++) {
-        outs << (i % 3 == 0 ? "+=====+=====+=====++=====+=====+=====++=====+=====+=====+"
-                            : "+-----+-----+-----++-----+-----+-----++-----+-----+-----+")
-             << std::endl;
-        for (auto l = 0; l < 3; l++) {
+        outs << (i % Box == 0 ? heavy : light) << std::endl;
+        for (size_t l = 0; l < Box; l++) {
             for (size_t j = 0; j < b.width; j++) {
-                const Cell &c = b.at(i, j);
-                outs << (j % 3 == 0 ? "[" : "|");
+                const BasicCell<Box> &c = b.at(i, j);
+                outs << (j % Box == 0 ? "[" : "|");
                 c.print_row(outs, l);
-                if (j % 3 == 2) outs << "]";
+                if (j % Box == Box - 1) outs << "]";
             }
             outs << std::endl;
         }
     }
-    outs << "+=====+=====+=====++=====+=====+=====++=====+=====+=====+";
+    outs << heavy;
     if (b.mNoteCellsCount != 0) {
         outs << std::endl
              << "Left to solve:   " << b.mNoteCellsCount << std::endl
@@ -353,3 +491,10 @@ std::ostream& operator<<(std::ostream& outs, const Board &b) {
 
     return outs;
 }
+
+template class BasicBoard<3>;
+template class BasicBoard<4>;
+template class BasicBoard<5>;
+template std::ostream &operator<<(std::ostream &, const BasicBoard<3> &);
+template std::ostream &operator<<(std::ostream &, const BasicBoard<4> &);
+template std::ostream &operator<<(std::ostream &, const BasicBoard<5> &);
@@ -2,19 +2,22 @@
 // See LICENSE for details of BSD 3-Clause License
 #pragma once
 
+#include "units.h"
 #include "cell.h"
 
+#include <array>
 #include <vector>
 #include <unordered_set>
 #include <iterator>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string_view>
 
-class Row;
-class Column;
-class Nonet;
+template<size_t Box> class BasicRow;
+template<size_t Box> class BasicColumn;
+template<size_t Box> class BasicNonet;
 
 // Identifies which kind of unit relates two cells that see each other.
 enum class Unit { Row, Column, Nonet };
@@ -33,24 +36,64 @@ constexpr std::string_view tag(Unit unit) {
 // zero-based row/column indices and a Value. Returns false (leaving the
 // out-parameters unspecified) if the entry is the wrong length or any field
 // is outside 1-9. Centralizes range validation so no caller feeds an
-// out-of-range index/value to the board.
+// out-of-range index/value to the board. For a larger board, each field is
+// one of its symbols instead (see kSymbols): 1-G for 16x16, 1-P for 25x25.
+template<size_t Box = 3>
 bool parse_rcv(const std::string &entry, size_t &row, size_t &col, Value &val);
 
 
-class Board {
+// One change a Board mutator made, as the undo log records it (see
+// Board::set_journal): the cell, and what it takes to put it back. An
+// elimination needs only the digit; a placement also needs the notes the cell
+// held, since placing cleared them. The peer eliminations a placement triggers
+// are logged after it as eliminations of their own, so replaying the log
+// backwards restores them before it un-places the cell.
+template<size_t Box>
+struct BasicBoardChange {
+    typename Geometry<Box>::Index index;    // Geometry::index() of the cell
+    uint8_t value;                          // the digit eliminated, or placed
+    bool placement;
+    BasicNotes<Box> notes;                  // placement only: the cell's notes before it
+};
+
+// A board of box size Box: 3 for the classic 9x9 board, 4 for 16x16, 5 for
+// 25x25 (see geometry.h). Every size is the same code, instantiated for each
+// in board.cpp, and the 9x9 names below -- Board, Cell, Row and the rest --
+// are the Box = 3 instances, which is all most of the code ever needs.
+template<size_t Box>
+class BasicBoard {
+    using G = Geometry<Box>;
+
 public:
-    Board(const std::string &board_desc);
+    using Cell = BasicCell<Box>;
+    using Notes = BasicNotes<Box>;
+    using Row = BasicRow<Box>;
+    using Column = BasicColumn<Box>;
+    using Nonet = BasicNonet<Box>;
+    using Change = BasicBoardChange<Box>;
+    // A set of cells (a Bitboard for 9x9), and a set of digits or positions.
+    using Cells = typename G::Cells;
+    using Mask = typename G::Notes;
+
+    BasicBoard(const std::string &board_desc);
 private:
     void record_entries_form1(const std::string &);
     void record_entry_form1(const std::string &);
     void record_entries_form2(const std::string &);
 public:
-    Board(const Board &other);
+    // A copy starts unjournaled (see set_journal). Assignment would have to pick
+    // between the two boards' journals, so there is none: the const coordinates
+    // of Cell already rule it out implicitly, and this says so where it counts.
+    BasicBoard(const BasicBoard &other);
+    BasicBoard &operator=(const BasicBoard &) = delete;
 
-    static const size_t width = 9;
-    static const size_t height = 9;
+    static const size_t width = G::kSide;
+    static const size_t height = G::kSide;
 
     void print(std::ostream &out) const;
+    // The same symbols/dots as print(), on one line with no separators and
+    // no trailing newline: the shape batch mode reads and writes.
+    void print_line(std::ostream &out) const;
     void print_candidates(std::ostream &out) const;
 
     bool clear_note_at(const Coord &, const Value &);
@@ -70,27 +113,32 @@ public:
     bool set_value_at(const Coord &, const Value &);
     bool set_value_at(size_t row, size_t col, const Value &);
 
-    const Row &row(const Cell &) const;
-    const Column &column(const Cell &) const;
-    const Nonet &nonet(const Cell &) const;
+    // The units, as views made on demand (see row.h): the board keeps none of
+    // them, so a copy of it has no units to rebuild. A view reads this board's
+    // cells and is good for as long as the board is.
+    Row row(const Cell &) const;
+    Column column(const Cell &) const;
+    Nonet nonet(const Cell &) const;
 
-    const Row &row(const Coord &) const;
-    const Column &column(const Coord &) const;
-    const Nonet &nonet(const Coord &) const;
+    Row row(const Coord &) const;
+    Column column(const Coord &) const;
+    Nonet nonet(const Coord &) const;
 
     // Const only, deliberately, and it is not the only door: Row, Column and
-    // Nonet each hold a Board & whose constness does not propagate, so their
-    // iterators would hand out a mutable Cell from a const Board if they were
-    // not themselves const. Both doors are shut, which is what makes the peer
+    // Nonet each read the cells through a pointer whose constness is theirs to
+    // keep, so their iterators could hand out a mutable Cell if they were not
+    // themselves const. Both doors are shut, which is what makes the peer
     // invariant above enforced rather than merely documented.
-    const std::vector<Cell> &cells() const { return mCells; }
+    const std::array<Cell, width * height> &cells() const { return mCells; }
 
-    const std::vector<Row> &rows() const { return mRows; }
-    const std::vector<Column> &columns() const { return mColumns; }
-    const std::vector<Nonet> &nonets() const { return mNonets; }
+    std::array<Row, height> rows() const;
+    std::array<Column, width> columns() const;
+    std::array<Nonet, G::kSide> nonets() const;
 
     // are these two coords in the same row, column or nonet? returns the shared
-    // unit kind, or nullopt if they do not see each other.
+    // unit kind, or nullopt if they do not see each other. Three compares of
+    // unit indices out of the geometry's kCellUnits; a caller that only needs
+    // the yes/no across many cells wants its kPeers masks instead.
     std::optional<Unit> see_each_other(const Coord &, const Coord &) const;
     bool see_each_other(const Cell &c1, const Cell &c2) const {
         return see_each_other(c1.coord(), c2.coord()).has_value();
@@ -100,36 +148,94 @@ public:
     // the first such pair found, or nullopt if none do.
     std::optional<Unit> any_see_each_other(const std::vector<Coord> &) const;
 
-    friend std::ostream& operator<< (std::ostream& outs, const Board &);
-    friend class Row;
-    friend class Column;
-    friend class Nonet;
+    template<size_t B>
+    friend std::ostream& operator<< (std::ostream& outs, const BasicBoard<B> &);
 
     size_t note_cells_count() const { return mNoteCellsCount; }
+    size_t notes_count() const { return mNotesCount; }
+
+    // The note cells still holding `value` as a candidate, and the value cells,
+    // as cell sets. Both are derived state, kept in step with the cells by the
+    // two mutators above -- clear_note_at clears one bit, set_value_at clears
+    // the placed cell from every digit's board and adds it to solved() -- so
+    // they are exact between calls and cost nothing to read. They turn the
+    // questions the unit-scanning analyzers ask ("how many cells of this row
+    // still hold a 7?", "do the 7s of this nonet all lie in one row?") into a
+    // mask AND and a popcount against the unit tables in geometry.h.
+    const Cells &candidates(const Value &value) const { return mCandidates[value - 1]; }
+    const Cells &solved() const { return mSolved; }
+
+    // Two more indexes of the same kind, for the techniques that start from
+    // two-of-something. bivalue() is the note cells holding exactly two
+    // candidates, the cells Y-Wing and XY-chain are built from. positions() is
+    // where `value` can still go in one unit -- numbered as the geometry's
+    // kUnitCells, rows then columns then nonets -- as a mask (9 bits on a 9x9
+    // board) whose bit k is that unit's k-th cell in the same table; two bits
+    // set is a conjugate pair, the strong link Simple Coloring walks. Both move with the cells in the two
+    // mutators and undo(), like candidates().
+    const Cells &bivalue() const { return mBivalue; }
+    Mask positions(size_t unit, const Value &value) const { return mPositions[unit][value - 1]; }
+
+    // The undo log. While a journal is set, clear_note_at and set_value_at
+    // append every change they make to it, and undo() replays the tail of it
+    // backwards, to the length `mark` it had when the changes to revert began.
+    // That is what lets a solver keep one board and step it back and forth,
+    // paying per change rather than per board copy. The journal belongs to the
+    // caller and is not copied with the board: a copy starts unjournaled, so it
+    // can never write into the log of the board it came from.
+    void set_journal(std::vector<Change> *journal) { mJournal = journal; }
+    void undo(std::vector<Change> &journal, size_t mark);
+
+    // Change stamps, for incremental analysis (see Analyzer::analyze). Every
+    // change to a cell -- a cleared note, a placement, an undone change --
+    // advances stamp() and stamps the cell with it, so changed_since(s) is the
+    // set of cells touched after stamp() read s. Copied with the board, like
+    // everything else a board knows about its cells.
+    uint32_t stamp() const { return mStamp; }
+    Cells changed_since(uint32_t stamp) const;
 
 private:
-    std::vector<Cell> mCells;
-    std::vector<Row> mRows;
-    std::vector<Column> mColumns;
-    std::vector<Nonet> mNonets;
+    // Everything a board knows is held by value, in fixed-size arrays, so a
+    // copy is one flat copy with nothing to allocate and nothing to re-point.
+    std::array<Cell, width * height> mCells;
 
     size_t mNoteCellsCount;
     size_t mNotesCount;
 
+    std::array<Cells, G::kSide> mCandidates;
+    Cells mSolved;
+    Cells mBivalue;
+    std::array<std::array<Mask, G::kSide>, G::kUnitCount> mPositions;
+
+    std::vector<Change> *mJournal = nullptr;
+
+    uint32_t mStamp = 0;
+    std::array<uint32_t, width * height> mCellStamps {};
+    void touch(size_t index) { mCellStamps[index] = ++mStamp; }
+
+    // Keep the indexes above in step with one cell: `value` gained or lost at
+    // `index`, or the cell's candidate count changed. Every change to a cell's
+    // notes goes through both.
+    void set_position(size_t index, const Value &value, bool on);
+    void update_bivalue(size_t index);
+
     Cell &at(size_t row, size_t col);
     const Cell &at(size_t row, size_t col) const;
     Cell &at(const Coord &coord) { return at(coord.row(), coord.column()); }
     const Cell &at(const Coord &coord) const { return at(coord.row(), coord.column()); }
 
     // Clear `value` from the note cells of one unit containing `coord`, which is
-    // the placed cell. Called once per unit by set_value_at; a template because
-    // Row, Column and Nonet share no base, only the shape the loop needs.
-    template<class Set>
-    void clear_peer_notes(const Coord &coord, const Value &value, const Set &set);
-
-    void rebuild_subsets();
+    // the placed cell; `cells` is that unit's mask and `unit` its kind, for the
+    // verbose trace. Called once per unit by set_value_at.
+    void clear_peer_notes(const Coord &coord, const Value &value, Unit unit, const Cells &cells);
 };
 
+using Board = BasicBoard<3>;
+using BoardChange = BasicBoardChange<3>;
+using Row = BasicRow<3>;
+using Column = BasicColumn<3>;
+using Nonet = BasicNonet<3>;
+
 #include "row.h"
 #include "column.h"
 #include "nonet.h"
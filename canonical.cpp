@@ -0,0 +1,209 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "canonical.h"
+#include "board.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
+
+namespace {
+
+// The 1296 orders of nine lines that keep each group of three together: the
+// group order (6) times the order within each group (6^3). Rows and columns
+// share the table. Entry ((g * 6 + a) * 6 + b) * 6 + c puts the groups in
+// kPermutations3[g] order, then orders the first, second and third of them by
+// kPermutations3[a], [b] and [c]; entry 0 is the identity.
+using Order = std::array<uint8_t, 9>;
+
+constexpr std::array<std::array<uint8_t, 3>, 6> kPermutations3 = {{
+    { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 },
+}};
+
+constexpr size_t kOrders = 6 * 6 * 6 * 6;
+
+constexpr std::array<Order, kOrders> kLineOrders = [] {
+    std::array<Order, kOrders> orders{};
+    size_t n = 0;
+    for (auto const &groups : kPermutations3)
+        for (auto const &first : kPermutations3)
+            for (auto const &second : kPermutations3)
+                for (auto const &third : kPermutations3) {
+                    const std::array<std::array<uint8_t, 3>, 3> within = { first, second, third };
+                    for (size_t g = 0; g < 3; ++g)
+                        for (size_t k = 0; k < 3; ++k)
+                            orders[n][g * 3 + k] = static_cast<uint8_t>(groups[g] * 3 + within[g][k]);
+                    ++n;
+                }
+    return orders;
+}();
+
+// The grid as digits, 0 for an empty cell, in both orientations.
+using Grid = std::array<std::array<uint8_t, 9>, 9>;
+
+// How many givens each stack of `row` holds, sorted ascending: the key the
+// least first row is chosen by (see canonicalize in canonical.h).
+std::array<uint8_t, 3> stack_counts(const std::array<uint8_t, 9> &row) {
+    std::array<uint8_t, 3> counts{};
+    for (size_t c = 0; c < 9; ++c) counts[c / 3] += row[c] != 0;
+    std::sort(counts.begin(), counts.end());
+    return counts;
+}
+
+// One way of laying out the canonical grid's first rows: the orientation, the
+// rows placed so far, the column order, and the labels those rows gave out.
+struct Partial {
+    uint8_t transpose;
+    uint8_t placed;      // rows placed so far
+    Order rows;          // the first `placed` are meaningful
+    const Order *columns;
+    std::array<uint8_t, 10> labels;
+    uint8_t next;        // the last label given out
+};
+
+// Lay out `row` of `grid` as canonical row `partial.placed` under the partial's
+// column order, relabeling as it goes, into `out`; `partial` becomes the
+// partial with that row placed.
+void place_row(const Grid &grid, size_t row, Partial &partial, std::array<uint8_t, 9> &out) {
+    for (size_t c = 0; c < 9; ++c) {
+        uint8_t v = grid[row][(*partial.columns)[c]];
+        if (v) {
+            if (!partial.labels[v]) partial.labels[v] = ++partial.next;
+            v = partial.labels[v];
+        }
+        out[c] = v;
+    }
+    partial.rows[partial.placed++] = static_cast<uint8_t>(row);
+}
+
+} // namespace anonymous
+
+std::string Symmetry::restore(const std::string &cells) const {
+    assert(cells.size() == 81);
+
+    std::array<char, 10> digits{};
+    digits[0] = '.';
+    for (size_t d = 1; d <= 9; ++d) digits[labels[d]] = static_cast<char>('0' + d);
+
+    std::string original(81, '.');
+    for (size_t r = 0; r < 9; ++r) {
+        for (size_t c = 0; c < 9; ++c) {
+            const char ch = cells[r * 9 + c];
+            const size_t label = ch == '.' ? 0 : ch - '0';
+            const size_t index = transpose ? columns[c] * 9 + rows[r] : rows[r] * 9 + columns[c];
+            original[index] = digits[label];
+        }
+    }
+    return original;
+}
+
+Canonical canonicalize(const Board &board) {
+    std::array<Grid, 2> grids{};
+    for (auto const &cell : board.cells()) {
+        if (!cell.isValue()) continue;
+        const size_t r = cell.coord().row(), c = cell.coord().column();
+        grids[0][r][c] = grids[1][c][r] = static_cast<uint8_t>(cell.value());
+    }
+
+    // The least first row over both orientations, by its stack counts.
+    std::array<uint8_t, 3> least = { 4, 4, 4 };
+    for (auto const &grid : grids)
+        for (auto const &row : grid)
+            least = std::min(least, stack_counts(row));
+
+    // Its pattern: per stack, in order of count, the empties then the givens.
+    std::array<bool, 9> pattern{};
+    for (size_t s = 0; s < 3; ++s)
+        for (size_t k = 3 - least[s]; k < 3; ++k) pattern[s * 3 + k] = true;
+
+    // Row 0: every (orientation, row, column order) that lays out the least
+    // pattern. Their first rows are all the same string, so all of them go on.
+    std::array<std::array<uint8_t, 9>, 9> best{};
+    std::vector<Partial> partials, survivors;
+    for (uint8_t t = 0; t < 2; ++t) {
+        const Grid &grid = grids[t];
+        for (size_t first = 0; first < 9; ++first) {
+            if (stack_counts(grid[first]) != least) continue;
+            // Built a stack at a time rather than by testing all 1296 orders:
+            // for each stack order, the orders within each stack that lay its
+            // three cells out as its part of the pattern.
+            for (size_t g = 0; g < 6; ++g) {
+                std::array<std::array<uint8_t, 6>, 3> within;
+                std::array<size_t, 3> count{};
+                for (size_t p = 0; p < 3; ++p) {
+                    const size_t stack = kPermutations3[g][p];
+                    for (uint8_t w = 0; w < 6; ++w) {
+                        bool match = true;
+                        for (size_t k = 0; k < 3 && match; ++k)
+                            match = (grid[first][stack * 3 + kPermutations3[w][k]] != 0) == pattern[p * 3 + k];
+                        if (match) within[p][count[p]++] = w;
+                    }
+                }
+
+                for (size_t a = 0; a < count[0]; ++a)
+                    for (size_t b = 0; b < count[1]; ++b)
+                        for (size_t c = 0; c < count[2]; ++c) {
+                            const Order &order = kLineOrders[((g * 6 + within[0][a]) * 6 + within[1][b]) * 6 + within[2][c]];
+                            Partial partial{ t, 0, {}, &order, {}, 0 };
+                            place_row(grid, first, partial, best[0]);
+                            partials.push_back(partial);
+                        }
+            }
+        }
+    }
+
+    // Rows 1..8, one at a time: every partial tries every row it may place
+    // next, and only those that lay out the least row go on. The canonical
+    // string is least row by row, so nothing dropped here could have won.
+    for (size_t r = 1; r < 9; ++r) {
+        survivors.clear();
+        bool found = false;
+        for (auto const &partial : partials) {
+            std::array<bool, 9> used{};
+            for (size_t i = 0; i < partial.placed; ++i) used[partial.rows[i]] = true;
+
+            // The next row comes from the current band, or -- on a band
+            // boundary -- from any band not yet started.
+            for (size_t row = 0; row < 9; ++row) {
+                if (used[row]) continue;
+                if (r % 3 != 0 && row / 3 != partial.rows[r - 1] / 3) continue;
+                if (r % 3 == 0 && (used[row / 3 * 3] || used[row / 3 * 3 + 1] || used[row / 3 * 3 + 2])) continue;
+
+                Partial next = partial;
+                std::array<uint8_t, 9> laid;
+                place_row(grids[partial.transpose], row, next, laid);
+                if (found && laid > best[r]) continue;
+                if (!found || laid < best[r]) {
+                    survivors.clear();
+                    best[r] = laid;
+                    found = true;
+                }
+                survivors.push_back(next);
+            }
+        }
+        std::swap(partials, survivors);
+    }
+    assert(!partials.empty());
+
+    // Every survivor lays out the same grid; the first one's symmetry will do.
+    // Digits the puzzle never gives still need a label for its solution to map
+    // back: the unused ones, in ascending order.
+    Partial &chosen = partials.front();
+    for (size_t d = 1; d <= 9; ++d)
+        if (!chosen.labels[d]) chosen.labels[d] = ++chosen.next;
+    assert(chosen.next == 9);
+
+    Canonical canonical;
+    canonical.cells.resize(81);
+    for (size_t i = 0; i < 81; ++i) {
+        const uint8_t v = best[i / 9][i % 9];
+        canonical.cells[i] = v ? static_cast<char>('0' + v) : '.';
+    }
+    canonical.symmetry.transpose = chosen.transpose == 1;
+    canonical.symmetry.rows = chosen.rows;
+    canonical.symmetry.columns = *chosen.columns;
+    canonical.symmetry.labels = chosen.labels;
+    return canonical;
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+template<size_t Box> class BasicBoard;
+using Board = BasicBoard<3>;
+
+// A validity-preserving symmetry of the 9x9 grid: an optional transpose, then
+// a permutation of the rows that keeps each band's rows together (bands in any
+// order, rows in any order within a band), the same for the columns and
+// stacks, and a relabeling of the digits. Any puzzle and its image under one
+// of these have the same solutions, mapped the same way.
+//
+// As a map to the canonical grid: canonical cell (r, c) holds
+// labels[d], where d is the digit of the original grid at (rows[r], columns[c]),
+// or at (columns[c], rows[r]) when transposed. labels[0] is 0, an empty cell.
+struct Symmetry {
+    bool transpose = false;
+    std::array<uint8_t, 9> rows = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+    std::array<uint8_t, 9> columns = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+    std::array<uint8_t, 10> labels = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+    // Map an 81-cell grid -- digits 1-9, '.' for an empty cell -- from the
+    // canonical orientation back to the original one: what turns the solution of
+    // the canonical puzzle into the solution of the puzzle it came from.
+    std::string restore(const std::string &cells) const;
+};
+
+// The canonical form of a puzzle: the lexicographically least 81-cell string
+// ('.' sorting first) over every symmetry above, each one's digits relabeled in
+// order of first appearance so that relabeling is folded into the geometry.
+// Two puzzles get the same `cells` exactly when one is a symmetry of the
+// other, which is what lets the form key a cache (see batch.h).
+struct Canonical {
+    std::string cells;
+    Symmetry symmetry;   // takes the puzzle to `cells`
+};
+
+// Only the board's placed values count: on a freshly loaded board, its givens.
+//
+// The search does not walk all 3,359,232 geometric symmetries. The least
+// string starts with the least first row, and since the relabeling makes every
+// given in it the next unused label, a first row's string is fixed by which of
+// its cells are empty. The least such pattern puts the stack with the fewest
+// givens first, and empties first within each stack, so a row's best is read
+// off its three stack counts. Only the (transpose, row) choices that reach the
+// overall best go on, each with the column orders that reach it, and from
+// there the grid is laid out a row at a time, keeping only the layouts whose
+// row is least. What survives a row is every layout that ties so far, so a
+// board with few givens, where much ties, is the slow case: an empty board
+// ties everything.
+Canonical canonicalize(const Board &);
@@ -5,51 +5,60 @@
 
 #include <cassert>
 
-void Cell::set(const Value &v) {
+std::ostream &operator<<(std::ostream &outs, const Value &v) {
+    return outs << symbol(v);
+}
+
+template<size_t Box>
+void BasicCell<Box>::set(const Value &v) {
     assert(isNote());
 
-    mNotes.clear();
-    mValue = v;
+    mNotes.mNotes = Notes::kPlaced | static_cast<typename Notes::Word>(v);
 }
 
-bool Notes::set(const Value &v, bool set) {
+template<size_t Box>
+bool BasicNotes<Box>::set(const Value &v, bool set) {
     bool note = check(v);
     if (set) mNotes |=  bit(v);
     else     mNotes &= ~bit(v);
     return note;
 }
 
-ValueList Notes::values() const {
+template<size_t Box>
+BasicValueList<Box> BasicNotes<Box>::values() const {
     // value_range() is ascending, so candidates come out ascending; see the
     // declaration for why that order is an enumeration contract, not a
     // set-comparison invariant.
-    ValueList v;
-    for (Value value : value_range()) {
+    BasicValueList<Box> v;
+    for (Value value : value_range<Box>()) {
         if (check(value)) v.push_back(value);
     }
     return v;
 }
 
-void Cell::print_row(std::ostream &outs, size_t row) const {
-    assert(row < 3);
+template<size_t Box>
+void BasicCell<Box>::print_row(std::ostream &outs, size_t row) const {
+    assert(row < Box);
     if (isNote()) {
-        // Row 0 -> candidates 1,2,3; row 1 -> 4,5,6; row 2 -> 7,8,9. The first
-        // two positions are "* " or "  "; the last is "*" or " " (no trailing
-        // space), for a 5-character field.
-        const Value v1 = static_cast<Value>(row * 3 + 1);
-        const Value v2 = static_cast<Value>(row * 3 + 2);
-        const Value v3 = static_cast<Value>(row * 3 + 3);
-        outs << (mNotes.check(v1) ? "* " : "  ")
-             << (mNotes.check(v2) ? "* " : "  ")
-             << (mNotes.check(v3) ? "*"  : " ");
+        // Row 0 -> candidates 1..Box, row 1 -> the next Box, and so on. Every
+        // position but the last is "* " or "  "; the last is "*" or " " (no
+        // trailing space), for a 2 * Box - 1 character field: five for 9x9.
+        for (size_t k = 0; k < Box; ++k) {
+            const Value v = static_cast<Value>(row * Box + k + 1);
+            outs << (mNotes.check(v) ? "*" : " ") << (k + 1 < Box ? " " : "");
+        }
     }
     else {
         // A solved cell shows its value centered on the middle line only.
-        if (row == 1) outs << "  " << *mValue << "  ";
-        else          outs << "     ";
+        const std::string pad(Box - 1, ' ');
+        if (row == Box / 2) outs << pad << value() << pad;
+        else                outs << std::string(2 * Box - 1, ' ');
     }
 }
 
-size_t std::hash<Cell>::operator()(const Cell &cell) const noexcept {
-    return std::hash<Coord>{}(cell.coord());
-}
+template class BasicNotes<3>;
+template class BasicNotes<4>;
+template class BasicNotes<5>;
+template class BasicCell<3>;
+template class BasicCell<4>;
+template class BasicCell<5>;
@@ -7,13 +7,17 @@
 #include <cassert>
 #include <bit>
 #include <cstdint>
+#include <limits>
 #include <optional>
 #include <string>
 #include <type_traits>
 #include <ranges>
 
 #include "coord.h"
+#include "geometry.h"
 
+// A digit. The 9x9 board's are kOne..kNine; the larger boards go on past them,
+// to 16 or 25, as plain values of the same type.
 enum Value: int {
     kOne = 1,
     kTwo,
@@ -26,23 +30,44 @@ enum Value: int {
     kNine
 };
 
-// Iterate the nine digit values kOne..kNine. The transform turns the integer
-// iota back into Value; iota's half-open [begin, end) is why the end is one
-// past kNine.
+// The symbols a board writes its digits in, 1 up: the digits, then letters for
+// the sizes with more than nine (A for 10, up to P for 25). A 9x9 board uses
+// the first nine, so its digits print as they always have.
+inline constexpr char kSymbols[] = "123456789ABCDEFGHIJKLMNOP";
+
+constexpr char symbol(const Value &v) { return kSymbols[v - 1]; }
+
+// The digit symbol `c` stands for on a board of `side` digits -- letters in
+// either case -- or 0 when it stands for none.
+constexpr int symbol_digit(char c, size_t side) {
+    if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+    for (size_t d = 0; d < side; ++d)
+        if (kSymbols[d] == c) return static_cast<int>(d + 1);
+    return 0;
+}
+
+// A value prints as its symbol.
+std::ostream &operator<<(std::ostream &outs, const Value &v);
+
+// Iterate the digit values of a board of box size Box, kOne up: kOne..kNine
+// for 9x9. The transform turns the integer iota back into Value; iota's
+// half-open [begin, end) is why the end is one past the last digit.
+template<size_t Box = 3>
 inline auto value_range() {
-    return std::views::iota(static_cast<int>(kOne), static_cast<int>(kNine) + 1)
+    return std::views::iota(static_cast<int>(kOne), static_cast<int>(Geometry<Box>::kSide) + 1)
          | std::views::transform([](int i) { return static_cast<Value>(i); });
 }
 
-class Cell;
+template<size_t Box> class BasicCell;
 
 // The candidates of a Notes, materialized inline with no heap allocation. A cell
-// holds at most nine candidates, so a fixed nine-slot array plus a count covers
-// every case while staying trivially copyable. It exposes exactly what the
-// analyzer call sites need: range iteration, indexing, and size. (Set equality
-// of two cells' candidates goes through Notes::operator== on the bitmask, so
-// ValueList itself needs no equality.)
-class ValueList {
+// holds at most one candidate per digit, so a fixed array of that many slots
+// plus a count covers every case while staying trivially copyable. It exposes
+// exactly what the analyzer call sites need: range iteration, indexing, and
+// size. (Set equality of two cells' candidates goes through Notes::operator==
+// on the bitmask, so ValueList itself needs no equality.)
+template<size_t Box>
+class BasicValueList {
 public:
     using const_iterator = const Value *;
 
@@ -57,77 +82,97 @@ public:
     const_iterator end() const { return mData.data() + mCount; }
 
 private:
-    std::array<Value, 9> mData {};
+    std::array<Value, Geometry<Box>::kSide> mData {};
     size_t mCount = 0;
 };
 
-// The nine candidate flags packed into a bitmask: bit (v - 1) is set when v is
-// still a candidate. A plain integer keeps Notes (and therefore Cell) trivially
+// The candidate flags packed into a bitmask: bit (v - 1) is set when v is still
+// a candidate. A plain integer keeps Notes (and therefore Cell) trivially
 // copyable, with no per-cell heap allocation.
-class Notes {
+template<size_t Box>
+class BasicNotes {
 public:
-    Notes()
-        : mNotes(kAllCandidates) { }
+    // The candidates as a mask: Geometry's one bit per digit, 16 bits for 9x9
+    // and 16x16, 32 for 25x25.
+    using Mask = typename Geometry<Box>::Notes;
+
+    BasicNotes()
+        : mNotes(Geometry<Box>::kAllDigits) { }
 
     void clear() { mNotes = 0; }
 
     bool check(const Value &v) const { return (mNotes & bit(v)) != 0; }
     bool set(const Value &v, bool set);
-    bool set_all(bool set) { mNotes = set ? kAllCandidates : 0; return true; }
+    bool set_all(bool set) { mNotes = set ? Geometry<Box>::kAllDigits : 0; return true; }
 
     // Two note sets are equal iff they hold the same candidates. The bitmask is
     // the canonical set representation, so this is one integer compare -- order-
     // blind and independent of how the candidates were set.
-    bool operator==(const Notes &other) const { return mNotes == other.mNotes; }
+    bool operator==(const BasicNotes &other) const { return mNotes == other.mNotes; }
 
     size_t count() const { return std::popcount(mNotes); }
 
+    // The candidates as the bitmask itself, bit (v - 1) for v: for a scan that
+    // combines many cells' sets with plain integer (or vector) operations.
+    Mask mask() const { return static_cast<Mask>(mNotes); }
+
     // Enumerate the candidates, ascending. The ascending order is an
-    // enumeration-order contract (stable board display; canonical NakedPair
+    // enumeration-order contract (stable board display; canonical subset
     // value tuples so dedup compares like with like), NOT a correctness
     // invariant for comparing two sets: candidate-set questions go through the
     // bitmask directly (operator==, shared_value, other_value), so no consumer's
     // correctness depends on the order here. Reserve values() for iteration.
-    ValueList values() const;
+    BasicValueList<Box> values() const;
 
     // For a two-candidate cell, the candidate that isn't v. Clearing v's bit
     // leaves a single bit standing; its position (0-based) is the value minus 1.
     Value other_value(const Value &v) const {
         assert(count() == 2);
         assert(check(v));
-        return static_cast<Value>(std::countr_zero<uint16_t>(mNotes & ~bit(v)) + 1);
+        return static_cast<Value>(std::countr_zero<Word>(mNotes & ~bit(v)) + 1);
     }
 
     // Whether the two sets share any candidate (non-empty intersection). Unlike
     // shared_value, zero shared candidates is a legal answer, not an assert.
-    bool intersects(const Notes &other) const { return (mNotes & other.mNotes) != 0; }
+    bool intersects(const BasicNotes &other) const { return (mNotes & other.mNotes) != 0; }
 
     // The single candidate this set shares with other. Mirror of other_value on
     // the intersection: AND the masks, require exactly one bit, read its value.
-    Value shared_value(const Notes &other) const {
-        uint16_t both = mNotes & other.mNotes;
+    Value shared_value(const BasicNotes &other) const {
+        Word both = mNotes & other.mNotes;
         assert(std::popcount(both) == 1);
-        return static_cast<Value>(std::countr_zero<uint16_t>(both) + 1);
+        return static_cast<Value>(std::countr_zero<Word>(both) + 1);
     }
 
 private:
-    static constexpr uint16_t bit(const Value &v) { return static_cast<uint16_t>(1u << (v - 1)); }
-    static constexpr uint16_t kAllCandidates = 0x1ffu; // bits 0..8 -> values 1..9
+    // The stored word: the mask, and above it room for kPlaced. Nine digits
+    // leave that room in 16 bits; sixteen fill them, so 16x16 takes 32 too.
+    using Word = std::conditional_t<(Geometry<Box>::kSide < 16), uint16_t, uint32_t>;
 
-    uint16_t mNotes;
+    static constexpr Word bit(const Value &v) { return static_cast<Word>(Word(1) << (v - 1)); }
+
+    // A value cell keeps its value in the same word, as kPlaced | value. No
+    // candidate set has that bit, so it tells the two apart, and notes() is
+    // never asked for on a value cell (it asserts), so the tag stays private.
+    static constexpr Word kPlaced = Word(1) << (std::numeric_limits<Word>::digits - 1);
+    friend class BasicCell<Box>;
+
+    Word mNotes;
 };
 
-class Cell {
+template<size_t Box>
+class BasicCell {
+    using Notes = BasicNotes<Box>;
+
 public:
-    Cell(size_t line, size_t column)
-        : mCoord(line, column)
-        , mValue(std::nullopt) { }
+    BasicCell(size_t line, size_t column)
+        : mCoord(line, column) { }
 
-    bool isNote() const { return !mValue.has_value(); }
-    bool isValue() const { return mValue.has_value(); }
+    bool isNote() const { return !(mNotes.mNotes & Notes::kPlaced); }
+    bool isValue() const { return mNotes.mNotes & Notes::kPlaced; }
 
     const Coord &coord() const { return mCoord; }
-    Value value() const { assert(isValue()); return *mValue; }
+    Value value() const { assert(isValue()); return static_cast<Value>(mNotes.mNotes & ~Notes::kPlaced); }
     Notes &notes() { assert(isNote()); return mNotes; }
     const Notes &notes() const { assert(isNote()); return mNotes; }
     Value other_value(const Value &value) const {
@@ -138,13 +183,16 @@ public:
     bool set(const Value &v, bool set) { return isNote() && mNotes.set(v, set); }
     bool set_all(bool set) { return isNote() && mNotes.set_all(set); }
     void set(const Value &v);
+    // The inverse of set(const Value &): a note cell again, holding `notes`.
+    // Only Board's undo log calls it, replaying a placement backwards.
+    void unset(const Notes &notes) { assert(isValue()); mNotes = notes; }
 
-    bool operator==(const Cell &other) const {
+    bool operator==(const BasicCell &other) const {
         return mCoord == other.mCoord;
     }
 
-    // Render one of the three display lines (row 0..2) of this cell's 3x3
-    // candidate grid into outs. The caller drives the three lines in sequence;
+    // Render one of the Box display lines (row 0..Box-1) of this cell's Box by
+    // Box candidate grid into outs. The caller drives the lines in sequence;
     // keeping the line index a parameter (rather than internal state) makes the
     // cell const-correct and the rendering reentrant.
     void print_row(std::ostream &outs, size_t row) const;
@@ -152,10 +200,19 @@ public:
 private:
     const Coord mCoord;
 
-    std::optional<Value> mValue;
+    // The candidates of a note cell, or the value of a value cell (see
+    // Notes::kPlaced): one word for both, so a 9x9 Cell is four bytes and the
+    // 81 of a board fit in six cache lines.
     Notes mNotes;
 };
 
+// The 9x9 board's, by the names all of its code uses.
+using ValueList = BasicValueList<3>;
+using Notes = BasicNotes<3>;
+using Cell = BasicCell<3>;
+
+static_assert(sizeof(Cell) == 4, "Cell is a packed Coord and one 16-bit word");
+
 // Copies of Cell happen in the analyzer's inner loop (candidates()) and in the
 // per-solve-step SolverState copy; keeping copy construction trivial means those
 // copies are a plain memcpy with no heap traffic. We assert *copy construction*
@@ -167,7 +224,9 @@ static_assert(std::is_trivially_copy_constructible_v<Cell>,
 static_assert(std::is_trivially_destructible_v<Cell>,
               "Cell must stay trivially destructible");
 
-template<>
-struct std::hash<Cell> {
-    std::size_t operator()(const Cell &cell) const noexcept;
+template<size_t Box>
+struct std::hash<BasicCell<Box>> {
+    std::size_t operator()(const BasicCell<Box> &cell) const noexcept {
+        return std::hash<Coord>{}(cell.coord());
+    }
 };
@@ -6,18 +6,21 @@
 #include "cell.h"
 
 #include <algorithm>
-#include <vector>
 #include <iterator>
 #include <cstddef>
 #include <cassert>
 
-class Column {
+// A view of one column of a board; see Row for what a unit view is.
+template<size_t Box>
+class BasicColumn {
+    using Board = BasicBoard<Box>;
+    using Cell = BasicCell<Box>;
+
 public:
-    Column(Board &board, size_t index)
-        : mBoard(board)
-        , mIndex(index)
-        , mCellStart(index) // line 0, column 'index'
-        , mCellSentinel(index + board.height * board.width) { }
+    BasicColumn() = default;
+    BasicColumn(const Board &board, size_t index)
+        : mCells(board.cells().data())
+        , mIndex(index) { assert(index < Board::width); }
 
     Unit kind() const { return Unit::Column; }
 
@@ -30,63 +33,46 @@ public:
         using pointer = const element_type *;
         using reference = const element_type&;
 
-        Iterator() { throw std::runtime_error("Not implemented"); }
-        Iterator(Board &board, size_t columnIndex)
-            : pCells(&board.mCells)
-            , mIndex(columnIndex)
-            , mStep(board.width) { }
+        Iterator() = default;
+        explicit Iterator(pointer cell)
+            : pCell(cell) { }
 
-        reference operator*() const { return pCells->at(mIndex); }
+        reference operator*() const { return *pCell; }
 
-        Iterator& operator++() { mIndex += mStep; return *this; }
+        Iterator& operator++() { pCell += Board::width; return *this; }
         Iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
 
-        bool operator==(const Iterator &other) const {
-            return pCells == other.pCells
-                && mIndex == other.mIndex;
-        }
+        bool operator==(const Iterator &other) const { return pCell == other.pCell; }
 
     private:
-        std::vector<Cell> *pCells;
-        size_t mIndex;
-        size_t mStep;
+        pointer pCell = nullptr;
     };
 
-    auto begin() { return Iterator(mBoard, mCellStart); }
-    auto end() { return Iterator(mBoard, mCellSentinel); }
+    Iterator begin() const { return Iterator(mCells + mIndex); }
+    Iterator end() const { return Iterator(mCells + mIndex + Board::height * Board::width); }
 
-    auto begin_at(const Cell &cell) {
+    Iterator begin_at(const Cell &cell) const {
         assert(cell.coord().column() == mIndex);
-        return Iterator(mBoard, cell.coord().row() * Board::width + mCellStart);
+        return Iterator(mCells + cell.coord().row() * Board::width + mIndex);
     }
 
-    auto begin() const { return Iterator(mBoard, mCellStart); }
-    auto end() const { return Iterator(mBoard, mCellSentinel); }
-
-    auto begin_at(const Cell &cell) const {
-        assert(cell.coord().column() == mIndex);
-        return Iterator(mBoard, cell.coord().row() * Board::width + mCellStart);
-    }
+    bool contains(const Cell &other) const { return other.coord().column() == mIndex; }
 
-    bool contains(const Cell &other) const {
-        return std::find(begin(), end(), other) != end();
+    bool operator==(const BasicColumn &other) const {
+        return mCells == other.mCells
+            && mIndex == other.mIndex;
     }
 
-    bool operator==(const Column &other) const {
-        return &mBoard == &other.mBoard
-             && mIndex == other.mIndex;
-    }
-
-    bool operator<(const Column &other) const {
-        assert(&mBoard == &other.mBoard);
+    bool operator<(const BasicColumn &other) const {
+        assert(mCells == other.mCells);
         return mIndex < other.mIndex;
     }
 
     size_t index() const { return mIndex; }
 
 private:
-    static_assert(std::forward_iterator<Iterator>);
-    Board &mBoard;
-    const size_t mIndex;
-    const size_t mCellStart, mCellSentinel;
+    const Cell *mCells = nullptr;
+    size_t mIndex = 0;
 };
+
+static_assert(std::forward_iterator<Column::Iterator>);
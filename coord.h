@@ -4,16 +4,23 @@
 
 #include <iostream>
 #include <functional>
+#include <cstdint>
 
 class Coord {
 public:
     Coord(size_t row, size_t column)
-        : mRow(row)
-        , mColumn(column) {}
+        : mRow(static_cast<uint8_t>(row))
+        , mColumn(static_cast<uint8_t>(column)) { }
 
     size_t row() const { return mRow; }
     size_t column() const { return mColumn; }
 
+    // Row-major position on the 9x9 board, 0..80: the cell's index in
+    // Board::cells() and its bit in a Bitboard.
+    size_t index() const { return mRow * 9 + mColumn; }
+    // The inverse: the coordinate of a cell index, or of a Bitboard bit.
+    static Coord of_index(size_t index) { return Coord(index / 9, index % 9); }
+
     bool operator==(const Coord &other) const {
         return mRow == other.mRow
             && mColumn == other.mColumn;
@@ -26,8 +33,10 @@ public:
         return mColumn < other.mColumn;
     }
 private:
-    size_t mRow;
-    size_t mColumn;
+    // A byte each: a coordinate is 0..8 (9 in a unit's end sentinel), and a
+    // Coord sits in every Cell.
+    uint8_t mRow;
+    uint8_t mColumn;
 };
 
 std::ostream& operator<< (std::ostream& outs, const Coord &);
@@ -0,0 +1,173 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "generate.h"
+#include "analyzer.h"
+#include "board.h"
+#include "canonical.h"
+#include "instrumentation.h"
+#include "search.h"
+#include "solver.h"
+#include "verbose.h"
+#include "workpool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// How many puzzles are made before the block is written; see batch.cpp's
+// kBlockSize. Smaller, since a puzzle takes hundreds of searches to make.
+const size_t kBlockSize = 256;
+
+using Rng = std::mt19937_64;
+
+// A uniform index below `n`, by plain modulo of the generator's 64-bit output.
+// The bias is below 2^-57 for the n used here. std::uniform_int_distribution and
+// std::shuffle would do as well, but each standard library picks its own
+// algorithm for them, and a seed should give the same puzzles on every
+// toolchain; mt19937_64 and seed_seq are specified to the bit.
+size_t below(Rng &rng, size_t n) { return rng() % n; }
+
+template<class T, size_t N>
+void shuffle(std::array<T, N> &items, Rng &rng) {
+    for (size_t n = N; n > 1; --n) std::swap(items[n - 1], items[below(rng, n)]);
+}
+
+// A random complete grid. Nonets 0, 4 and 8 share no row or column, so each is
+// an independent random permutation of the digits; the search completes the
+// other six. That leaves the grid a function of those three nonets, which is
+// some 10^16 grids -- plenty, and far cheaper than guessing the whole grid at
+// random.
+std::string random_grid(Rng &rng) {
+    std::string cells(81, '.');
+    for (size_t nonet : { 0, 4, 8 }) {
+        std::array<char, 9> digits = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+        shuffle(digits, rng);
+        for (size_t k = 0; k < 9; ++k)
+            cells[((nonet / 3) * 3 + k / 3) * 9 + (nonet % 3) * 3 + k % 3] = digits[k];
+    }
+
+    const SearchResult result = search_givens<3>(cells, 1);
+    assert(result.solutions == 1);
+    return result.solution;
+}
+
+// Blank the clues of `cells` in a random order, putting back each one whose
+// removal costs the puzzle its uniqueness. One pass is enough for a minimal
+// puzzle: blanking clues only ever adds solutions, so a clue the puzzle needed
+// when it was put back is needed still once more are gone.
+std::string remove_clues(std::string cells, Rng &rng) {
+    std::array<uint8_t, 81> order;
+    std::iota(order.begin(), order.end(), 0);
+    shuffle(order, rng);
+
+    for (size_t index : order) {
+        const char clue = cells[index];
+        cells[index] = '.';
+        if (search_givens<3>(cells, 2).solutions != 1) cells[index] = clue;
+    }
+    return cells;
+}
+
+// What the cascade applied solving `puzzle`, or nothing if it stalls on it. The
+// same silent solve as batch mode's, with an untimed SolveStats (see
+// instrumentation.h) to read the techniques off -- of the canonical form when
+// `canonical`, as --grade solves it, and of the puzzle as it is otherwise, as a
+// plain batch run does.
+std::optional<SolveStats> cascade_stats(const std::string &puzzle, bool canonical) {
+    thread_local std::ostream discard(nullptr);
+    set_narration(discard);
+
+    std::string desc = canonical ? canonicalize(Board("." + puzzle)).cells : puzzle;
+    desc.insert(desc.begin(), '.');
+    SolveStats stats(false);
+    set_stats_sink(&stats);
+    Solver solver(desc, History::Deltas);
+    solver.solve();
+    set_stats_sink(nullptr);
+
+    if (!solver.solved()) return std::nullopt;
+    return stats;
+}
+
+// Does a solve that applied what `stats` counts use every technique `options`
+// needs and none it rules out?
+bool uses_chosen_techniques(const SolveStats &stats, const GenerateOptions &options) {
+    for (size_t i : options.needs)   if (!stats[i].applies) return false;
+    for (size_t i : options.without) if (stats[i].applies)  return false;
+    return true;
+}
+
+// "needing FS without XY, SC": the techniques a run asked for, for a diagnostic.
+std::string describe_choice(const GenerateOptions &options) {
+    const auto &reg = Analyzer::registry();
+    auto tags = [&](const std::vector<size_t> &indexes) {
+        std::string text;
+        for (size_t i : indexes) {
+            if (!text.empty()) text += ", ";
+            text += reg[i]->name();
+        }
+        return text;
+    };
+    std::string text;
+    if (!options.needs.empty()) text += "needing " + tags(options.needs);
+    if (!options.needs.empty() && !options.without.empty()) text += ' ';
+    if (!options.without.empty()) text += "without " + tags(options.without);
+    return text.empty() ? "the techniques solve" : text;
+}
+
+// Puzzle `index` of the run: attempts drawn from its own generator until one
+// passes the cascade using the chosen techniques.
+// Nothing if `options.attempts` run out first, or once `give_up` is set: another
+// puzzle has run out, so the run is over.
+std::optional<std::string> generate_one(const GenerateOptions &options, size_t index,
+                                        const std::atomic<bool> &give_up) {
+    std::seed_seq seq = { uint32_t(options.seed), uint32_t(options.seed >> 32),
+                          uint32_t(index), uint32_t(uint64_t(index) >> 32) };
+    Rng rng(seq);
+
+    // Canonicalizing costs a quarter of an attempt, so only a choice pays it.
+    const bool chosen = !options.needs.empty() || !options.without.empty();
+    for (size_t attempt = 0; attempt < options.attempts && !give_up; ++attempt) {
+        std::string puzzle = remove_clues(random_grid(rng), rng);
+        const std::optional<SolveStats> stats = cascade_stats(puzzle, chosen);
+        if (stats && uses_chosen_techniques(*stats, options)) return puzzle;
+    }
+    return std::nullopt;
+}
+
+} // namespace anonymous
+
+int run_generate(std::ostream &out, const GenerateOptions &options) {
+    std::vector<std::optional<std::string>> puzzles;
+    std::atomic<bool> out_of_attempts = false;
+    for (size_t first = 0; first < options.count && !out_of_attempts; first += kBlockSize) {
+        puzzles.assign(std::min(kBlockSize, options.count - first), std::nullopt);
+        parallel_for(puzzles.size(), options.jobs, [&](size_t i) {
+            puzzles[i] = generate_one(options, first + i, out_of_attempts);
+            if (!puzzles[i]) out_of_attempts = true;
+        });
+        if (out_of_attempts) break;
+        for (auto const &puzzle : puzzles) out << *puzzle << '\n';
+    }
+    out.flush();
+
+    set_narration(std::cout);
+    if (out_of_attempts) {
+        std::cerr << "error: no puzzle " << describe_choice(options)
+                  << " in " << options.attempts << " attempts" << std::endl;
+        return 1;
+    }
+    return 0;
+}
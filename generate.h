@@ -0,0 +1,48 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// Generate mode: write `count` fresh puzzles to `out`, one per line in the
+// 81-cell form batch mode reads ('.' for an empty cell).
+//
+// Every puzzle has exactly one solution and is minimal: blanking any one of its
+// clues would give it a second. Each is made by filling a random valid grid,
+// then blanking clues in a random order, keeping every clue whose removal the
+// uniqueness check (search.h) rejects. The cascade then solves the result, as
+// batch mode would, and a puzzle it stalls on is thrown away and another made.
+//
+// `needs` and `without` choose the techniques, as registry indexes (see
+// Analyzer::registry()): the cascade must apply every technique in `needs` and
+// none in `without`. "Needs Finned Swordfish but not XY-Chain" is `needs` = {FS},
+// `without` = {XY}. Like a grade (see batch.h), this is judged on the puzzle's
+// canonical form, so it holds for every symmetry of the puzzle written. The
+// rarer the techniques asked for are on random minimal puzzles, the more
+// attempts each puzzle takes, and some (HQ, say) random minimal puzzles may
+// never need. So no puzzle gets more than `attempts`: one that runs out ends the
+// run, with nothing written of its block and a diagnostic naming the techniques
+// on stderr.
+//
+// The output depends on `seed` alone, not on `jobs`: puzzle i draws from its
+// own generator seeded with (seed, i), and the puzzles are written in index
+// order, a block at a time, like batch mode's results. Returns the process exit
+// status: 1 if a puzzle ran out of attempts.
+struct GenerateOptions {
+    // Enough for one in a few thousand puzzles to qualify -- about as rare as the
+    // rarest techniques that random minimal puzzles do reach -- at about 30 s per
+    // thread when nothing does.
+    static constexpr size_t kDefaultAttempts = 20000;
+
+    size_t count = 1;
+    uint64_t seed = 0;
+    size_t jobs = 1;
+    std::vector<size_t> needs;
+    std::vector<size_t> without;
+    size_t attempts = kDefaultAttempts;
+};
+
+int run_generate(std::ostream &out, const GenerateOptions &options);
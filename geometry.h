@@ -0,0 +1,242 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include "bitboard.h"
+#include "coord.h"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// The board's fixed geometry, for a board of any size, computed once at compile
+// time: which cells make up each unit, which units each cell belongs to, and
+// which cells each cell sees. None of it depends on a board's contents, so none
+// of it belongs in Board; these tables are what the peer and unit questions
+// reduce to.
+//
+// A board of box size B is B*B cells a side, in B*B nonets of B by B cells;
+// B = 3 is the classic 9x9 board, and 4 and 5 the 16x16 and 25x25 ones. (The
+// code calls a box a nonet at every size, after the 9x9 board's; only what the
+// user reads says "box" for the larger ones.) Cells are numbered row-major,
+// 0..kCells-1, and units by index within their kind: rows and columns
+// 0..kSide-1, nonets row-major, so nonet (row / B) * B + column / B.
+//
+// Each size gets its own types, chosen at compile time: the narrowest unsigned
+// type that holds one bit per digit (Notes), and per cell index (Index). A cell
+// set is a Bitboard for 9x9 and a CellSet below for the larger sizes.
+
+// A set of cells of a board of `Cells` cells, in as many 64-bit words as that
+// takes: the same interface as Bitboard, for the sizes Bitboard does not fit.
+// The bits past the last cell are always zero, as in Bitboard.
+template<size_t Cells>
+class CellSet {
+    static constexpr size_t kWords = (Cells + 63) / 64;
+    using Words = std::array<uint64_t, kWords>;
+    static constexpr uint64_t kTopMask = Cells % 64 ? (uint64_t(1) << (Cells % 64)) - 1 : ~uint64_t(0);
+
+public:
+    static constexpr size_t kCells = Cells;
+
+    constexpr CellSet() = default;
+
+    static constexpr CellSet all() {
+        CellSet s;
+        for (uint64_t &word : s.mWords) word = ~uint64_t(0);
+        s.mWords[kWords - 1] = kTopMask;
+        return s;
+    }
+    static constexpr CellSet cell(size_t index) { CellSet s; s.set(index); return s; }
+
+    constexpr bool test(size_t index) const {
+        assert(index < kCells);
+        return (mWords[index / 64] >> (index % 64)) & 1;
+    }
+    constexpr void set(size_t index) {
+        assert(index < kCells);
+        mWords[index / 64] |= uint64_t(1) << (index % 64);
+    }
+    constexpr void reset(size_t index) {
+        assert(index < kCells);
+        mWords[index / 64] &= ~(uint64_t(1) << (index % 64));
+    }
+
+    constexpr size_t count() const {
+        size_t n = 0;
+        for (uint64_t word : mWords) n += std::popcount(word);
+        return n;
+    }
+    constexpr bool empty() const {
+        for (uint64_t word : mWords) if (word) return false;
+        return true;
+    }
+    constexpr bool any() const { return !empty(); }
+
+    // The lowest cell in the set, which must not be empty.
+    constexpr size_t first() const {
+        assert(any());
+        size_t w = 0;
+        while (!mWords[w]) ++w;
+        return w * 64 + std::countr_zero(mWords[w]);
+    }
+
+    constexpr CellSet operator&(const CellSet &o) const { CellSet s = *this; return s &= o; }
+    constexpr CellSet operator|(const CellSet &o) const { CellSet s = *this; return s |= o; }
+    constexpr CellSet operator^(const CellSet &o) const {
+        CellSet s;
+        for (size_t w = 0; w < kWords; ++w) s.mWords[w] = mWords[w] ^ o.mWords[w];
+        return s;
+    }
+    constexpr CellSet operator~() const {
+        CellSet s;
+        for (size_t w = 0; w < kWords; ++w) s.mWords[w] = ~mWords[w];
+        s.mWords[kWords - 1] &= kTopMask;
+        return s;
+    }
+    constexpr CellSet &operator&=(const CellSet &o) {
+        for (size_t w = 0; w < kWords; ++w) mWords[w] &= o.mWords[w];
+        return *this;
+    }
+    constexpr CellSet &operator|=(const CellSet &o) {
+        for (size_t w = 0; w < kWords; ++w) mWords[w] |= o.mWords[w];
+        return *this;
+    }
+    constexpr bool operator==(const CellSet &o) const = default;
+
+    // Walks the cell indices of the set in ascending order. Like Bitboard's, it
+    // iterates a copy, so the set can change under the loop.
+    class Iterator {
+    public:
+        constexpr Iterator(const Words &words, size_t word) : mWords(words), mWord(word) { skip(); }
+
+        constexpr size_t operator*() const { return mWord * 64 + std::countr_zero(mWords[mWord]); }
+        constexpr Iterator &operator++() {
+            mWords[mWord] &= mWords[mWord] - 1;
+            skip();
+            return *this;
+        }
+        constexpr bool operator==(const Iterator &o) const { return mWord == o.mWord && mWords == o.mWords; }
+
+    private:
+        constexpr void skip() { while (mWord < kWords && !mWords[mWord]) ++mWord; }
+
+        Words mWords;
+        size_t mWord;
+    };
+
+    constexpr Iterator begin() const { return Iterator(mWords, 0); }
+    constexpr Iterator end() const { return Iterator(Words{}, kWords); }
+
+private:
+    Words mWords {};
+};
+
+// The three units of a cell, by index, and the cell's place in each: its
+// position in that unit's kUnitCells list. A row lists its cells by column and
+// a column by row, so only the nonet position is new information.
+struct CellUnits {
+    uint8_t row;
+    uint8_t column;
+    uint8_t nonet;
+    uint8_t nonet_position;
+};
+
+template<size_t Box>
+struct Geometry {
+    static_assert(Box >= 2 && Box <= 5, "boards from 4x4 to 25x25");
+
+    static constexpr size_t kBox = Box;
+    static constexpr size_t kSide = Box * Box;
+    static constexpr size_t kCells = kSide * kSide;
+    static constexpr size_t kUnitCount = 3 * kSide;
+    static constexpr size_t kPeerCount = 2 * (kSide - 1) + (Box - 1) * (Box - 1);
+
+    using Notes = std::conditional_t<(kSide <= 16), uint16_t, uint32_t>;
+    using Index = std::conditional_t<(kCells <= 256), uint8_t, uint16_t>;
+    using Cells = std::conditional_t<Box == 3, Bitboard, CellSet<kCells>>;
+
+    static constexpr Notes kAllDigits = static_cast<Notes>((uint64_t(1) << kSide) - 1);
+
+    static constexpr size_t nonet_index(size_t row, size_t column) { return (row / Box) * Box + column / Box; }
+
+    // A cell's row-major index, and back. (Coord::index() is the 9x9 one.)
+    static size_t index(const Coord &coord) { return coord.row() * kSide + coord.column(); }
+    static Coord coord(size_t index) { return Coord(index / kSide, index % kSide); }
+
+    // The cells of each row, column and nonet.
+    static constexpr std::array<Cells, kSide> kRows = [] {
+        std::array<Cells, kSide> rows{};
+        for (size_t i = 0; i < kCells; ++i) rows[i / kSide].set(i);
+        return rows;
+    }();
+
+    static constexpr std::array<Cells, kSide> kColumns = [] {
+        std::array<Cells, kSide> columns{};
+        for (size_t i = 0; i < kCells; ++i) columns[i % kSide].set(i);
+        return columns;
+    }();
+
+    static constexpr std::array<Cells, kSide> kNonets = [] {
+        std::array<Cells, kSide> nonets{};
+        for (size_t i = 0; i < kCells; ++i) nonets[nonet_index(i / kSide, i % kSide)].set(i);
+        return nonets;
+    }();
+
+    // The cells of every unit as lists, ascending: rows, then columns, then
+    // nonets -- for a loop that wants every unit the same way and the cells of
+    // each by index rather than as a mask.
+    static constexpr std::array<std::array<Index, kSide>, kUnitCount> kUnitCells = [] {
+        std::array<std::array<Index, kSide>, kUnitCount> lists{};
+        std::array<size_t, kUnitCount> filled{};
+        for (size_t i = 0; i < kCells; ++i) {
+            const size_t units[3] = { i / kSide, kSide + i % kSide, 2 * kSide + nonet_index(i / kSide, i % kSide) };
+            for (size_t u : units) lists[u][filled[u]++] = static_cast<Index>(i);
+        }
+        return lists;
+    }();
+
+    static constexpr std::array<CellUnits, kCells> kCellUnits = [] {
+        std::array<CellUnits, kCells> cell_units{};
+        for (size_t i = 0; i < kCells; ++i) {
+            const size_t row = i / kSide, column = i % kSide;
+            cell_units[i] = { static_cast<uint8_t>(row), static_cast<uint8_t>(column),
+                              static_cast<uint8_t>(nonet_index(row, column)),
+                              static_cast<uint8_t>(row % Box * Box + column % Box) };
+        }
+        return cell_units;
+    }();
+
+    // The peers of each cell -- the other cells sharing its row, column or
+    // nonet -- as a set, and as a list in ascending cell order. A cell is not
+    // its own peer.
+    static constexpr std::array<Cells, kCells> kPeers = [] {
+        std::array<Cells, kCells> peers{};
+        for (size_t i = 0; i < kCells; ++i) {
+            const CellUnits &u = kCellUnits[i];
+            peers[i] = kRows[u.row] | kColumns[u.column] | kNonets[u.nonet];
+            peers[i].reset(i);
+        }
+        return peers;
+    }();
+
+    static constexpr std::array<std::array<Index, kPeerCount>, kCells> kPeerList = [] {
+        std::array<std::array<Index, kPeerCount>, kCells> lists{};
+        for (size_t i = 0; i < kCells; ++i) {
+            size_t n = 0;
+            for (size_t peer : kPeers[i]) lists[i][n++] = static_cast<Index>(peer);
+        }
+        return lists;
+    }();
+
+    // The cells `a` and `b` both see: the candidates for an elimination that
+    // needs to see two cells at once.
+    static constexpr Cells common_peers(size_t a, size_t b) { return kPeers[a] & kPeers[b]; }
+};
+
+static_assert([] {
+    for (auto const &peers : Geometry<3>::kPeers) if (peers.count() != Geometry<3>::kPeerCount) return false;
+    return true;
+}(), "every cell of a 9x9 board has exactly 20 peers");
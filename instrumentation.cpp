@@ -0,0 +1,131 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "instrumentation.h"
+#include "analyzer.h"
+
+#include <cassert>
+#include <iomanip>
+#include <ostream>
+
+namespace {
+thread_local SolveStats *sStats = nullptr;
+
+double ms(uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+// The weight of one application of registry technique `i` (see print_grade).
+uint64_t weight(size_t i) {
+    const auto &reg = Analyzer::registry();
+    if (reg[i]->tier() == Tier::Single) return 1;
+
+    size_t singles = 0;
+    while (reg[singles]->tier() == Tier::Single) ++singles;
+    assert(i >= singles);   // the cascade runs every Single before any Advanced
+    return 10 * (i - singles + 1);
+}
+} // namespace
+
+SolveStats *stats_sink() {
+    return sStats;
+}
+
+void set_stats_sink(SolveStats *stats) {
+    sStats = stats;
+}
+
+TechniqueStats &TechniqueStats::operator+=(const TechniqueStats &other) {
+    finds        += other.finds;
+    hits         += other.hits;
+    skips        += other.skips;
+    applies      += other.applies;
+    placements   += other.placements;
+    eliminations += other.eliminations;
+    find_ns      += other.find_ns;
+    apply_ns     += other.apply_ns;
+    return *this;
+}
+
+SolveStats::SolveStats(bool timed) : mTechniques(Analyzer::registry().size()), mTimed(timed) { }
+
+SolveStats &SolveStats::operator+=(const SolveStats &other) {
+    assert(mTechniques.size() == other.mTechniques.size());
+    for (size_t i = 0; i < mTechniques.size(); ++i) mTechniques[i] += other.mTechniques[i];
+    mBoards += other.mBoards;
+    mReused += other.mReused;
+    return *this;
+}
+
+void SolveStats::print_table(std::ostream &outs) const {
+    const auto &reg = Analyzer::registry();
+    TechniqueStats total;
+    for (auto const &t : mTechniques) total += t;
+    const uint64_t total_ns = total.find_ns + total.apply_ns;
+
+    auto row = [&](const char *name, const TechniqueStats &stats) {
+        const uint64_t ns = stats.find_ns + stats.apply_ns;
+        outs << std::left << std::setw(6) << name << std::right
+             << std::setw(10) << stats.finds
+             << std::setw(10) << stats.hits
+             << std::setw(10) << stats.skips
+             << std::setw(10) << stats.applies
+             << std::setw(10) << stats.placements
+             << std::setw(10) << stats.eliminations
+             << std::fixed << std::setprecision(3)
+             << std::setw(12) << ms(stats.find_ns)
+             << std::setw(12) << ms(stats.apply_ns)
+             << std::setw(10) << (stats.finds ? stats.find_ns / stats.finds : 0)
+             << std::setprecision(1)
+             << std::setw(8) << (total_ns ? 100.0 * ns / total_ns : 0.0)
+             << std::endl;
+    };
+
+    outs << "Technique statistics over " << mBoards << " board(s)";
+    if (mReused) outs << ", " << mReused << " of them answered from the cache or store";
+    outs << ":" << std::endl
+         << std::left << std::setw(6) << "tech" << std::right
+         << std::setw(10) << "finds" << std::setw(10) << "hits" << std::setw(10) << "skipped"
+         << std::setw(10) << "applies"
+         << std::setw(10) << "placed" << std::setw(10) << "elims"
+         << std::setw(12) << "find ms" << std::setw(12) << "apply ms"
+         << std::setw(10) << "ns/find" << std::setw(8) << "time%" << std::endl;
+    for (size_t i = 0; i < mTechniques.size(); ++i) row(reg[i]->name(), mTechniques[i]);
+    row("total", total);
+}
+
+void SolveStats::print_json(std::ostream &outs) const {
+    const auto &reg = Analyzer::registry();
+    outs << "{\"boards\": " << mBoards << ", \"reused\": " << mReused << ", \"techniques\": [";
+    for (size_t i = 0; i < mTechniques.size(); ++i) {
+        const TechniqueStats &t = mTechniques[i];
+        outs << (i ? ", " : "")
+             << "{\"name\": \"" << reg[i]->name() << "\""
+             << ", \"finds\": " << t.finds
+             << ", \"hits\": " << t.hits
+             << ", \"skips\": " << t.skips
+             << ", \"applies\": " << t.applies
+             << ", \"placements\": " << t.placements
+             << ", \"eliminations\": " << t.eliminations
+             << ", \"find_ns\": " << t.find_ns
+             << ", \"apply_ns\": " << t.apply_ns << "}";
+    }
+    outs << "]}" << std::endl;
+}
+
+std::optional<size_t> SolveStats::hardest() const {
+    for (size_t i = mTechniques.size(); i-- > 0; )
+        if (mTechniques[i].applies) return i;
+    return std::nullopt;
+}
+
+void SolveStats::print_grade(std::ostream &outs) const {
+    const std::optional<size_t> last = hardest();
+    if (!last) return;
+
+    const auto &reg = Analyzer::registry();
+    uint64_t score = 0;
+    for (size_t i = 0; i < mTechniques.size(); ++i) score += mTechniques[i].applies * weight(i);
+
+    outs << " grade: " << score << ' ' << reg[*last]->name();
+    for (size_t i = 0; i < mTechniques.size(); ++i)
+        if (mTechniques[i].applies) outs << ' ' << reg[i]->name() << ':' << mTechniques[i].applies;
+}
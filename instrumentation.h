@@ -0,0 +1,81 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+// What one technique cost and bought over a run. Analyzer records into these
+// from its registry loops, so a technique is counted whether it was reached by
+// analyze() or act(), and never when the cascade stopped before it.
+struct TechniqueStats {
+    uint64_t finds = 0;         // find() calls, full or incremental
+    uint64_t hits = 0;          // ... of which recorded a finding
+    uint64_t skips = 0;         // ... of which may_fire() answered without a search
+    uint64_t applies = 0;       // apply() calls that changed the board
+    uint64_t placements = 0;    // values those applies placed
+    uint64_t eliminations = 0;  // candidates they removed, a placement's own included
+    uint64_t find_ns = 0;
+    uint64_t apply_ns = 0;
+
+    TechniqueStats &operator+=(const TechniqueStats &other);
+};
+
+// One TechniqueStats per Analyzer::registry() entry, indexed like it, plus the
+// number of boards they were gathered over. A board batch mode answers from its
+// cache or store is counted too, as reused: the run saw it, but no technique
+// ran on it, so the techniques' counts cover the others only.
+class SolveStats {
+public:
+    // An untimed SolveStats counts but leaves the find_ns and apply_ns columns at
+    // zero, sparing the two clock reads per find() and apply() a caller that only
+    // wants the counts -- a per-board grade -- would otherwise pay.
+    explicit SolveStats(bool timed = true);
+
+    bool timed() const { return mTimed; }
+
+    TechniqueStats &operator[](size_t i) { return mTechniques.at(i); }
+    const TechniqueStats &operator[](size_t i) const { return mTechniques.at(i); }
+    size_t size() const { return mTechniques.size(); }
+
+    void add_board() { ++mBoards; }
+    void add_reused_board() { ++mBoards; ++mReused; }
+    size_t boards() const { return mBoards; }
+    size_t reused() const { return mReused; }
+
+    SolveStats &operator+=(const SolveStats &other);
+
+    // A fixed-width table, one row per technique in cascade order and a total,
+    // for a person; and the same numbers as one JSON object, for a script.
+    void print_table(std::ostream &outs) const;
+    void print_json(std::ostream &outs) const;
+
+    // The difficulty of what was solved, as " grade: <score> <hardest> <tag>:<n>
+    // ...": every technique that changed the board, in cascade order, with how
+    // many times it did, the last of them as the hardest, and a score summing
+    // each application's weight. A Single technique weighs 1, and an Advanced
+    // one 10 per place it sits past the singles in the cascade, so NP weighs 10
+    // and XY 160: the cascade's order is its own difficulty ranking, cheapest
+    // first. Meant for one board's stats; nothing is written if nothing fired.
+    void print_grade(std::ostream &outs) const;
+
+    // The registry index of that hardest technique: the last in cascade order
+    // to change the board. Empty if none did.
+    std::optional<size_t> hardest() const;
+
+private:
+    std::vector<TechniqueStats> mTechniques;
+    size_t mBoards = 0;
+    size_t mReused = 0;
+    bool mTimed;
+};
+
+// Where the calling thread's Analyzers record: nullptr, the default, records
+// nothing and costs one thread_local load per find() or apply(). Per thread
+// like the narration stream (see verbose.h), so pool workers each fill their
+// own SolveStats, and whoever owns them adds them up.
+SolveStats *stats_sink();
+void set_stats_sink(SolveStats *stats);
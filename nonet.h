@@ -4,22 +4,31 @@
 
 #include "board.h"
 #include "cell.h"
+#include "geometry.h"
 
 #include <algorithm>
-#include <vector>
 #include <iterator>
 #include <cstddef>
+#include <array>
+#include <cstdint>
+
+// A view of one nonet of a board; see Row for what a unit view is. It walks its
+// cells in row-major order, off the nonet's row of the geometry's kUnitCells.
+template<size_t Box>
+class BasicNonet {
+    using G = Geometry<Box>;
+    using Board = BasicBoard<Box>;
+    using Cell = BasicCell<Box>;
+    using Index = typename G::Index;
 
-class Nonet {
 public:
-    static const size_t width = 3;
-    static const size_t height = 3;
+    static const size_t width = Box;
+    static const size_t height = Box;
 
-    Nonet(Board &board, const Coord &coord)
-        : mBoard(board)
-        , mCoord((coord.row()    / height) * height,
-                 (coord.column() / width)  * width)
-        , mSentinel(mCoord.row() + height, mCoord.column()) { }
+    BasicNonet() = default;
+    BasicNonet(const Board &board, const Coord &coord)
+        : mCells(board.cells().data())
+        , mIndex(G::nonet_index(coord.row(), coord.column())) { }
 
     Unit kind() const { return Unit::Nonet; }
 
@@ -32,65 +41,44 @@ public:
         using pointer = const element_type *;
         using reference = const element_type&;
 
-        Iterator()
-            : mIndex(0, 0) { throw std::runtime_error("Not implemented"); }
-        Iterator(Board &board, const Coord &origin)
-            : pCells(&board.mCells)
-            , mWidth(board.width)
-            , mIndex(origin) { }
-        Iterator(const Iterator &other, const Coord &index)
-            : pCells(other.pCells)
-            , mWidth(other.mWidth)
-            , mIndex(index) { }
-
-        reference operator*() const { return pCells->at(mIndex.row() * mWidth + mIndex.column()); }
+        Iterator() = default;
+        Iterator(const Cell *cells, const Index *index)
+            : pCells(cells)
+            , pIndex(index) { }
+
+        reference operator*() const { return pCells[*pIndex]; }
         pointer operator->() const { return &**this; }
 
-        Iterator& operator++() {
-            size_t row = mIndex.row();
-            size_t col = mIndex.column() + 1;
-            if (col % width == 0) {
-                row += 1;
-                col -= width;
-            }
-            mIndex = Coord(row, col);
-            return *this;
-        }
+        Iterator& operator++() { ++pIndex; return *this; }
         Iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
 
         bool operator==(const Iterator &other) const {
             return pCells == other.pCells
-                && mIndex == other.mIndex;
-        }
-
-        bool operator!=(const Iterator &other) const {
-            return pCells != other.pCells
-                || mIndex != other.mIndex;
+                && pIndex == other.pIndex;
         }
 
     private:
-        std::vector<Cell> *pCells;
-        size_t mWidth;
-        Coord mIndex;
+        const Cell *pCells = nullptr;
+        const Index *pIndex = nullptr;
     };
 
-    auto begin() { return Iterator(mBoard, mCoord); }
-    auto end() { return Iterator(mBoard, mSentinel); }
+    Iterator begin() const { return Iterator(mCells, cells().data()); }
+    Iterator end() const { return Iterator(mCells, cells().data() + cells().size()); }
 
-    auto begin() const { return Iterator(mBoard, mCoord); }
-    auto end() const { return Iterator(mBoard, mSentinel); }
-
-    bool operator==(const Nonet &other) const {
-        return &mBoard == &other.mBoard
-             && mCoord == other.mCoord;
+    bool operator==(const BasicNonet &other) const {
+        return mCells == other.mCells
+            && mIndex == other.mIndex;
     }
 
     bool contains(const Cell &other) const {
-        return std::find(begin(), end(), other) != end();
+        return G::nonet_index(other.coord().row(), other.coord().column()) == mIndex;
     }
 
 private:
-    static_assert(std::forward_iterator<Iterator>);
-    Board &mBoard;
-    const Coord mCoord, mSentinel;
+    const std::array<Index, G::kSide> &cells() const { return G::kUnitCells[2 * Board::width + mIndex]; }
+
+    const Cell *mCells = nullptr;
+    size_t mIndex = 0;
 };
+
+static_assert(std::forward_iterator<Nonet::Iterator>);
@@ -6,90 +6,60 @@
 #include "cell.h"
 
 #include <algorithm>
-#include <vector>
 #include <iterator>
 #include <cstddef>
 #include <cassert>
 
-class Row {
+// A view of one row of a board: the board's cells and the row's index, nothing
+// else. Board makes one on demand (Board::row, Board::rows) rather than keeping
+// them, so copying a board copies no units and fixes up no references. Like
+// every unit view, it is only good while the board it came from is, and it
+// reads that board's cells live.
+template<size_t Box>
+class BasicRow {
+    using Board = BasicBoard<Box>;
+    using Cell = BasicCell<Box>;
+
 public:
-    Row(Board &board, size_t index)
-        : mBoard(board)
-        , mIndex(index)
-        , mCellStart(index * board.width)
-        , mCellSentinel(index * board.width + board.width) { }
+    // An empty view, for arrays of views filled after the fact (see
+    // Board::rows). It has no cells to walk.
+    BasicRow() = default;
+    BasicRow(const Board &board, size_t index)
+        : mCells(board.cells().data())
+        , mIndex(index) { assert(index < Board::height); }
 
     Unit kind() const { return Unit::Row; }
 
-    class Iterator {
-    public:
-        using difference_type = std::ptrdiff_t;
-        using element_type = Cell;
-        // Const on purpose: a unit hands out a read-only view of its cells, so
-        // Board's own mutators stay the only route to a change (see board.h).
-        using pointer = const element_type *;
-        using reference = const element_type&;
-
-        Iterator() { throw std::runtime_error("Not implemented"); }
-        Iterator(const Row &row, Board &board, size_t start)
-            : mRow(&row)
-            , pCells(&board.mCells)
-            , mIndex(start) {
-            assert(mRow->mCellStart <= mIndex);
-            assert(mIndex <= mRow->mCellSentinel);
-        }
-
-        reference operator*() const { return pCells->at(mIndex); }
-
-        Iterator& operator++() { mIndex++; assert(mIndex <= mRow->mCellSentinel); return *this; }
-        Iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
-
-        bool operator==(const Iterator &other) const {
-            return pCells == other.pCells
-                && mIndex == other.mIndex;
-        }
-
-    private:
-        const Row *mRow;
-        std::vector<Cell> *pCells;
-        size_t mIndex;
-    };
+    // A row's cells are contiguous, so its iterator is a plain pointer. Const
+    // on purpose: a unit hands out a read-only view of its cells, so Board's own
+    // mutators stay the only route to a change (see board.h).
+    using Iterator = const Cell *;
 
-    auto begin() { return Iterator(*this, mBoard, mCellStart); }
-    auto end() { return Iterator(*this, mBoard, mCellSentinel); }
+    Iterator begin() const { return mCells + mIndex * Board::width; }
+    Iterator end() const { return begin() + Board::width; }
 
-    auto begin_at(const Cell &cell) {
+    Iterator begin_at(const Cell &cell) const {
         assert(cell.coord().row() == mIndex);
-        return Iterator(*this, mBoard, mCellStart + cell.coord().column());
+        return begin() + cell.coord().column();
     }
 
-    auto begin() const { return Iterator(*this, mBoard, mCellStart); }
-    auto end() const { return Iterator(*this, mBoard, mCellSentinel); }
-
-    auto begin_at(const Cell &cell) const {
-        assert(cell.coord().row() == mIndex);
-        return Iterator(*this, mBoard, mCellStart + cell.coord().column());
-    }
-
-    bool operator==(const Row &other) const {
-        return &mBoard == &other.mBoard
-             && mIndex == other.mIndex;
+    bool operator==(const BasicRow &other) const {
+        return mCells == other.mCells
+            && mIndex == other.mIndex;
     }
 
-    bool operator<(const Row &other) const {
-        assert(&mBoard == &other.mBoard);
+    bool operator<(const BasicRow &other) const {
+        assert(mCells == other.mCells);
         return mIndex < other.mIndex;
     }
 
-    bool contains(const Cell &other) const {
-        return std::find(begin(), end(), other) != end();
-    }
+    bool contains(const Cell &other) const { return other.coord().row() == mIndex; }
 
     size_t index() const { return mIndex; }
 
 private:
-    static_assert(std::forward_iterator<Iterator>);
-    Board &mBoard;
-    const size_t mIndex;
-    const size_t mCellStart, mCellSentinel;
+    const Cell *mCells = nullptr;
+    size_t mIndex = 0;
 };
+
+static_assert(std::forward_iterator<Row::Iterator>);
@@ -0,0 +1,232 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "search.h"
+#include "geometry.h"
+#include "board.h"
+#include "cell.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+// The search's whole state. A placed cell keeps its digit as a one-bit mask and
+// leaves `open`; an open cell's mask is its remaining candidates.
+template<size_t Box>
+struct Grid {
+    using G = Geometry<Box>;
+
+    std::array<typename G::Notes, G::kCells> cands {};
+    typename G::Cells open;
+};
+
+template<size_t Box>
+class Searcher {
+    using G = Geometry<Box>;
+    using Notes = typename G::Notes;
+
+public:
+    Searcher(size_t limit, bool guess) : mLimit(limit), mGuess(guess) { }
+
+    // Place `digit` (a one-bit mask) in the open cell `cell`, then every naked
+    // single that leaves, transitively. False on a contradiction: a peer left
+    // with no candidate, or two cells of a unit placed with the same digit.
+    bool place(Grid<Box> &g, size_t cell, Notes digit) const {
+        std::array<typename G::Index, G::kCells> pending;
+        size_t count = 0;
+        g.cands[cell] = digit;
+        pending[count++] = static_cast<typename G::Index>(cell);
+
+        while (count > 0) {
+            const size_t c = pending[--count];
+            const Notes bit = g.cands[c];
+            g.open.reset(c);
+
+            for (auto peer : G::kPeerList[c]) {
+                if (!(g.cands[peer] & bit)) continue;
+                if (!g.open.test(peer)) return false;
+
+                g.cands[peer] &= ~bit;
+                if (g.cands[peer] == 0) return false;
+                // A mask goes from two bits to one exactly once, so no cell is
+                // queued twice and `pending` cannot overflow.
+                if (std::has_single_bit(g.cands[peer])) pending[count++] = peer;
+            }
+        }
+        return true;
+    }
+
+    // Place every digit that has a single cell left in some unit, until none
+    // does. False on a contradiction, including a unit in which some digit has
+    // no cell left at all.
+    bool hidden_singles(Grid<Box> &g) const {
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            for (auto const &unit : G::kUnitCells) {
+                Notes once = 0, twice = 0, placed = 0;
+                for (auto c : unit) {
+                    twice |= once & g.cands[c];
+                    once |= g.cands[c];
+                    if (!g.open.test(c)) placed |= g.cands[c];
+                }
+                if (once != G::kAllDigits) return false;
+
+                for (Notes singles = once & ~twice & ~placed; singles; singles &= singles - 1) {
+                    const Notes bit = singles & -singles;
+                    size_t cell = G::kCells;
+                    for (auto c : unit) if (g.cands[c] & bit) { cell = c; break; }
+
+                    // An earlier placement in this pass may have placed it
+                    // already, or taken it from its only cell.
+                    if (cell == G::kCells) return false;
+                    if (!g.open.test(cell)) continue;
+                    if (!place(g, cell, bit)) return false;
+                    progress = true;
+                }
+            }
+        }
+        return true;
+    }
+
+    void run(const Grid<Box> &g) {
+        if (g.open.empty()) { record(g); return; }
+        if (!mGuess) return;
+
+        // Minimum remaining values. Propagation leaves no open cell with fewer
+        // than two candidates, so two is as good as it gets.
+        size_t best = G::kCells;
+        int best_count = G::kSide + 1;
+        for (size_t c : g.open) {
+            const int count = std::popcount(g.cands[c]);
+            if (count < best_count) { best = c; best_count = count; }
+            if (best_count == 2) break;
+        }
+
+        for (Notes digits = g.cands[best]; digits && !done(); digits &= digits - 1) {
+            Grid<Box> next = g;
+            ++mResult.guesses;
+            if (place(next, best, digits & -digits) && hidden_singles(next)) run(next);
+        }
+    }
+
+    // Settle what `g` already implies -- an empty cell, unplaced singles, hidden
+    // singles -- then search it.
+    SearchResult start(Grid<Box> &g) {
+        for (size_t c : g.open)
+            if (g.cands[c] == 0) return mResult;
+        for (size_t c : g.open) {
+            if (!g.open.test(c) || !std::has_single_bit(g.cands[c])) continue;
+            if (!place(g, c, g.cands[c])) return mResult;
+        }
+        if (!hidden_singles(g)) return mResult;
+
+        run(g);
+        return mResult;
+    }
+
+    bool done() const { return mResult.solutions >= mLimit; }
+
+private:
+    void record(const Grid<Box> &g) {
+        if (mResult.solutions++ > 0) return;
+        mResult.solution.reserve(G::kCells);
+        for (Notes digit : g.cands) mResult.solution.push_back(kSymbols[std::countr_zero(digit)]);
+    }
+
+    SearchResult mResult;
+    size_t mLimit;
+    bool mGuess;
+};
+
+// Read the givens of a Box-sized board, one symbol per cell: kSymbols' digits
+// (letters in either case) or '.' or '0' for an empty cell. Throws on a bad
+// length, a bad symbol, or a digit repeated within a unit, with the 9x9 Board's
+// wording for each.
+template<size_t Box>
+Grid<Box> read_givens(const std::string &cells) {
+    using G = Geometry<Box>;
+    if (cells.size() != G::kCells)
+        throw std::runtime_error("expected " + std::to_string(G::kCells) + " cells, got " + std::to_string(cells.size()));
+
+    std::array<uint8_t, G::kCells> digit {};   // 1-based; 0 is empty
+    for (size_t i = 0; i < G::kCells; ++i) {
+        const char c = static_cast<char>(std::toupper(static_cast<unsigned char>(cells[i])));
+        if (c == '.' || c == '0') continue;
+        const char *symbol = std::find(kSymbols, kSymbols + G::kSide, c);
+        if (symbol == kSymbols + G::kSide)
+            throw std::runtime_error(std::string("invalid character '") + cells[i] + "' at position "
+                                     + std::to_string(i + 1) + " (use 1-" + kSymbols[G::kSide - 1] + " or '.')");
+        digit[i] = static_cast<uint8_t>(symbol - kSymbols + 1);
+    }
+
+    // A 9x9 board's boxes are its nonets; the larger sizes' are just boxes.
+    static const char *const kinds[] = { "row", "column", Box == 3 ? "nonet" : "box" };
+    for (size_t u = 0; u < G::kUnitCount; ++u) {
+        typename G::Notes seen = 0;
+        for (auto c : G::kUnitCells[u]) {
+            if (!digit[c]) continue;
+            const typename G::Notes bit = typename G::Notes(1) << (digit[c] - 1);
+            if (seen & bit)
+                throw std::runtime_error(std::string("invalid board: value ") + kSymbols[digit[c] - 1]
+                                         + " appears more than once in a " + kinds[u / G::kSide]);
+            seen |= bit;
+        }
+    }
+
+    Grid<Box> g;
+    for (size_t i = 0; i < G::kCells; ++i) {
+        g.cands[i] = digit[i] ? typename G::Notes(1) << (digit[i] - 1) : G::kAllDigits;
+        g.open.set(i);
+    }
+    return g;
+}
+
+} // namespace anonymous
+
+template<size_t Box>
+SearchResult search(const BasicBoard<Box> &board, size_t limit) {
+    assert(limit > 0);
+
+    using Notes = typename Geometry<Box>::Notes;
+    Grid<Box> g;
+    g.open = ~board.solved();
+    for (Value v : value_range<Box>())
+        for (size_t c : board.candidates(v)) g.cands[c] |= Notes(1) << (v - 1);
+    for (size_t c : board.solved())
+        g.cands[c] = Notes(1) << (board.cells()[c].value() - 1);
+
+    // The board's own notes may already hold an empty cell or unplaced singles;
+    // start() settles both before the first guess.
+    return Searcher<Box>(limit, true).start(g);
+}
+
+template<size_t Box>
+size_t count_solutions(const BasicBoard<Box> &board, size_t limit) {
+    return search(board, limit).solutions;
+}
+
+template<size_t Box>
+SearchResult search_givens(const std::string &cells, size_t limit, bool guess) {
+    assert(limit > 0);
+
+    // Every given is a single the first settling pass places, like any other.
+    Grid<Box> g = read_givens<Box>(cells);
+    return Searcher<Box>(limit, guess).start(g);
+}
+
+template SearchResult search<3>(const BasicBoard<3> &, size_t);
+template SearchResult search<4>(const BasicBoard<4> &, size_t);
+template SearchResult search<5>(const BasicBoard<5> &, size_t);
+template size_t count_solutions<3>(const BasicBoard<3> &, size_t);
+template size_t count_solutions<4>(const BasicBoard<4> &, size_t);
+template size_t count_solutions<5>(const BasicBoard<5> &, size_t);
+template SearchResult search_givens<3>(const std::string &, size_t, bool);
+template SearchResult search_givens<4>(const std::string &, size_t, bool);
+template SearchResult search_givens<5>(const std::string &, size_t, bool);
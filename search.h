@@ -0,0 +1,56 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+template<size_t Box> class BasicBoard;
+
+// Backtracking search: what finishes a board the logical cascade stalls on.
+//
+// It starts from the board's candidate state -- the notes, not just the givens
+// -- so every elimination the techniques already made narrows the search. Each
+// cell's candidates are a mask, 9 bits on a 9x9 board. A placement strips its
+// digit from the cell's peers (geometry's kPeerList), and any peer left with one
+// candidate is placed in turn. After that, any digit left with a single cell in
+// some unit is placed too. Only when neither rule applies does it guess. It
+// picks the open cell with the fewest candidates (minimum remaining values) and
+// tries each one on a copy of the grid, which at 81 masks is cheaper than
+// undoing.
+//
+// A guess is one such trial, so `guesses` is 0 for a board the propagation
+// alone finishes, and counts every branch tried, dead ends included.
+struct SearchResult {
+    size_t solutions = 0;   // how many were found; the search stops at its limit
+    size_t guesses = 0;
+    std::string solution;   // the first one found, one symbol per cell; empty if none
+};
+
+// Search `board` for up to `limit` (at least 1) solutions. The solution is in
+// the board's symbols (cell.h's kSymbols): 81 digits on a 9x9 board.
+//
+// Instantiated for Box = 3, 4 and 5 (in search.cpp), as are the two below.
+template<size_t Box>
+SearchResult search(const BasicBoard<Box> &board, size_t limit = 1);
+
+// How many solutions `board` has, counting no further than `limit` (at least
+// 1). limit = 2 is the uniqueness check: 0 means no solution, 1 exactly one, 2
+// more than one. Like search(), it counts completions of the board's candidate
+// state, which for a board fresh from its givens are the puzzle's solutions.
+template<size_t Box>
+size_t count_solutions(const BasicBoard<Box> &board, size_t limit);
+
+// The same search on a board of box size Box -- 3 for 9x9, 4 for 16x16, 5 for
+// 25x25 -- given only by its givens: one symbol per cell, row-major, digits
+// 1-9 then letters A-P for the digits past nine (either case), and '.' or '0'
+// for an empty cell. The solution comes back in those symbols, upper case.
+// It builds no Board, which is what generate wants of the thousands of clue
+// sets it tries.
+//
+// With `guess` false it only propagates -- naked and hidden singles, to a
+// fixed point -- and counts a solution only when that alone fills the board.
+// Throws std::runtime_error when `cells` is not a board of that size: a wrong
+// length, an unknown symbol, or a digit repeated within a unit.
+template<size_t Box>
+SearchResult search_givens(const std::string &cells, size_t limit, bool guess = true);
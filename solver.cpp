@@ -2,99 +2,168 @@
 // See LICENSE for details of BSD 3-Clause License
 
 #include "solver.h"
+#include "verbose.h"
 
-bool Solver::solve_one_step(bool singles_only) {
+#include <ostream>
+
+template<size_t Box>
+BasicSolverState<Box> &BasicSolver<Box>::begin_step() {
+    if (mHistory == History::Snapshots) {
+        mPending = std::make_unique<SolverState>(*mStates.back());
+        return *mPending;
+    }
+
+    mMarks.push_back(mJournal.size());
+    mStates.back()->advance();
+    return *mStates.back();
+}
+
+template<size_t Box>
+void BasicSolver<Box>::end_step(bool did_act) {
+    if (mHistory == History::Snapshots) {
+        if (did_act) mStates.push_back(std::move(mPending));
+        mPending.reset();
+        return;
+    }
+
+    if (!did_act) {
+        mStates.back()->rewind(mJournal, mMarks.back(), mMarks.size() - 1);
+        mMarks.pop_back();
+    }
+}
+
+template<size_t Box>
+bool BasicSolver<Box>::solve_one_step(bool singles_only) {
     if (mStates.back()->solved()) return false;
 
-    SolverState::ptr nextState = std::make_unique<SolverState>(*mStates.back());
-    std::cout << "Step #" << nextState->generation() << ":" << std::endl;
+    SolverState &nextState = begin_step();
+    narration() << "Step #" << nextState.generation() << ":" << std::endl;
 
-    if (nextState->act(singles_only)) {
-        mStates.push_back(std::move(nextState));
+    bool did_act = nextState.act(singles_only);
+    end_step(did_act);
 
-        if (mStates.back()->solved()) {
-            std::cout << "SOLVED!" << std::endl;
-        }
-        return true;
+    if (did_act && mStates.back()->solved()) {
+        narration() << "SOLVED!" << std::endl;
     }
 
-    return false;
+    return did_act;
 }
 
-bool Solver::solve() {
+template<size_t Box>
+bool BasicSolver<Box>::solve() {
     if (mStates.back()->solved()) return false;
 
     bool did_act = false;
     while (solve_one_step(false)) did_act = true;
 
     if (!mStates.back()->solved()) {
-        std::cout << "???" << std::endl;
+        narration() << "???" << std::endl;
     }
 
     return did_act;
 }
 
-bool Solver::solve_singles() {
+template<size_t Box>
+bool BasicSolver<Box>::solve_singles() {
     if (mStates.back()->solved()) return false;
 
     bool did_act = false;
     while (solve_one_step(true)) did_act = true;
 
     if (!mStates.back()->solved()) {
-        std::cout << "???" << std::endl;
+        narration() << "???" << std::endl;
     }
 
     return did_act;
 }
 
-bool Solver::back_one_step() {
+template<size_t Box>
+bool BasicSolver<Box>::finish_by_search(size_t &guesses) {
+    guesses = 0;
+    if (mStates.back()->solved()) return false;
+
+    SolverState &nextState = begin_step();
+    narration() << "Step #" << nextState.generation() << ":" << std::endl;
+
+    bool did_act = nextState.finish_by_search(guesses);
+    end_step(did_act);
+
+    if (did_act) narration() << "SOLVED! (by search, " << guesses << " guesses)" << std::endl;
+    else         narration() << "No solution (search, " << guesses << " guesses)" << std::endl;
+
+    return did_act;
+}
+
+template<size_t Box>
+bool BasicSolver<Box>::back_one_step() {
     bool did_act = false;
-    if (mStates.size() > 1) {
+    if (mHistory == History::Snapshots && mStates.size() > 1) {
         mStates.pop_back();
         did_act = true;
-        std::cout << "Step #" << mStates.back()->generation() << ":" << std::endl;
     }
+    if (mHistory == History::Deltas && !mMarks.empty()) {
+        mStates.back()->rewind(mJournal, mMarks.back(), mMarks.size() - 1);
+        mMarks.pop_back();
+        did_act = true;
+    }
+    if (did_act) narration() << "Step #" << mStates.back()->generation() << ":" << std::endl;
     return did_act;
 }
 
-bool Solver::reset() {
+template<size_t Box>
+bool BasicSolver<Box>::reset() {
     bool did_act = false;
-    if (mStates.size() > 1) {
+    if (mHistory == History::Snapshots && mStates.size() > 1) {
         mStates.erase(mStates.begin() + 1, mStates.end());
         did_act = true;
-        std::cout << "Step #" << mStates.back()->generation() << ":" << std::endl;
     }
+    if (mHistory == History::Deltas && !mMarks.empty()) {
+        mStates.back()->rewind(mJournal, 0, 0);
+        mMarks.clear();
+        did_act = true;
+    }
+    if (did_act) narration() << "Step #" << mStates.back()->generation() << ":" << std::endl;
     return did_act;
 }
 
-bool Solver::edit_note(const std::string &entry) {
-    SolverState::ptr nextState = std::make_unique<SolverState>(*mStates.back());
+template<size_t Box>
+bool BasicSolver<Box>::edit_note(const std::string &entry) {
+    SolverState &nextState = begin_step();
 
     bool did_act = false;
 
-    if (nextState->edit_note(entry)) {
+    if (nextState.edit_note(entry)) {
         did_act = true;
-        std::cout << "Step #" << nextState->generation() << ":" << std::endl;
+        narration() << "Step #" << nextState.generation() << ":" << std::endl;
     }
 
-    if (did_act) mStates.push_back(std::move(nextState));
+    end_step(did_act);
     return did_act;
 }
 
-bool Solver::set_value(const std::string &entry) {
-    SolverState::ptr nextState = std::make_unique<SolverState>(*mStates.back());
+template<size_t Box>
+bool BasicSolver<Box>::set_value(const std::string &entry) {
+    SolverState &nextState = begin_step();
 
     bool did_act = false;
 
-    if (nextState->set_value(entry)) {
+    if (nextState.set_value(entry)) {
         did_act = true;
-        std::cout << "Step #" << nextState->generation() << ":" << std::endl;
+        narration() << "Step #" << nextState.generation() << ":" << std::endl;
     }
 
-    if (did_act) mStates.push_back(std::move(nextState));
+    end_step(did_act);
     return did_act;
 }
 
-std::ostream &operator<<(std::ostream &outs, const Solver &solver) {
+template<size_t Box>
+std::ostream &operator<<(std::ostream &outs, const BasicSolver<Box> &solver) {
     return outs << *solver.mStates.back();
 }
+
+template class BasicSolver<3>;
+template class BasicSolver<4>;
+template class BasicSolver<5>;
+template std::ostream &operator<<(std::ostream &, const BasicSolver<3> &);
+template std::ostream &operator<<(std::ostream &, const BasicSolver<4> &);
+template std::ostream &operator<<(std::ostream &, const BasicSolver<5> &);
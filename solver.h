@@ -5,18 +5,48 @@
 #include "solverstate.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
-class Solver {
+// How a Solver remembers the states it stepped through, for back_one_step()
+// and reset(). Both replay the same steps and print the same output; they
+// differ only in what a step costs.
+//   Snapshots: every step copies the whole state -- board and findings --
+//              and every generation stays alive. Simple, and what the
+//              interactive solver has always done.
+//   Deltas:    one state, stepped in place, its board journaling each
+//              placement and elimination it makes (see Board::set_journal).
+//              Stepping back undoes the journal to the step's mark. Memory is
+//              O(changes) and a step copies nothing, which is what batch wants.
+enum class History { Snapshots, Deltas };
+
+// A solve of a board of box size Box (see geometry.h), step by step. Solver is
+// the 9x9 one.
+template<size_t Box>
+class BasicSolver {
 public:
-    using ptr = std::unique_ptr<Solver>;
+    using ptr = std::unique_ptr<BasicSolver>;
+    using SolverState = BasicSolverState<Box>;
 
-    Solver(const std::string &board_desc) {
+    BasicSolver(const std::string &board_desc, History history = History::Snapshots)
+        : mHistory(history) {
         mStates.push_back(std::make_unique<SolverState>(board_desc));
+        if (mHistory == History::Deltas) mStates.back()->journal_into(&mJournal);
     }
 
+    // The journal points into this object, so it cannot move.
+    BasicSolver(const BasicSolver &) = delete;
+    BasicSolver &operator=(const BasicSolver &) = delete;
+
     bool solve_one_step(bool singles_only);
     bool solve();
     bool solve_singles();
+    // Finish the board by backtracking search (search.h), as one step. False,
+    // leaving the state as it was, if the board is already solved or has no
+    // solution; `guesses` is what the search took either way.
+    bool finish_by_search(size_t &guesses);
+    // Count the completions of the current board, up to `limit` (search.h).
+    size_t count_solutions(size_t limit) const { return mStates.back()->count_solutions(limit); }
     bool back_one_step();
     bool reset();
     bool edit_note(const std::string &);
@@ -31,11 +61,37 @@ public:
             mStates.back()->print_candidates(outs);
         }
     }
+    void print_line(std::ostream &outs) const {
+        if (!mStates.empty()) {
+            mStates.back()->print_line(outs);
+        }
+    }
 
     bool solved() const { return mStates.back()->solved(); }
 
-    friend std::ostream &operator<<(std::ostream &, const Solver &);
+    template<size_t B>
+    friend std::ostream &operator<<(std::ostream &, const BasicSolver<B> &);
 
 private:
-    std::vector<SolverState::ptr> mStates;
+    // Every step goes through this pair. begin_step() returns the state the
+    // step is to mutate, already one generation on: a copy of the current state
+    // under Snapshots, the current state itself under Deltas. end_step() keeps
+    // the step if it did anything and drops it otherwise.
+    SolverState &begin_step();
+    void end_step(bool did_act);
+
+    History mHistory;
+
+    // Snapshots: one state per generation, the current one last; mPending is
+    // the copy a step in progress works on. Deltas: exactly one state, and
+    // mMarks the journal length at the start of each step still undoable.
+    std::vector<typename SolverState::ptr> mStates;
+    typename SolverState::ptr mPending;
+    std::vector<BasicBoardChange<Box>> mJournal;
+    std::vector<size_t> mMarks;
 };
+
+template<size_t Box>
+std::ostream &operator<<(std::ostream &, const BasicSolver<Box> &);
+
+using Solver = BasicSolver<3>;
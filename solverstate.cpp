@@ -2,8 +2,11 @@
 // See LICENSE for details of BSD 3-Clause License
 
 #include "solverstate.h"
+#include "search.h"
+#include "verbose.h"
 
-bool SolverState::act(const bool singles_only) {
+template<size_t Box>
+bool BasicSolverState<Box>::act(const bool singles_only) {
     bool did_act = mAnalyzer.act(singles_only);
     if (did_act) {
         mAnalyzer.analyze();
@@ -11,10 +14,53 @@ bool SolverState::act(const bool singles_only) {
     return did_act;
 }
 
-bool SolverState::edit_note(const std::string &entry) {
+template<size_t Box>
+void BasicSolverState<Box>::rewind(std::vector<BoardChange> &journal, size_t mark, size_t generation) {
+    const bool did_change = journal.size() > mark;
+    mBoard.undo(journal, mark);
+    mGeneration = generation;
+
+    // The findings of the board we are back on are the ones analyze() found for
+    // it the first time; finding them again is a recomputation, not news, so it
+    // is kept out of the verbose trace -- which then reads exactly as it would
+    // had this state been a kept snapshot.
+    if (did_change) {
+        const bool verbose = sVerbose;
+        sVerbose = false;
+        mAnalyzer.analyze();
+        sVerbose = verbose;
+    }
+}
+
+template<size_t Box>
+bool BasicSolverState<Box>::finish_by_search(size_t &guesses) {
+    const SearchResult result = search(mBoard);
+    guesses = result.guesses;
+    if (result.solutions == 0) return false;
+
+    // Every open cell is still a note cell when its turn comes -- a placement
+    // only clears notes around it -- so set_value_at refuses none of these.
+    for (auto const &cell : mBoard.cells()) {
+        if (!cell.isNote()) continue;
+        const char symbol = result.solution[Geometry<Box>::index(cell.coord())];
+        const Value value = static_cast<Value>(symbol_digit(symbol, Geometry<Box>::kSide));
+        narration() << "[BT] " << cell.coord() << " =" << value << std::endl;
+        mBoard.set_value_at(cell.coord(), value);
+    }
+    mAnalyzer.analyze();
+    return true;
+}
+
+template<size_t Box>
+size_t BasicSolverState<Box>::count_solutions(size_t limit) const {
+    return ::count_solutions(mBoard, limit);
+}
+
+template<size_t Box>
+bool BasicSolverState<Box>::edit_note(const std::string &entry) {
     size_t row, col;
     Value val;
-    if (!parse_rcv(entry, row, col, val)) { return false; }
+    if (!parse_rcv<Box>(entry, row, col, val)) { return false; }
 
     bool did_clear_note = mBoard.clear_note_at(row, col, val);
     if (did_clear_note) {
@@ -23,10 +69,11 @@ bool SolverState::edit_note(const std::string &entry) {
     return did_clear_note;
 }
 
-bool SolverState::set_value(const std::string &entry) {
+template<size_t Box>
+bool BasicSolverState<Box>::set_value(const std::string &entry) {
     size_t row, col;
     Value val;
-    if (!parse_rcv(entry, row, col, val)) { return false; }
+    if (!parse_rcv<Box>(entry, row, col, val)) { return false; }
 
     bool did_set_value = mBoard.set_value_at(row, col, val);
     if (did_set_value) {
@@ -35,7 +82,8 @@ bool SolverState::set_value(const std::string &entry) {
     return did_set_value;
 }
 
-std::ostream &operator<<(std::ostream &outs, const SolverState &state) {
+template<size_t Box>
+std::ostream &operator<<(std::ostream &outs, const BasicSolverState<Box> &state) {
     outs << state.mBoard;
     if (!state.solved()) {
         outs << std::endl
@@ -43,3 +91,10 @@ std::ostream &operator<<(std::ostream &outs, const SolverState &state) {
     }
     return outs;
 }
+
+template class BasicSolverState<3>;
+template class BasicSolverState<4>;
+template class BasicSolverState<5>;
+template std::ostream &operator<<(std::ostream &, const BasicSolverState<3> &);
+template std::ostream &operator<<(std::ostream &, const BasicSolverState<4> &);
+template std::ostream &operator<<(std::ostream &, const BasicSolverState<5> &);
@@ -6,19 +6,25 @@
 #include "analyzer.h"
 
 #include <memory>
+#include <vector>
 
-class SolverState {
+// One generation of a solve of a board of box size Box (see geometry.h): the
+// board and its findings. SolverState is the 9x9 one.
+template<size_t Box>
+class BasicSolverState {
 public:
-    using ptr = std::unique_ptr<SolverState>;
+    using ptr = std::unique_ptr<BasicSolverState>;
+    using Board = BasicBoard<Box>;
+    using BoardChange = BasicBoardChange<Box>;
 
-    SolverState(const std::string &board_desc)
+    BasicSolverState(const std::string &board_desc)
         : mBoard(board_desc)
         , mAnalyzer(mBoard)
         , mGeneration(0) {
         mAnalyzer.analyze();
     }
 
-    SolverState(const SolverState &other)
+    BasicSolverState(const BasicSolverState &other)
         : mBoard(other.mBoard)
         , mAnalyzer(mBoard, other.mAnalyzer)
         , mGeneration(other.mGeneration + 1) {
@@ -26,7 +32,19 @@ public:
 
     size_t generation() const { return mGeneration; }
 
+    // In-place stepping, for Solver's Deltas history: instead of copying the
+    // state to step it, the solver journals its board, advance()s it one
+    // generation, and later rewind()s it -- undoing the board back to `mark`
+    // and re-deriving the findings for the board that leaves.
+    void journal_into(std::vector<BoardChange> *journal) { mBoard.set_journal(journal); }
+    void advance() { ++mGeneration; }
+    void rewind(std::vector<BoardChange> &journal, size_t mark, size_t generation);
+
     bool act(const bool);
+    // Place the first solution search() finds in every open cell. False, with
+    // the board untouched, if there is none.
+    bool finish_by_search(size_t &guesses);
+    size_t count_solutions(size_t limit) const;
     bool edit_note(const std::string &);
     bool set_value(const std::string &);
 
@@ -38,10 +56,19 @@ public:
     void print_candidates(std::ostream &outs) const {
         mBoard.print_candidates(outs);
     }
-    friend std::ostream &operator<<(std::ostream &, const SolverState &);
+    void print_line(std::ostream &outs) const {
+        mBoard.print_line(outs);
+    }
+    template<size_t B>
+    friend std::ostream &operator<<(std::ostream &, const BasicSolverState<B> &);
 
 private:
     Board mBoard;
-    Analyzer mAnalyzer;
+    BasicAnalyzer<Box> mAnalyzer;
     size_t mGeneration;
 };
+
+template<size_t Box>
+std::ostream &operator<<(std::ostream &, const BasicSolverState<Box> &);
+
+using SolverState = BasicSolverState<3>;
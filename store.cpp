@@ -0,0 +1,272 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "store.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = { 'S', 'U', 'D', 'O', 'K', 'U', 'S', '1' };
+constexpr size_t kHeaderBytes = 24;
+constexpr size_t kSlotBytes = 48;
+constexpr size_t kOffsetAt = 44;   // within a slot
+constexpr uint32_t kEmptySlot = 0xffffffff;
+
+uint32_t read32(const uint8_t *p) {
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+uint64_t read64(const uint8_t *p) { return read32(p) | uint64_t(read32(p + 4)) << 32; }
+
+void write32(std::string &out, uint32_t v) {
+    for (size_t i = 0; i < 4; ++i) out += static_cast<char>(v >> (8 * i));
+}
+void write64(std::string &out, uint64_t v) { write32(out, uint32_t(v)); write32(out, uint32_t(v >> 32)); }
+
+// FNV-1a over the key's bytes. It places keys in the mapped table, so it is
+// part of the file format and must not change.
+uint64_t hash_key(const SolutionStore::Key &key) {
+    uint64_t h = 0xcbf29ce484222325;
+    for (uint8_t byte : key) { h ^= byte; h *= 0x100000001b3; }
+    return h;
+}
+
+// The size of the record at `p`, given `available` bytes to read it from, or
+// 0 if it does not fit.
+size_t record_size(const uint8_t *p, size_t available) {
+    if (available < 2) return 0;
+    const size_t grade_at = p[0] ? 1 + SolutionStore::kKeyBytes : 1;
+    if (available < grade_at + 1) return 0;
+    const size_t size = grade_at + 1 + p[grade_at];
+    return size <= available ? size : 0;
+}
+
+// Read the record at `p`, known to fit.
+SolutionStore::Entry decode(const uint8_t *p) {
+    SolutionStore::Entry entry;
+    entry.solved = p[0] != 0;
+    size_t grade_at = 1;
+    if (entry.solved) {
+        entry.solution = p + 1;
+        grade_at += SolutionStore::kKeyBytes;
+    }
+    entry.grade = std::string_view(reinterpret_cast<const char *>(p + grade_at + 1), p[grade_at]);
+    return entry;
+}
+
+std::string encode(bool solved, std::string_view solution, std::string_view grade) {
+    std::string record(1, static_cast<char>(solved));
+    if (solved) {
+        const SolutionStore::Key packed = SolutionStore::pack(solution);
+        record.append(reinterpret_cast<const char *>(packed.data()), packed.size());
+    }
+    assert(grade.size() <= 255);
+    record += static_cast<char>(grade.size());
+    record.append(grade);
+    return record;
+}
+
+} // namespace anonymous
+
+SolutionStore::Key SolutionStore::pack(std::string_view cells) {
+    assert(cells.size() == 81);
+    Key key{};
+    for (size_t i = 0; i < 81; ++i) {
+        const uint8_t v = cells[i] == '.' ? 0 : static_cast<uint8_t>(cells[i] - '0');
+        key[i / 2] |= i % 2 ? v : v << 4;
+    }
+    return key;
+}
+
+void SolutionStore::unpack(const uint8_t *packed, char *cells) {
+    for (size_t i = 0; i < 81; ++i) {
+        const uint8_t v = i % 2 ? packed[i / 2] & 0xf : packed[i / 2] >> 4;
+        cells[i] = v ? static_cast<char>('0' + v) : '.';
+    }
+}
+
+size_t SolutionStore::KeyHash::operator()(const Key &key) const {
+    return static_cast<size_t>(hash_key(key));
+}
+
+SolutionStore::SolutionStore(const std::string &path) : mLogPath(path + ".log") {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0 && errno != ENOENT) throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+    if (fd >= 0) {
+        struct stat st;
+        if (::fstat(fd, &st) != 0) { ::close(fd); throw std::runtime_error("cannot read " + path); }
+        mMapSize = static_cast<size_t>(st.st_size);
+        void *map = mMapSize ? ::mmap(nullptr, mMapSize, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (map == MAP_FAILED) { mMapSize = 0; throw std::runtime_error(path + " is not a solution store"); }
+        mMap = static_cast<const uint8_t *>(map);
+
+        mSlots = mMapSize >= kHeaderBytes ? read32(mMap + 8) : 0;
+        mBlobSize = mMapSize >= kHeaderBytes ? read64(mMap + 16) : 0;
+        const bool valid = mMapSize >= kHeaderBytes
+                        && std::memcmp(mMap, kMagic, sizeof kMagic) == 0
+                        && mSlots != 0 && (mSlots & (mSlots - 1)) == 0
+                        && mMapSize == kHeaderBytes + uint64_t(mSlots) * kSlotBytes + mBlobSize;
+        if (!valid) {
+            ::munmap(const_cast<uint8_t *>(mMap), mMapSize);
+            mMap = nullptr;
+            throw std::runtime_error(path + " is not a solution store");
+        }
+        mSlotTable = mMap + kHeaderBytes;
+        mBlob = mSlotTable + size_t(mSlots) * kSlotBytes;
+
+        // A lookup probes until an empty slot, so there must be one: the
+        // records must number fewer than the slots, and be all the full slots
+        // there are. And every full slot must hold a record that fits the blob.
+        const uint32_t records = read32(mMap + 12);
+        uint64_t full = 0;
+        bool fits = true;
+        for (size_t slot = 0; slot < mSlots && fits; ++slot) {
+            const uint32_t offset = read32(mSlotTable + slot * kSlotBytes + kOffsetAt);
+            if (offset == kEmptySlot) continue;
+            ++full;
+            fits = offset < mBlobSize && record_size(mBlob + offset, mBlobSize - offset) != 0;
+        }
+        if (!fits || records >= mSlots || full != records) {
+            ::munmap(const_cast<uint8_t *>(mMap), mMapSize);
+            mMap = nullptr;
+            throw std::runtime_error(path + " is not a solution store");
+        }
+    }
+
+    std::ifstream log(mLogPath, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(log)), std::istreambuf_iterator<char>());
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(bytes.data());
+    for (size_t at = 0; at < bytes.size(); ) {
+        const size_t size = bytes.size() - at > kKeyBytes ? record_size(p + at + kKeyBytes, bytes.size() - at - kKeyBytes) : 0;
+        if (size == 0) {
+            // A torn write: what the last run got out before it died. Cut it
+            // off, so this run's records follow the last whole one.
+            if (::truncate(mLogPath.c_str(), static_cast<off_t>(at)) != 0)
+                throw std::runtime_error("cannot repair " + mLogPath + ": " + std::strerror(errno));
+            break;
+        }
+        Key key;
+        std::memcpy(key.data(), p + at, kKeyBytes);
+        mLog.emplace(key, bytes.substr(at + kKeyBytes, size));
+        at += kKeyBytes + size;
+    }
+}
+
+SolutionStore::~SolutionStore() {
+    if (mMap) ::munmap(const_cast<uint8_t *>(mMap), mMapSize);
+}
+
+bool SolutionStore::find_mapped(const Key &key, Entry &entry) const {
+    if (!mMap) return false;
+    // The open made sure there is an empty slot to stop at; bounded all the
+    // same, so no file can turn a lookup into a spin.
+    size_t slot = hash_key(key) & (mSlots - 1);
+    for (size_t probes = 0; probes < mSlots; ++probes, slot = (slot + 1) & (mSlots - 1)) {
+        const uint8_t *s = mSlotTable + slot * kSlotBytes;
+        const uint32_t offset = read32(s + kOffsetAt);
+        if (offset == kEmptySlot) return false;
+        if (std::memcmp(s, key.data(), kKeyBytes) != 0) continue;
+        entry = decode(mBlob + offset);
+        return true;
+    }
+    return false;
+}
+
+bool SolutionStore::find(const Key &key, Entry &entry) const {
+    if (find_mapped(key, entry)) return true;
+
+    std::shared_lock lock(mMutex);
+    auto it = mLog.find(key);
+    if (it == mLog.end()) return false;
+    entry = decode(reinterpret_cast<const uint8_t *>(it->second.data()));
+    return true;
+}
+
+void SolutionStore::append(const Key &key, bool solved, std::string_view solution, std::string_view grade) {
+    Entry held;
+    if (find_mapped(key, held)) return;
+
+    std::unique_lock lock(mMutex);
+    auto [it, inserted] = mLog.emplace(key, encode(solved, solution, grade));
+    if (!inserted) return;
+
+    if (!mLogFile.is_open()) mLogFile.open(mLogPath, std::ios::binary | std::ios::app);
+    mLogFile.write(reinterpret_cast<const char *>(key.data()), kKeyBytes);
+    mLogFile.write(it->second.data(), it->second.size());
+}
+
+void SolutionStore::flush() {
+    std::unique_lock lock(mMutex);
+    if (mLogFile.is_open()) mLogFile.flush();
+}
+
+size_t SolutionStore::compact(const std::string &path) {
+    std::vector<std::pair<Key, std::string>> records;
+    {
+        SolutionStore store(path);
+        for (size_t slot = 0; slot < store.mSlots; ++slot) {
+            const uint8_t *s = store.mSlotTable + slot * kSlotBytes;
+            const uint32_t offset = read32(s + kOffsetAt);
+            if (offset == kEmptySlot) continue;
+            const size_t size = record_size(store.mBlob + offset, store.mBlobSize - std::min<uint64_t>(offset, store.mBlobSize));
+            if (!size) throw std::runtime_error(path + " is corrupt");
+            Key key;
+            std::memcpy(key.data(), s, kKeyBytes);
+            records.emplace_back(key, std::string(reinterpret_cast<const char *>(store.mBlob + offset), size));
+        }
+        for (auto &[key, record] : store.mLog) {
+            Entry held;
+            if (!store.find_mapped(key, held)) records.emplace_back(key, std::move(record));
+        }
+    }
+
+    uint32_t slots = 16;
+    while (slots < 2 * records.size()) slots *= 2;
+
+    std::string table(size_t(slots) * kSlotBytes, '\0');
+    for (size_t slot = 0; slot < slots; ++slot)
+        std::memset(&table[slot * kSlotBytes + kOffsetAt], 0xff, 4);
+    std::string blob;
+    for (auto const &[key, record] : records) {
+        size_t slot = hash_key(key) & (slots - 1);
+        while (read32(reinterpret_cast<const uint8_t *>(&table[slot * kSlotBytes + kOffsetAt])) != kEmptySlot)
+            slot = (slot + 1) & (slots - 1);
+        std::memcpy(&table[slot * kSlotBytes], key.data(), kKeyBytes);
+        std::string offset;
+        write32(offset, static_cast<uint32_t>(blob.size()));
+        std::memcpy(&table[slot * kSlotBytes + kOffsetAt], offset.data(), 4);
+        blob += record;
+    }
+
+    std::string header(kMagic, sizeof kMagic);
+    write32(header, slots);
+    write32(header, static_cast<uint32_t>(records.size()));
+    write64(header, blob.size());
+
+    // Written beside PATH and renamed over it, so a reader never maps half a
+    // store.
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out << header << table << blob;
+        if (!out.flush()) throw std::runtime_error("cannot write " + temp);
+    }
+    if (std::rename(temp.c_str(), path.c_str()) != 0) throw std::runtime_error("cannot replace " + path);
+    std::remove((path + ".log").c_str());
+    return records.size();
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// A persistent store of cascade results, keyed by canonical puzzle (see
+// canonical.h), so that batch mode starts warm: what an earlier run solved is
+// looked up rather than solved again.
+//
+// A store is two files. PATH is the compacted store, written whole and only
+// ever read after that, through a read-only memory map:
+//
+//   header   8 bytes   magic "SUDOKUS1"
+//            4 bytes   slot count, a power of two
+//            4 bytes   record count
+//            8 bytes   blob size in bytes
+//   slots    48 bytes each, an open-addressing hash table probed linearly
+//            from hash(key) & (slots - 1):
+//            41 bytes  key: the canonical puzzle, two cells a byte, high
+//                      nibble first, 0 for an empty cell and 1-9 for a digit
+//             3 bytes  zero
+//             4 bytes  offset of the record in the blob; 0xffffffff for an
+//                      empty slot
+//   blob     the records back to back:
+//             1 byte   1 if the cascade solved the puzzle, 0 if it stalls
+//            41 bytes  the solution, packed like a key -- present only if solved
+//             1 byte   length of the grade
+//                      the grade text (SolveStats::print_grade); empty if none
+//
+// Every integer is little-endian, whatever the host. The table is at most half
+// full, so a probe for a missing key stops at an empty slot within a couple of
+// steps.
+//
+// PATH.log is the append log: every result a run solves that the store did not
+// hold is appended there, as its 41-byte key followed by its record, and
+// loaded into memory when the next run opens the store. A run that dies mid-write
+// leaves a torn record at the end of the log; the next open drops it, cutting the
+// log back to its last whole record. `compact` folds the log into a fresh PATH
+// and removes it.
+class SolutionStore {
+public:
+    static constexpr size_t kKeyBytes = 41;
+    using Key = std::array<uint8_t, kKeyBytes>;
+
+    // Pack an 81-cell grid -- '.' for an empty cell, 1-9 for a digit -- as a key
+    // or a stored solution, and back.
+    static Key pack(std::string_view cells);
+    static void unpack(const uint8_t *packed, char *cells);
+
+    // A record as the store holds it, pointing into the map or the log's copy
+    // in memory: good for as long as the store is.
+    struct Entry {
+        bool solved = false;
+        const uint8_t *solution = nullptr;   // packed, if solved
+        std::string_view grade;
+    };
+
+    // Open the store at `path`: map PATH if it exists, and load PATH.log if it
+    // does. Neither needs to; a store that has neither starts empty. A torn
+    // record at the end of the log is cut off. Throws std::runtime_error if PATH
+    // is not a store -- its header, slot table and blob must agree, and the
+    // table have an empty slot -- or the log cannot be cut back.
+    explicit SolutionStore(const std::string &path);
+    ~SolutionStore();
+
+    SolutionStore(const SolutionStore &) = delete;
+    SolutionStore &operator=(const SolutionStore &) = delete;
+
+    // Look `key` up, in the map and then the log. Allocates nothing.
+    bool find(const Key &key, Entry &entry) const;
+
+    // Record a result the store did not hold: appended to PATH.log, and findable
+    // from now on. A key already held is left as it is. `solution` is the 81-cell
+    // grid when `solved`.
+    void append(const Key &key, bool solved, std::string_view solution, std::string_view grade);
+
+    // Write out what append() has buffered. Batch mode calls it once per block,
+    // so a run killed mid-way loses at most the block it was solving.
+    void flush();
+
+    // Fold PATH.log into PATH: write every record of both to a fresh PATH, sized
+    // for them, then remove the log. Returns the number of records written.
+    static size_t compact(const std::string &path);
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    // The mapped PATH, or null when there is none.
+    const uint8_t *mMap = nullptr;
+    size_t mMapSize = 0;
+    uint32_t mSlots = 0;
+    const uint8_t *mSlotTable = nullptr;
+    const uint8_t *mBlob = nullptr;
+    uint64_t mBlobSize = 0;
+
+    // The log's records, each as its encoded bytes. A node-based map, so a
+    // record's bytes stay put while others are added.
+    std::unordered_map<Key, std::string, KeyHash> mLog;
+    std::ofstream mLogFile;
+    std::string mLogPath;
+    mutable std::shared_mutex mMutex;   // over mLog and mLogFile
+
+    bool find_mapped(const Key &key, Entry &entry) const;
+};
@@ -1,15 +1,28 @@
 // Copyright (c) 2025, Bertrand Mollinier Toublet
 // See LICENSE for details of BSD 3-Clause License
 
+#include "analyzer.h"
+#include "batch.h"
+#include "generate.h"
 #include "board.h"
 #include "cell.h"
+#include "geometry.h"
 #include "solverstate.h"
 #include "solver.h"
+#include "store.h"
 #include "verbose.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <optional>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
 
 #include <clocale>
 #include <cstdlib>
@@ -17,12 +30,15 @@
 
 #include <editline/readline.h>
 
-bool sVerbose = false;
+thread_local bool sVerbose = false;
 
 namespace {
 
 bool sInteractive = true;
 
+// How each new game's solver keeps its history (see solver.h); --history.
+History sHistory = History::Snapshots;
+
 // Path to the persistent command-history file, computed once at startup.
 std::string history_path() {
     const char *home = std::getenv("HOME");
@@ -74,6 +90,9 @@ void help(void) {
               << "                     * \"v\" is a value between 1 and 9, and" << std::endl
               << "                     * \".\" indicates an unset cell." << std::endl
               << "                   All 81 cells in a board must be entered." << std::endl
+              << "               A 16x16 or 25x25 board is entered in the second format, all" << std::endl
+              << "               256 or 625 cells, its values 1-9 then letters A-G or A-P;" << std::endl
+              << "               the commands below then take those symbols for 'r', 'c' and 'v'." << std::endl
               << std::endl
               << "Solver commands:" << std::endl
               << "  '>' or '.'    run one step of auto-solving" << std::endl
@@ -81,6 +100,8 @@ void help(void) {
               << "  '!'           reset the solver to its initial state" << std::endl
               << "  'r'           run auto-solving until blocked (or done)" << std::endl
               << "  's'           run auto-solving using only 'naked' and 'singles' heuristics" << std::endl
+              << "  'g'           finish the board by backtracking search (guessing)" << std::endl
+              << "  'u'           count the board's solutions, up to 2: is it unique?" << std::endl
               << "  'xrcv'        edit note at row 'r' and column 'c' and unset value 'v'" << std::endl
               << "  '=rcv'        set cell at row 'r' and column 'c' to value 'v'" << std::endl
               << std::endl
@@ -91,44 +112,29 @@ void help(void) {
               << std::endl;
 }
 
-bool routine(Solver::ptr &solver) {
-    bool done = false;
-
-    std::string line;
-    if (!read_line(line)) {
-        done = true;
-        return done;
-    }
-
-    // no whitespace we care to make use of
-    std::string nowsline(line, 0);
-    nowsline.erase(
-            std::remove_if(nowsline.begin(), nowsline.end(), [](unsigned char c){ return std::isspace(c); }),
-            nowsline.end());
-    if (nowsline.size() == 0) { return done; }
-
-    switch (nowsline[0]) {
-        case '#': // it's a comment
-            std::cout << line << std::endl;
-            return done;
+// The game in progress, at the size it was started at: 9x9, or 16x16 or 25x25
+// for an 'n' board of that many cells. A null Solver before the first game.
+using Game = std::variant<Solver::ptr, BasicSolver<4>::ptr, BasicSolver<5>::ptr>;
+
+// Start a game from an 'n' description. Only the '.' form says how large the
+// board is, by its length; anything else is a 9x9 board.
+Game new_game(const std::string &desc) {
+    auto has_cells = [&](size_t n) { return desc.size() == n + 1 && desc[0] == '.'; };
+    if (has_cells(Geometry<4>::kCells)) return std::make_unique<BasicSolver<4>>(desc, sHistory);
+    if (has_cells(Geometry<5>::kCells)) return std::make_unique<BasicSolver<5>>(desc, sHistory);
+    return std::make_unique<Solver>(desc, sHistory);
+}
 
-        case 'n': { // it's a new game
-            try {
-                solver = std::make_unique<Solver>(nowsline.substr(1));
-            }
-            catch (const std::runtime_error &e) {
-                std::cout << e.what() << std::endl;
-                help();
-                break;
-            }
-            assert(solver);
-            std::cout << *solver << std::endl;
-            }
-            break;
+// Run one solver command, `line` with its whitespace removed, on the game in
+// progress, whatever its size. False when there is no game, or the command is
+// not a solver command, or it is malformed: the caller prints the help.
+template<class SolverPtr>
+bool play(SolverPtr &solver, const std::string &line) {
+    if (!solver) return false;
 
+    switch (line[0]) {
         case '.':
         case '>': // auto-solve one step
-            if (!solver) { help(); break; }
             if (solver->solved()) break;
             if (solver->solve_one_step(false)) { std::cout << *solver << std::endl; }
             else                               { std::cout << "???" << std::endl; }
@@ -136,52 +142,101 @@ bool routine(Solver::ptr &solver) {
 
         case ',':
         case '<': // back one step
-            if (!solver) { help(); break; }
             if (solver->back_one_step()) { std::cout << *solver << std::endl; }
             break;
 
         case 'r':
         case 'R': // auto-solve until blocked (or finished)
-            if (!solver) { help(); break; }
             if (solver->solve()) { std::cout << *solver << std::endl; }
             break;
 
         case 's':
         case 'S': // auto-solve with single heuristics only
-            if (!solver) { help(); break; }
             if (solver->solve_singles()) { std::cout << *solver << std::endl; }
             break;
 
+        case 'g':
+        case 'G': { // finish by backtracking search
+            if (solver->solved()) break;
+            size_t guesses = 0;
+            if (solver->finish_by_search(guesses)) { std::cout << *solver << std::endl; }
+            else                                   { std::cout << "No solution" << std::endl; }
+            }
+            break;
+
+        case 'u':
+        case 'U': { // count solutions, stopping at 2
+            const size_t solutions = solver->count_solutions(2);
+            std::cout << "Solutions: " << (solutions == 0 ? "none" : solutions == 1 ? "1 (unique)" : "2 or more")
+                      << std::endl;
+            }
+            break;
+
         case '!': // reset
-            if (!solver) { help(); break; }
             if (solver->reset()) { std::cout << *solver << std::endl; }
             break;
 
         case 'x':
         case 'X': // edit a note
-            if (!solver) { help(); break; }
-            if (solver->edit_note(nowsline.substr(1))) { std::cout << *solver << std::endl; }
-            else                                       { help(); }
+            if (!solver->edit_note(line.substr(1))) return false;
+            std::cout << *solver << std::endl;
             break;
 
         case '=': // set a value
-            if (!solver) { help(); break; }
-            if (solver->set_value(nowsline.substr(1))) { std::cout << *solver << std::endl; }
-            else                                       { help(); }
+            if (!solver->set_value(line.substr(1))) return false;
+            std::cout << *solver << std::endl;
             break;
 
         case 'p':
         case 'P': // print the board in . notation
-            if (!solver) { help(); break; }
             solver->print_current_state(std::cout);
             break;
 
         case 'c':
         case 'C': // print per-cell candidates in a machine-readable form
-            if (!solver) { help(); break; }
             solver->print_candidates(std::cout);
             break;
 
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+bool routine(Game &game) {
+    bool done = false;
+
+    std::string line;
+    if (!read_line(line)) {
+        done = true;
+        return done;
+    }
+
+    // no whitespace we care to make use of
+    std::string nowsline(line, 0);
+    nowsline.erase(
+            std::remove_if(nowsline.begin(), nowsline.end(), [](unsigned char c){ return std::isspace(c); }),
+            nowsline.end());
+    if (nowsline.size() == 0) { return done; }
+
+    switch (nowsline[0]) {
+        case '#': // it's a comment
+            std::cout << line << std::endl;
+            return done;
+
+        case 'n': // it's a new game
+            try {
+                game = new_game(nowsline.substr(1));
+            }
+            catch (const std::runtime_error &e) {
+                std::cout << e.what() << std::endl;
+                help();
+                break;
+            }
+            std::visit([](auto &solver) { assert(solver); std::cout << *solver << std::endl; }, game);
+            break;
+
         case 'v':
         case 'V': // toggle verbosity of analysis steps
             sVerbose = !sVerbose;
@@ -189,17 +244,211 @@ bool routine(Solver::ptr &solver) {
             break;
 
         default:
-            help();
+            if (!std::visit([&](auto &solver) { return play(solver, nowsline); }, game)) help();
             break;
     }
 
     return done;
 }
 
+void usage(const char *argv0) {
+    std::cerr << "usage: " << argv0 << " [--history snapshots|deltas] [--verify-incremental] [--batch [--jobs N] [--search | --count N] [--grade] [--cache N] [--store FILE] [--stats | --stats-json]]" << std::endl
+              << "       " << argv0 << " --generate N [--seed S] [--needs TAG]... [--without TAG]... [--attempts N] [--jobs N]" << std::endl
+              << "       " << argv0 << " --compact-store FILE" << std::endl
+              << "  (no option)  interactive solver; type a command for help" << std::endl
+              << "  --history H  how the interactive solver remembers steps for '<' and '!':" << std::endl
+              << "               'snapshots' (default) copies the state per step, 'deltas' logs" << std::endl
+              << "               the changes and undoes them; output is unchanged" << std::endl
+              << "  --verify-incremental" << std::endl
+              << "               cross-check every incremental analysis against a full rescan," << std::endl
+              << "               and every search a prefilter skipped, aborting on a mismatch" << std::endl
+              << "  --batch      solve one 81-cell board per stdin line, print one result per line" << std::endl
+              << "  --jobs N     solve on N threads (0: one per hardware thread); output is unchanged" << std::endl
+              << "  --search     finish boards the techniques stall on by backtracking search" << std::endl
+              << "  --count N    print each board's number of solutions, counting no further than N" << std::endl
+              << "  --grade      follow each solved board with its difficulty: a score, the hardest" << std::endl
+              << "               technique it needed and how often each technique fired" << std::endl
+              << "  --cache N    answer repeats of the last N puzzles, up to symmetry, from a cache" << std::endl
+              << "  --store FILE keep results across runs in the solution store FILE, answering" << std::endl
+              << "               puzzles it holds, up to symmetry, without solving them" << std::endl
+              << "  --stats      after the results, print per-technique statistics to stderr" << std::endl
+              << "  --stats-json the same statistics as one JSON object" << std::endl
+              << "  --generate N print N new unique, minimal puzzles the techniques solve, one per line" << std::endl
+              << "  --seed S     generate from seed S (default: a random one, reported on stderr)" << std::endl
+              << "  --needs TAG  generate only puzzles whose solve applies technique TAG (e.g. FS);" << std::endl
+              << "               repeat it to need several" << std::endl
+              << "  --without TAG" << std::endl
+              << "               ... and never applies TAG (e.g. XY); repeat it to rule out several" << std::endl
+              << "  --attempts N give up with an error when a puzzle takes more than N tries" << std::endl
+              << "               (default: " << GenerateOptions::kDefaultAttempts << "); some TAGs random puzzles never need" << std::endl
+              << "  --compact-store FILE" << std::endl
+              << "               fold the results runs appended to FILE.log into FILE" << std::endl;
+}
+
+// Parse a --history argument. Returns false on anything but the two modes.
+bool parse_history(std::string_view arg, History &history) {
+    if      (arg == "snapshots") history = History::Snapshots;
+    else if (arg == "deltas")    history = History::Deltas;
+    else                         return false;
+    return true;
+}
+
+// Parse a --jobs argument: a plain decimal count, 0 meaning "one per hardware
+// thread". Returns false on anything else.
+bool parse_jobs(std::string_view arg, size_t &jobs) {
+    if (arg.empty() || arg.size() > 4) return false;
+    size_t n = 0;
+    for (char ch : arg) {
+        if (ch < '0' || ch > '9') return false;
+        n = n * 10 + (ch - '0');
+    }
+    if (n == 0) n = std::max(1u, std::thread::hardware_concurrency());
+    jobs = n;
+    return true;
+}
+
+// Parse a --count limit: a plain decimal count of at least 1.
+bool parse_count(std::string_view arg, size_t &count) {
+    if (arg.empty() || arg.size() > 9) return false;
+    size_t n = 0;
+    for (char ch : arg) {
+        if (ch < '0' || ch > '9') return false;
+        n = n * 10 + (ch - '0');
+    }
+    if (n == 0) return false;
+    count = n;
+    return true;
+}
+
+// Parse a --seed argument: a plain decimal number that fits 64 bits.
+bool parse_seed(std::string_view arg, uint64_t &seed) {
+    if (arg.empty() || arg.size() > 19) return false;
+    uint64_t n = 0;
+    for (char ch : arg) {
+        if (ch < '0' || ch > '9') return false;
+        n = n * 10 + (ch - '0');
+    }
+    seed = n;
+    return true;
+}
+
+// Parse a --needs or --without argument: the tag of a registry technique, as
+// the analyzer dump and --stats print it. Adds the technique's registry index
+// to `tags`.
+bool parse_tag(std::string_view arg, std::vector<size_t> &tags) {
+    const auto &reg = Analyzer::registry();
+    for (size_t i = 0; i < reg.size(); ++i) {
+        if (arg == reg[i]->name()) { tags.push_back(i); return true; }
+    }
+    return false;
+}
+
 } // namespace anonymous
 
-int main(void) {
-    Solver::ptr solver;
+int main(int argc, char *argv[]) {
+    if (argc > 1) {
+        bool batch = false;
+        bool batch_only = false;    // an option that means nothing to the REPL
+        bool generate = false;
+        bool generate_only = false; // an option that means something to generate mode alone
+        bool seeded = false;
+        bool pooled = false;        // --jobs, which either mode takes
+        BatchOptions options;
+        GenerateOptions generate_options;
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg(argv[i]);
+            if (arg == "--batch") {
+                batch = true;
+            } else if (arg == "--generate" && i + 1 < argc && parse_count(argv[i + 1], generate_options.count)) {
+                generate = true;
+                ++i;
+            } else if (arg == "--seed" && i + 1 < argc && parse_seed(argv[i + 1], generate_options.seed)) {
+                seeded = true;
+                generate_only = true;
+                ++i;
+            } else if (arg == "--needs" && i + 1 < argc && parse_tag(argv[i + 1], generate_options.needs)) {
+                generate_only = true;
+                ++i;
+            } else if (arg == "--without" && i + 1 < argc && parse_tag(argv[i + 1], generate_options.without)) {
+                generate_only = true;
+                ++i;
+            } else if (arg == "--attempts" && i + 1 < argc && parse_count(argv[i + 1], generate_options.attempts)) {
+                generate_only = true;
+                ++i;
+            } else if (arg == "--jobs" && i + 1 < argc && parse_jobs(argv[i + 1], options.jobs)) {
+                generate_options.jobs = options.jobs;
+                pooled = true;
+                ++i;
+            } else if (arg == "--search") {
+                options.search = true;
+                batch_only = true;
+            } else if (arg == "--count" && i + 1 < argc && parse_count(argv[i + 1], options.count)) {
+                batch_only = true;
+                ++i;
+            } else if (arg == "--grade") {
+                options.grade = true;
+                batch_only = true;
+            } else if (arg == "--cache" && i + 1 < argc && parse_count(argv[i + 1], options.cache)) {
+                batch_only = true;
+                ++i;
+            } else if (arg == "--store" && i + 1 < argc && argv[i + 1][0] != '\0') {
+                options.store = argv[++i];
+                batch_only = true;
+            } else if (arg == "--compact-store" && argc == 3 && i == 1 && argv[2][0] != '\0') {
+                try {
+                    std::cout << SolutionStore::compact(argv[2]) << " records" << std::endl;
+                    return 0;
+                }
+                catch (const std::runtime_error &e) {
+                    std::cerr << "error: " << e.what() << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--stats") {
+                options.stats = StatsFormat::Table;
+                batch_only = true;
+            } else if (arg == "--stats-json") {
+                options.stats = StatsFormat::Json;
+                batch_only = true;
+            } else if (arg == "--history" && i + 1 < argc && parse_history(argv[i + 1], sHistory)) {
+                ++i;
+            } else if (arg == "--verify-incremental") {
+                Analyzer::set_verify_incremental(true);
+            } else {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        if (batch && generate) { usage(argv[0]); return 2; }
+        if (batch_only && !batch) { usage(argv[0]); return 2; }
+        if (generate_only && !generate) { usage(argv[0]); return 2; }
+        if (pooled && !batch && !generate) { usage(argv[0]); return 2; }
+        if (options.grade && options.count > 0) { usage(argv[0]); return 2; }   // --count solves nothing to grade
+        if (options.search && options.count > 0) { usage(argv[0]); return 2; }  // ... nor to finish
+        // A technique both needed and ruled out is a choice no puzzle meets.
+        for (size_t tag : generate_options.needs) {
+            if (std::ranges::find(generate_options.without, tag) != generate_options.without.end()) {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+
+        // Batch keeps no history worth choosing: it always solves in Deltas
+        // mode (see batch.cpp), so --history only shapes the REPL.
+        if (batch) {
+            std::ios::sync_with_stdio(false);
+            return run_batch(std::cin, std::cout, options);
+        }
+        if (generate) {
+            if (!seeded) {
+                generate_options.seed = (uint64_t(std::random_device()()) << 32) | std::random_device()();
+                std::cerr << "seed: " << generate_options.seed << std::endl;
+            }
+            std::ios::sync_with_stdio(false);
+            return run_generate(std::cout, generate_options);
+        }
+    }
+
+    Game game;
 
     bool done = false;
 
@@ -220,7 +469,7 @@ int main(void) {
     }
 
     do {
-        done = routine(solver);
+        done = routine(game);
     } while (!done);
 
     if (!histfile.empty()) write_history(histfile.c_str());
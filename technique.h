@@ -4,8 +4,14 @@
 
 #include "board.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <iostream>
 
@@ -21,9 +27,93 @@ struct Finding {
     virtual void print(std::ostream &) const = 0;
 };
 
-// shared_ptr<const> => per-state copy of mFindings is a shallow vector copy,
-// no clone() ladder, no slicing (findings are immutable once found).
-using FindingList = std::vector<std::shared_ptr<const Finding>>;
+// Where the findings of one bucket live: carved one after the other out of a
+// few large blocks, and destroyed together when the arena goes. A bucket
+// records a handful of findings per search, and dozens on a busy Naked Pair
+// board, so this trades that many small heap allocations (and as many atomic
+// reference counts) for one block and one count. Findings are never freed one
+// at a time: an arena only grows until its last FindingList lets go of it.
+//
+// Not thread-safe, and it need not be: the lists sharing an arena are the
+// generations of one Solver's states, which one thread steps.
+class FindingArena {
+public:
+    FindingArena() = default;
+    FindingArena(const FindingArena &) = delete;
+    FindingArena &operator=(const FindingArena &) = delete;
+    ~FindingArena() {
+        for (auto it = mFindings.rbegin(); it != mFindings.rend(); ++it) (*it)->~Finding();
+    }
+
+    template<class T, class... Args>
+    const T &make(Args &&...args) {
+        static_assert(std::is_base_of_v<Finding, T>);
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        // Room in the list first, so a failed push cannot leave a finding that
+        // nothing will destroy. Grown by doubling, as push_back would: reserve()
+        // allocates exactly what it is asked for, so asking for one more slot
+        // each time would copy the whole list on every finding.
+        if (mFindings.size() == mFindings.capacity())
+            mFindings.reserve(std::max<size_t>(8, 2 * mFindings.capacity()));
+        T *t = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        mFindings.push_back(t);
+        return *t;
+    }
+
+private:
+    // Most searches record one finding or a few, so the first block is small;
+    // each one after it is twice the last, so a busy bucket needs few.
+    static constexpr size_t kFirstBlockBytes = 512;
+
+    void *allocate(size_t size, size_t align) {
+        size_t offset = (mUsed + align - 1) & ~(align - 1);
+        if (mBlocks.empty() || offset + size > mBlockSize) {
+            mBlockSize = std::max(mBlocks.empty() ? kFirstBlockBytes : 2 * mBlockSize, size);
+            mBlocks.push_back(std::make_unique_for_overwrite<std::byte[]>(mBlockSize));
+            offset = 0;
+        }
+        mUsed = offset + size;
+        return mBlocks.back().get() + offset;
+    }
+
+    std::vector<std::unique_ptr<std::byte[]>> mBlocks;
+    size_t mBlockSize = 0;
+    size_t mUsed = 0;
+    std::vector<Finding *> mFindings;
+};
+
+// One technique's bucket of findings, in the order they were recorded. The
+// findings themselves sit in an arena the list shares with its copies, so the
+// per-state copy of mFindings is a shallow copy of pointers and one reference
+// count per bucket: no clone() ladder, no slicing (findings are immutable once
+// found). clear() lets go of the arena, which is how analyze() releases a whole
+// bucket's findings in one shot once no other state still holds them.
+class FindingList {
+public:
+    using const_iterator = std::vector<const Finding *>::const_iterator;
+
+    // Construct a T in the arena and append it; returns it, for narration.
+    template<class T, class... Args>
+    const T &emplace(Args &&...args) {
+        if (!mArena) mArena = std::make_shared<FindingArena>();
+        const T &t = mArena->make<T>(std::forward<Args>(args)...);
+        mFindings.push_back(&t);
+        return t;
+    }
+
+    bool empty() const { return mFindings.empty(); }
+    size_t size() const { return mFindings.size(); }
+    const Finding *front() const { assert(!empty()); return mFindings.front(); }
+
+    const_iterator begin() const { return mFindings.begin(); }
+    const_iterator end() const { return mFindings.end(); }
+
+    void clear() { mFindings.clear(); mArena.reset(); }
+
+private:
+    std::shared_ptr<FindingArena> mArena;
+    std::vector<const Finding *> mFindings;
+};
 
 // Downcast a bucket entry to the concrete subtype the bucket holds. A stored
 // finding's fields are only reachable through its concrete type, so every read
@@ -40,18 +130,25 @@ using FindingList = std::vector<std::shared_ptr<const Finding>>;
 //
 // Call sites carry no comment on why the cast is sound; this is its one home.
 //
-// Takes the Finding, not the shared_ptr that owns it: the ownership choice
-// belongs to FindingList, and a reference in and out leaves no raw pointer to
-// outlive its owner.
+// Takes the Finding, not the pointer FindingList holds it by: the ownership
+// choice belongs to FindingList's arena, and a reference in and out leaves no
+// raw pointer to outlive it.
 template<class T>
 const T &bucket_cast(const Finding &f) {
     assert(dynamic_cast<const T *>(&f));
     return static_cast<const T &>(f);
 }
 
-class Technique {
+// A technique for boards of box size Box (see geometry.h). Each technique is
+// written once, for every size, as a template on Box, and instantiated for 3, 4
+// and 5 in its .cpp; Technique, like Board, is the 9x9 one.
+template<size_t Box>
+class BasicTechnique {
 public:
-    virtual ~Technique() = default;
+    using Board = BasicBoard<Box>;
+    using Cells = typename Geometry<Box>::Cells;
+
+    virtual ~BasicTechnique() = default;
     // Abstraction tag, e.g. "NS", "HS". Named name() rather than tag() on
     // purpose: board.h has a free tag(Unit), and a member named tag() would
     // shadow it inside every technique's find/apply/dump that prints a Unit,
@@ -82,4 +179,31 @@ public:
 
     // Apply this technique's findings to the board; consume (clear) them.
     virtual bool apply(Board &, FindingList &mine) const = 0;
+
+    // Applicability prefilter (see Analyzer::analyze): could find() record
+    // anything on this board? Answered from what the board already keeps --
+    // counts, the bivalue index, the per-unit position masks -- in a few mask
+    // operations rather than a search. A necessary condition only: false
+    // promises find() would come up empty and lets the analyzer skip it, true
+    // promises nothing. The default, true, never skips.
+    virtual bool may_fire(const Board &) const { return true; }
+
+    // Incremental search (see Analyzer::analyze). A technique whose every
+    // finding is anchored on one cell, and decided by a fixed neighbourhood of
+    // that cell, can say which cells a change could have affected and search
+    // only those. dirty_region() maps the cells changed since its last search to
+    // the cells worth searching again -- nullopt, the default, meaning it cannot
+    // localize -- and find_in() is find() restricted to `cells`, under the same
+    // contract and recording in the same order. Both or neither: a technique
+    // that returns a region must override find_in. And only a technique whose
+    // find() records every occurrence may return one -- the analyzer trusts a
+    // search that came up empty, or whose findings were all applied, to have
+    // left nothing behind outside the cells changed since.
+    virtual std::optional<Cells> dirty_region(const Cells &) const { return std::nullopt; }
+    virtual bool find_in(const Board &board, const Cells &, FindingList &out) const {
+        assert(false && "find_in() without dirty_region()");
+        return find(board, out);
+    }
 };
+
+using Technique = BasicTechnique<3>;
@@ -88,13 +88,14 @@
 
 #include "analyzer-nakedsingles.h"
 #include "analyzer-hiddensingles.h"
-#include "analyzer-nakedpairs.h"
+#include "analyzer-subsets.h"
 #include "analyzer-lockedcandidates.h"
-#include "analyzer-hiddenpairs.h"
 #include "analyzer-xwing.h"
 #include "analyzer-colorchain.h"
 #include "analyzer-ywing.h"
 #include "analyzer-swordfish.h"
+#include "analyzer-jellyfish.h"
 #include "analyzer-finnedxwing.h"
 #include "analyzer-finnedswordfish.h"
+#include "analyzer-finnedjellyfish.h"
 #include "analyzer-xychain.h"
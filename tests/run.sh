@@ -81,11 +81,12 @@ S_adv="1973426852658194374837562196312958748591743267426389519185637425264871933
 
 # A harder puzzle the pure-logic solver does NOT fully crack, but along the way
 # it is forced to *apply* X-Wing, naked-pair, locked-candidate and Swordfish
-# eliminations. S_hard (computed by an independent brute-force solver) is the
-# puzzle's unique completion; it is not a full-solve fixture -- the solver stalls
-# before finishing -- but it is a valid soundness oracle for the steps the solver
-# *does* take, which is what lets tier [2] check the Swordfish step never drops a
-# true candidate.
+# eliminations. S_hard (computed by an independent brute-force solver) is a
+# completion of the puzzle -- not its only one: the board has several, which no
+# sound technique can decide between, so it is not a full-solve fixture. It is
+# still a valid soundness oracle for the steps the solver *does* take (a sound
+# step keeps every completion's digits), which is what lets tier [2] check the
+# Swordfish step never drops a true candidate.
 P_hard="1..4....6.46.912....2......3......4....2.8....6......5......9....875.12.7....3..4"
 S_hard="179482536546391278832675419381569742957248361264137895413826957698754123725913684"
 
@@ -149,6 +150,27 @@ S_fx="95124638776438195228397514651769382462941873543852761937516249889273456114
 P_fs="...5.2...6......9....9.8....42..........9..1..81......1..6..9.5....3.7.8......2.1"
 S_fs="893542176625713894417968523942351687576894312381276459138627945254139768769485231"
 
+# Two corpus boards for the larger subsets. P_nt stalls before triples exist:
+# with pairs as the largest subset, every technique goes dry with the board half
+# solved. A naked triple in row 4 (step 12, on 1, 2 and 7) and a hidden triple in
+# column 3 (step 15, 1, 4 and 5 in [1, 3], [2, 3] and [5, 3]) open it up, and
+# Simple Coloring and the singles finish it. P_nq solves either way, but a naked
+# quad in row 7 (step 11) takes the place of three XY-chains. Neither corpus
+# search turned up a board that routes through a hidden quad: the tier [3] and
+# [7] lines below stop at NQ, and the unit suite covers HQ instead. Both
+# solutions were confirmed unique with --count 2.
+P_nt="....1.62.....5..738..............56.7.....4....698.....4..2....91...4.3.5...61..."
+S_nt="375418629194256873862793145239147568781635492456982317643829751918574236527361984"
+P_nq="7.143.......7...3.2.6.....9.8.6...2...3..956..6.8...97.......4...2..8...34......."
+S_nq="791436852854792631236581479987653124423179568165824397518967243672348915349215786"
+
+# A corpus board for both Jellyfish, on the same four base columns (1, 6, 7 and 9)
+# and value 7. A fin at [7, 7] makes it a finned Jellyfish first (step 14); once
+# an XY-chain strikes the fin, the plain one fires (step 16). Without the two the
+# board stalls. Its solution was confirmed unique with --count 2.
+P_jf=".2..5.8..61..93..5......9...91.....4....7.3..3.......2.6...2..12..9....8.53.4...."
+S_jf="429157863617893245835264917791326584582471396346589172968732451274915638153648729"
+
 echo "[0] Fixture sanity: puzzles and solutions are well-formed before they gate the solver"
 # A typo in a fixture would make a *correct* solver look broken, or mask a real
 # bug behind a "wrong grid" that is actually the fixture's fault. So validate the
@@ -207,7 +229,7 @@ fixture_ok() { # $1 = name, $2 = puzzle, $3 = solution
     why="$(consistent "$2" "$3")";    if [ -n "$why" ]; then bad "$1: solution contradicts a puzzle clue" "$why"; return; fi
     ok "$1: puzzle and solution are well-formed and consistent"
 }
-for name in easy med clm adv sf fx fs; do
+for name in easy med clm adv sf fx fs nt nq jf; do
     pvar="P_$name"; svar="S_$name"
     fixture_ok "$name" "${!pvar}" "${!svar}"
 done
@@ -218,7 +240,7 @@ done
 fixture_ok "hard" "$P_hard" "$S_hard"
 
 echo "[1] Full-solve correctness"
-for name in easy med clm adv sf fx fs; do
+for name in easy med clm adv sf fx fs nt nq jf; do
     pvar="P_$name"; svar="S_$name"
     out="$(printf 'n.%s\nr\np\n' "${!pvar}" | run_solver 2>&1)"
     got="$(printf '%s' "$out" | extract_grids | tail -1)"
@@ -278,7 +300,7 @@ elim_check() { # $1 = name, $2 = puzzle, $3 = solution
     else                           ok  "$1: every candidate grid still lists the solution's digits"
     fi
 }
-for name in easy med clm adv sf fx fs; do
+for name in easy med clm adv sf fx fs nt nq jf; do
     pvar="P_$name"; svar="S_$name"
     elim_check "$name" "${!pvar}" "${!svar}"
 done
@@ -313,6 +335,14 @@ vout_adv="$(printf 'v\nn.%s\nr\n' "$P_adv" | run_solver 2>&1)"
 check_tech "$vout_adv" SC "Simple Coloring"
 check_tech "$vout_adv" YW "Y-Wing"
 check_tech "$vout_adv" XY "XY-Chain"
+vout_nt="$(printf 'v\nn.%s\nr\n' "$P_nt" | run_solver 2>&1)"
+check_tech "$vout_nt" NT "Naked Triple"
+check_tech "$vout_nt" HT "Hidden Triple"
+vout_nq="$(printf 'v\nn.%s\nr\n' "$P_nq" | run_solver 2>&1)"
+check_tech "$vout_nq" NQ "Naked Quad"
+vout_jf="$(printf 'v\nn.%s\nr\n' "$P_jf" | run_solver 2>&1)"
+check_tech "$vout_jf" JF "Jellyfish"
+check_tech "$vout_jf" FJ "Finned Jellyfish"
 
 echo "[4] Load-time error messages for bad input"
 # The smoke test in CI proves bad input does not crash; this pins the actual
@@ -502,6 +532,21 @@ prec_check "x-wing"            XW "$P_clm" "[XW] [1, 4] x7 [c]
 [XW] [8, 8] x7 [c]
 [XW] [9, 4] x7 [c]
 [XW] [9, 8] x7 [c]"
+prec_check "naked triple"      NT "$P_nt" "[NT] [4, 2] x2 [r]
+[NT] [4, 3] x1 [r]
+[NT] [4, 3] x2 [r]
+[NT] [4, 9] x2 [r]
+[NT] [4, 9] x7 [r]"
+prec_check "hidden triple"     HT "$P_nt" "[HT] [1, 3] x7 {[1, 3],[2, 3],[5, 3]}#{1,4,5}
+[HT] [1, 3] x9 {[1, 3],[2, 3],[5, 3]}#{1,4,5}
+[HT] [2, 3] x2 {[1, 3],[2, 3],[5, 3]}#{1,4,5}
+[HT] [2, 3] x9 {[1, 3],[2, 3],[5, 3]}#{1,4,5}
+[HT] [5, 3] x8 {[1, 3],[2, 3],[5, 3]}#{1,4,5}
+[HT] [5, 3] x9 {[1, 3],[2, 3],[5, 3]}#{1,4,5}"
+prec_check "naked quad"        NQ "$P_nq" "[NQ] [7, 7] x6 [r]
+[NQ] [7, 7] x7 [r]
+[NQ] [7, 9] x5 [r]
+[NQ] [7, 9] x6 [r]"
 # Swordfish on value 8: base rows {1,6,9}, candidates confined to columns
 # {5,7,8}; 8 is eliminated from those columns outside the base rows. Verified by
 # hand against the candidate grid at the firing step.
@@ -527,6 +572,16 @@ prec_check "finned x-wing"     FX "$P_fx"    "[FX] [6, 1] x5 [r]"
 # board is the value-2 pattern issue #6 describes; first_app cannot see it, so
 # README's worked example is what documents that one.
 prec_check "finned swordfish"  FS "$P_fs"    "[FS] [4, 5] x8 [r]"
+# Jellyfish on value 7: base columns {1,6,7,9}, cover rows {1,3,4,9}. Row 4 has
+# no 7 left outside the base columns, so all five lines come from rows 1, 3, 9.
+prec_check "jellyfish"         JF "$P_jf" "[JF] [1, 3] x7 [r]
+[JF] [1, 4] x7 [r]
+[JF] [1, 8] x7 [r]
+[JF] [3, 8] x7 [r]
+[JF] [9, 4] x7 [r]"
+# The same fish two steps earlier, with its fin at [7, 7]: [9, 8] is the fin
+# nonet's one cover-row cell outside the base columns.
+prec_check "finned jellyfish"  FJ "$P_jf" "[FJ] [9, 8] x7 [r]"
 prec_check "simple coloring"   SC "$P_color" "[SC] [9, 5] x4 [👀🟩🟥]"
 prec_check "y-wing"            YW "$P_yw1" "[YW] [1, 5] x9
 [YW] [2, 8] x9"
@@ -765,6 +820,437 @@ EOF
     fi
 fi
 
+echo
+echo "[10] Batch mode: one result line per board, in order, with no narration"
+# --batch is a second front end onto the same solve path, so the fixtures that
+# tier [1] solves through the REPL must come out identical here. Blank and '#'
+# lines produce no output, so the result lines pair one-to-one with the boards
+# fed in: a solved grid, 'unsolved' for the stalling P_hard, and the load error
+# for a truncated board. Any narration leaking through breaks the pairing.
+bout="$(printf '%s\n' "$P_easy" "" "# a comment" ".$P_adv" "$P_hard" "123" "$P_fs" | run_solver --batch 2>&1)"
+bwant="$(printf '%s\n' "$S_easy" "$S_adv" unsolved "invalid: expected 81 cells, got 3" "$S_fs")"
+if [ "$bout" = "$bwant" ]; then
+    ok "batch: solved grids, 'unsolved' and 'invalid:' lines, in input order"
+else
+    bad "batch: output does not pair one line per board" "got: $(printf '%s' "$bout" | head -3 | tr '\n' '|')"
+fi
+# --jobs must not change a byte of the output, order included. The corpus is
+# every notes.txt board (solvable, stalling and the invalid one alike) plus the
+# fixtures, fed three times over so each worker's range holds a mix of fast and
+# slow boards and the pool actually steals.
+if [ -f "$NOTES" ]; then
+    bcorpus="$( { awk -F ' - ' '{ b = $2; gsub(/[ -]+$/, "", b); gsub(/ /, "", b); print b }' "$NOTES" | grep -E '^[0-9.]{81}$'
+                  printf '%s\n' "$P_easy" "$P_med" "$P_clm" "$P_adv" "$P_hard" "$P_sf" "$P_fx" "$P_fs"; } )"
+    bcorpus="$(printf '%s\n%s\n%s\n' "$bcorpus" "$bcorpus" "$bcorpus")"
+    bserial="$(printf '%s\n' "$bcorpus" | run_solver --batch --jobs 1 2>&1)"
+    bparallel="$(printf '%s\n' "$bcorpus" | run_solver --batch --jobs 4 2>&1)"
+    bcount="$(printf '%s\n' "$bcorpus" | grep -c .)"
+    if [ "$(printf '%s\n' "$bserial" | grep -c .)" != "$bcount" ]; then
+        bad "batch: --jobs 1 did not produce one line per corpus board"
+    elif [ "$bserial" = "$bparallel" ]; then
+        ok "batch: --jobs 4 reproduces --jobs 1 byte for byte on the $bcount-board corpus"
+    else
+        bad "batch: --jobs 4 output differs from --jobs 1"
+    fi
+fi
+if run_solver --bogus </dev/null >/dev/null 2>&1; then
+    bad "batch: an unknown option was accepted"
+else
+    ok "batch: an unknown option is rejected with a usage message"
+fi
+if run_solver --batch --jobs x </dev/null >/dev/null 2>&1; then
+    bad "batch: a malformed --jobs count was accepted"
+else
+    ok "batch: a malformed --jobs count is rejected"
+fi
+
+echo "[11] History modes: --history deltas replays a session exactly like snapshots"
+# The two modes differ only in how a step is remembered, so a session that
+# steps forward, back, resets and edits by hand must print the same bytes --
+# boards, analyzer dumps and the verbose trace alike -- under either. The
+# session runs over several fixtures so undo crosses placements, peer
+# eliminations and advanced-technique eliminations.
+hsession() {
+    echo v
+    for b in "$P_easy" "$P_adv" "$P_hard" "$P_fs"; do
+        printf '%s\n' "n.$b" '>' '>' '>' '<' '>' c '<' '<' '!' '>' x119 =995 r '<' '<' '<' c s '!' r '<' p
+    done
+}
+hsnap="$(hsession | run_solver 2>&1)"
+hdelta="$(hsession | run_solver --history deltas 2>&1)"
+if [ -n "$hsnap" ] && [ "$hsnap" = "$hdelta" ]; then
+    ok "history: a stepping/undo/edit session is byte-identical under both modes"
+else
+    bad "history: --history deltas output differs from snapshots"
+fi
+if run_solver --history bogus </dev/null >/dev/null 2>&1; then
+    bad "history: an unknown --history mode was accepted"
+else
+    ok "history: an unknown --history mode is rejected"
+fi
+
+echo "[12] Incremental analysis: agrees with a full rescan at every step"
+# analyze() re-searches only the cells a step could have affected, for the
+# techniques that can localize, and skips the others outright when their
+# prefilter rules them out. --verify-incremental redoes each such search over
+# the whole board and aborts on any difference (or on a skipped search that
+# finds something), so a clean exit with
+# unchanged output is the check. The corpus run covers forward solving; the
+# history session covers stepping back, which moves the board backwards under
+# the analyzer's feet.
+if [ -n "${bcorpus:-}" ]; then
+    vout="$(printf '%s\n' "$bcorpus" | run_solver --batch --verify-incremental 2>&1)"; vrc=$?
+    if [ "$vrc" -eq 0 ] && [ "$vout" = "$bserial" ]; then
+        ok "incremental: the batch corpus verifies and solves unchanged"
+    else
+        bad "incremental: verification failed on the batch corpus (exit $vrc)" "$(printf '%s' "$vout" | grep -m1 -e diverged -e prefilter)"
+    fi
+fi
+vsession="$(hsession | run_solver --history deltas --verify-incremental 2>&1)"; vrc=$?
+if [ "$vrc" -eq 0 ] && [ "$vsession" = "$hsnap" ]; then
+    ok "incremental: a stepping/undo/edit session verifies and prints unchanged"
+else
+    bad "incremental: verification failed on the history session (exit $vrc)"
+fi
+
+echo "[13] Search: stalled boards finished by backtracking, solutions counted"
+# P_hard is the board the cascade stalls on. With --search, batch must finish
+# it to a legal completion of its givens -- it has several, so which one is the
+# search's business -- and say how many guesses that took; a board with an
+# empty cell must come back as having no solution. In the REPL, 'g' after the
+# stall must leave the same grid behind as batch does.
+sout="$(printf '%s\n' "$P_easy" "$P_hard" "12345678.........9$(printf '.%.0s' $(seq 1 63))" | run_solver --batch --search 2>&1)"
+sgrid="$(printf '%s\n' "$sout" | sed -n 2p | sed 's/ guesses: [0-9]*$//')"
+case "$sout" in
+    "$S_easy"$'\n'[1-9]*" guesses: "[0-9]*$'\n'"no solution")
+        if [ -z "$(grid_check "$sgrid" full)" ] && [ -z "$(consistent "$P_hard" "$sgrid")" ]; then
+            ok "search: solved boards unchanged, the stalled one finished, the impossible one refused"
+        else
+            bad "search: the searched grid is not a completion of P_hard" "got: $sgrid"
+        fi ;;
+    *)  bad "search: unexpected --search output" "got: $(printf '%s' "$sout" | tr '\n' '|')" ;;
+esac
+rgrid="$(printf '%s\n' "n.$P_hard" r g p | run_solver 2>&1 | extract_grids | tail -1)"
+if [ -n "$sgrid" ] && [ "$rgrid" = "$sgrid" ]; then
+    ok "search: 'g' finishes the stalled board in the REPL as batch does"
+else
+    bad "search: 'g' did not finish the stalled board" "got: $rgrid"
+fi
+# Counting: the fixtures with a unique solution count 1 under --count 2,
+# P_hard (several completions) counts 2, the impossible board 0; a higher
+# limit lets P_hard count further. 'u' asks the same question in the REPL.
+cout="$(printf '%s\n' "$P_easy" "$P_hard" "12345678.........9$(printf '.%.0s' $(seq 1 63))" 123 | run_solver --batch --count 2 2>&1)"
+cwant="$(printf '%s\n' 1 2 0 "invalid: expected 81 cells, got 3")"
+if [ "$cout" = "$cwant" ]; then
+    ok "count: --count 2 tells unique, multiple and impossible boards apart"
+else
+    bad "count: unexpected --count 2 output" "got: $(printf '%s' "$cout" | tr '\n' '|')"
+fi
+if [ "$(printf '%s\n' "$P_hard" | run_solver --batch --count 3 2>&1)" = 3 ]; then
+    ok "count: the limit bounds the count, not the board"
+else
+    bad "count: --count 3 did not reach 3 on P_hard"
+fi
+uout="$(printf '%s\n' "n.$P_easy" u "n.$P_hard" u | run_solver 2>&1 | grep '^Solutions:')"
+if [ "$uout" = "$(printf '%s\n' 'Solutions: 1 (unique)' 'Solutions: 2 or more')" ]; then
+    ok "count: 'u' reports uniqueness in the REPL"
+else
+    bad "count: 'u' output unexpected" "got: $(printf '%s' "$uout" | tr '\n' '|')"
+fi
+if run_solver --batch --count 0 </dev/null >/dev/null 2>&1 \
+   || run_solver --batch --search --count 2 </dev/null >/dev/null 2>&1; then
+    bad "count: a zero --count limit, or --count with --search, was accepted"
+else
+    ok "count: a zero --count limit and --count with --search are rejected"
+fi
+if run_solver --search </dev/null >/dev/null 2>&1; then
+    bad "search: --search without --batch was accepted"
+else
+    ok "search: --search without --batch is rejected"
+fi
+
+echo
+echo "[14] Statistics: --stats and --stats-json report per technique, off stdout"
+# The statistics go to stderr only, so the results on stdout must match a run
+# without them byte for byte, serial and pooled alike. The table has a row per
+# technique in cascade order (as tier [9] read it off the solver); the JSON
+# names every technique and counts every board. NS fires on any board that is
+# not already solved, so its hits are not zero.
+tin="$(printf '%s\n' "$P_easy" "$P_med" "$P_hard" "$P_fs")"
+tplain="$(printf '%s\n' "$tin" | run_solver --batch 2>/dev/null)"
+for jobs in 1 3; do
+    tout="$(printf '%s\n' "$tin" | run_solver --batch --jobs $jobs --stats 2>/dev/null)"
+    if [ "$tout" = "$tplain" ]; then
+        ok "stats: --stats --jobs $jobs leaves stdout unchanged"
+    else
+        bad "stats: --stats --jobs $jobs changed stdout"
+    fi
+done
+ttable="$(printf '%s\n' "$tin" | run_solver --batch --stats 2>&1 >/dev/null)"
+trows="$(printf '%s\n' "$ttable" | awk 'NR > 2 && $1 != "total" { print $1 }' | tr '\n' ' ' | sed 's/ $//')"
+if printf '%s\n' "$ttable" | head -1 | grep -q '^Technique statistics over 4 board(s):$' \
+   && [ "$trows" = "$cascade" ] \
+   && printf '%s\n' "$ttable" | awk '$1 == "NS" { exit !($3 > 0) }' \
+   && printf '%s\n' "$ttable" | grep -q '^total '; then
+    ok "stats: the table has a row per technique, in cascade order, and a total"
+else
+    bad "stats: unexpected --stats table" "rows: $trows"
+fi
+tjson="$(printf '%s\n' "$tin" | run_solver --batch --jobs 3 --stats-json 2>&1 >/dev/null)"
+tmissing=""
+for tag in $cascade; do
+    case "$tjson" in *"\"name\": \"$tag\""*) ;; *) tmissing="$tmissing $tag" ;; esac
+done
+case "$tjson" in
+    '{"boards": 4, "reused": 0, "techniques": ['*']}')
+        if [ -z "$tmissing" ]; then
+            ok "stats: --stats-json reports every technique over every board"
+        else
+            bad "stats: --stats-json is missing techniques" "missing:$tmissing"
+        fi ;;
+    *)  bad "stats: unexpected --stats-json output" "got: $tjson" ;;
+esac
+if run_solver --stats </dev/null >/dev/null 2>&1; then
+    bad "stats: --stats without --batch was accepted"
+else
+    ok "stats: --stats without --batch is rejected"
+fi
+
+echo
+echo "[15] Larger boards: 16x16 and 25x25 by their length"
+# A 256- or 625-character line is a 16x16 or 25x25 board, letters standing for
+# the digits past nine. The whole cascade runs at every size; P16 and P25 need
+# the singles alone, C16 pairs, locked candidates, a triple, a Y-Wing and two
+# XY-chains. With its first two rows blanked, P16 has at least two solutions:
+# those rows can trade places.
+P16="4F8A.C5..92.G.3BEC.6D.21G73.4F8AD..1G7..4.8A.C56..3.4.8AE..6.9....AE.56D92.G73.4C5...21G..B4F8AE921G7..4F.A....D73.4F8AEC56D92.G8AEC5..921G73.4F.6D921...B4F.A.C2......F8AEC56..3...8AEC5...2..7....6D.2..73..F86..2...3B4F..E.5..73B4F8AE.56D.2.4F8AEC5.D9.1G73"
+S16="4F8AEC56D921G73BEC56D921G73B4F8AD921G73B4F8AEC56G73B4F8AEC56D921F8AEC56D921G73B4C56D921G73B4F8AE921G73B4F8AEC56D73B4F8AEC56D921G8AEC56D921G73B4F56D921G73B4F8AEC21G73B4F8AEC56D93B4F8AEC56D921G7AEC56D921G73B4F86D921G73B4F8AEC51G73B4F8AEC56D92B4F8AEC56D921G73"
+P25="...5B..HG6LND...O..7..I.P3..G6LND1.FOM97.2I...EK5.LND..FO.9.82.4P...5.3.HG6.OM9782I4PC.K5B3AHG.LND.J.2I.PC..5...HG6LN.1JF...7EK5B3A..6L.D1JFOM9782I4PCAHG6....JF.M..8.....EK5...D...OM978.I...EK..3A.G.LOM.7..I4P..K.B3A.G6LND...2I4PC.K..3A..6LN.1JFO.9.8..B.AHG6LND1J.O..7...4PC.HG6LND.J.OM978......K.B.A..JF.M978..4.CEK5B3.HG..NM9782I4P..K5B3AHG.LN..JFOI4...K5..AHG6....JFOM.....B3A.G..ND1..OM9782I4PC...6LN..JFO.97..I4PC.K..3A.1.FO.9.82I4..EK5.3AHG.....78..4.CEK5B3A.G.LN..JFOM.PC.K5..AHG.L..1J.OM.782....HG6..D1JF.M....I4PC.K5.LND1J...9782.4PC.....A.GJF.M978.I4P.EK...AH...ND17.2.4.CE..B3AHG6LND.JFO.9PC.K5B3A.G6.ND1.FOM9..2I."
+C16=".F...C5....1...B.C..D921..3.....D......B.F8.EC..G73...8.E..6....F.AE...D.21.73.4......1.....F..E.....3B..8....6D7..4.8..C56......AE..6.92...3.4...D..1G..B.F....21G.3......C...9....8.EC5..9....AE.5..92....B.F8...21G..B4..A..5.....4....C......4F8A.C........3"
+S25="CEK5B3AHG6LND1JFOM9782I4P3AHG6LND1JFOM9782I4PCEK5BLND1JFOM9782I4PCEK5B3AHG6FOM9782I4PCEK5B3AHG6LND1J82I4PCEK5B3AHG6LND1JFOM97EK5B3AHG6LND1JFOM9782I4PCAHG6LND1JFOM9782I4PCEK5B3ND1JFOM9782I4PCEK5B3AHG6LOM9782I4PCEK5B3AHG6LND1JF2I4PCEK5B3AHG6LND1JFOM978K5B3AHG6LND1JFOM9782I4PCEHG6LND1JFOM9782I4PCEK5B3AD1JFOM9782I4PCEK5B3AHG6LNM9782I4PCEK5B3AHG6LND1JFOI4PCEK5B3AHG6LND1JFOM97825B3AHG6LND1JFOM9782I4PCEKG6LND1JFOM9782I4PCEK5B3AH1JFOM9782I4PCEK5B3AHG6LND9782I4PCEK5B3AHG6LND1JFOM4PCEK5B3AHG6LND1JFOM9782IB3AHG6LND1JFOM9782I4PCEK56LND1JFOM9782I4PCEK5B3AHGJFOM9782I4PCEK5B3AHG6LND1782I4PCEK5B3AHG6LND1JFOM9PCEK5B3AHG6LND1JFOM9782I4"
+lout="$(printf '%s\n' "$P16" "$(printf '%s' "$P16" | tr 'A-G' 'a-g')" "$P25" | run_solver --batch 2>&1)"
+if [ "$lout" = "$(printf '%s\n' "$S16" "$S16" "$S25")" ]; then
+    ok "large: 16x16 (either case) and 25x25 fixtures solve to their known grids"
+else
+    bad "large: unexpected output for the 16x16/25x25 fixtures" "got: $(printf '%s' "$lout" | cut -c1-80 | tr '\n' '|')"
+fi
+lcount="$(printf '%s\n' "$P16" "$P25" "$(printf '%s' "$P16" | sed 's/^.\{32\}/................................/')" | run_solver --batch --count 2 2>&1)"
+if [ "$lcount" = "$(printf '%s\n' 1 1 2)" ]; then
+    ok "large: --count 2 tells unique and multiple 16x16/25x25 boards apart"
+else
+    bad "large: unexpected --count 2 output" "got: $(printf '%s' "$lcount" | tr '\n' '|')"
+fi
+lbad="$(printf '%s\n' "GG${P16#??}" "Z${P16#?}" | run_solver --batch 2>&1)"
+if [ "$lbad" = "$(printf '%s\n' "invalid: invalid board: value G appears more than once in a row" \
+                                 "invalid: invalid character 'Z' at position 1 (use 1-G or '.')")" ]; then
+    ok "large: a repeated digit or an unknown symbol is rejected"
+else
+    bad "large: bad 16x16 boards not rejected as expected" "got: $(printf '%s' "$lbad" | tr '\n' '|')"
+fi
+# A repeat within a 4x4 box is reported against a box, not a nonet.
+lbox="$(printf '1%16s1%238s\n' '' '' | tr ' ' '.' | run_solver --batch 2>&1)"
+if [ "$lbox" = "invalid: invalid board: value 1 appears more than once in a box" ]; then
+    ok "large: a digit repeated within a 16x16 box is reported against the box"
+else
+    bad "large: unexpected report of a repeat within a 16x16 box" "got: $lbox"
+fi
+# As for 9x9, --search adds the guess count to a board it finishes, zero or
+# not, and to none the singles finish on their own.
+lsearch="$(printf '%s\n' "$P16" "$(printf '%s' "$P16" | sed 's/^.\{32\}/................................/')" \
+           | run_solver --batch --search 2>&1)"
+any16="${S16//?/?}"   # a pattern matching any 256 symbols
+case "$lsearch" in
+    "$S16"$'\n'$any16" guesses: "[0-9]*)
+        ok "large: --search counts the guesses of the boards it finishes, and only theirs" ;;
+    *)  bad "large: unexpected --search output" "got: $(printf '%s' "$lsearch" | cut -c1-80 | tr '\n' '|')" ;;
+esac
+# C16 takes the cascade past the singles: its grade names what it needed, and
+# --verify-incremental checks every incremental search on the way, as it does
+# for the 9x9 corpus in [12].
+lgrade="$(printf '%s\n' "$C16" | run_solver --batch --grade 2>&1)"
+if [ "$lgrade" = "$S16 grade: 711 XY NS:55 HS:26 NP:2 LC:6 HP:1 NT:1 YW:1 XY:2" ]; then
+    ok "large: the cascade solves a 16x16 board through its harder techniques, and grades it"
+else
+    bad "large: unexpected --grade output for C16" "got: $(printf '%s' "$lgrade" | cut -c257-)"
+fi
+lverify="$(printf '%s\n' "$C16" "$P16" "$P25" | run_solver --batch --verify-incremental 2>&1)"; vrc=$?
+if [ "$vrc" -eq 0 ] && [ "$lverify" = "$(printf '%s\n' "$S16" "$S16" "$S25")" ]; then
+    ok "large: the 16x16/25x25 boards verify and solve unchanged under --verify-incremental"
+else
+    bad "large: verification failed on the larger boards (exit $vrc)" "$(printf '%s' "$lverify" | grep -m1 -e diverged -e prefilter)"
+fi
+# The REPL takes a larger board too: 'n' reads it by its length, and 'p' prints
+# its line a row per group.
+lrepl="$(printf 'n.%s\nr\np\n' "$C16" | run_solver 2>&1)"
+if printf '%s' "$lrepl" | grep -q 'SOLVED!' \
+   && [ "$(printf '%s\n' "$lrepl" | tail -1 | tr -d ' ')" = "$S16" ]; then
+    ok "large: the REPL solves a 16x16 board and prints its line"
+else
+    bad "large: the REPL did not solve C16" "got: $(printf '%s\n' "$lrepl" | tail -1 | cut -c1-80)"
+fi
+
+echo
+echo "[16] Grading: --grade follows each solved board with its difficulty"
+# A solved board's line is its grid, then " grade: <score> <hardest>" and every
+# technique that fired with its count, in cascade order. The grid part is the
+# plain result unchanged, a stalled board's line is unchanged, and the grade does
+# not depend on --jobs or --stats. The score sums one weight per application: 1
+# for a single, 10 for each place past the singles in the cascade -- P_fs needs
+# two Finned Swordfish at 140 each, P_easy nothing but naked singles.
+gout="$(printf '%s\n' "$tin" | run_solver --batch --grade 2>/dev/null)"
+if [ "$(printf '%s\n' "$gout" | sed 's/ grade: .*//')" = "$tplain" ] \
+   && [ "$(printf '%s\n' "$gout" | sed -n 1p)" = "$(printf '%s\n' "$tplain" | sed -n 1p) grade: 10 NS NS:10" ] \
+   && [ "$(printf '%s\n' "$gout" | sed -n 3p)" = "unsolved" ] \
+   && [ "$(printf '%s\n' "$gout" | sed -n 4p | cut -d' ' -f2-)" = "grade: 351 FS NS:14 HS:7 NP:1 LC:2 FS:2" ]; then
+    ok "grade: solved boards carry their score, hardest technique and counts"
+else
+    bad "grade: unexpected --grade output" "got: $(printf '%s' "$gout" | cut -c82- | tr '\n' '|')"
+fi
+gpool="$(printf '%s\n' "$tin" | run_solver --batch --grade --jobs 3 --stats 2>/dev/null)"
+gtable="$(printf '%s\n' "$tin" | run_solver --batch --grade --stats 2>&1 >/dev/null | head -1)"
+if [ "$gpool" = "$gout" ] && [ "$gtable" = "Technique statistics over 4 board(s):" ]; then
+    ok "grade: unchanged by --jobs and --stats, and --stats still counts every board"
+else
+    bad "grade: --jobs or --stats changed the grades" "table: $gtable"
+fi
+# Solved as given, this corpus puzzle needs three coloring steps; transposed and
+# relabeled, one. Graded through their shared canonical form, both read alike.
+G_img=".9......1.2.6.3.4....4.5.....8...9....28....5.....941.4..9.1.6..........5...8...."
+G_img_t="$(printf '%s' "$G_img" | awk '{ for (c = 0; c < 9; c++) for (r = 0; r < 9; r++) printf "%s", substr($0, r * 9 + c + 1, 1) }' | tr '123456789' '987654321')"
+gimg="$(printf '%s\n' "$G_img" "$G_img_t" | run_solver --batch --grade 2>&1 | cut -c82- | sort -u)"
+if [ "$gimg" = " grade: 240 SC NS:11 HS:9 NP:5 LC:4 SC:1" ]; then
+    ok "grade: two images of one puzzle get the same grade"
+else
+    bad "grade: two images of one puzzle graded differently" "got: $(printf '%s' "$gimg" | tr '\n' '|')"
+fi
+if run_solver --batch --grade --count 2 </dev/null >/dev/null 2>&1 \
+   || run_solver --grade </dev/null >/dev/null 2>&1; then
+    bad "grade: --grade with --count, or without --batch, was accepted"
+else
+    ok "grade: --grade with --count or without --batch is rejected"
+fi
+
+echo
+echo "[17] Generation: --generate makes unique, minimal puzzles, reproducibly"
+# Every generated puzzle has exactly one solution, and blanking any one of its
+# clues gives it a second. The same seed gives the same puzzles whatever --jobs
+# is, and --needs and --without keep only puzzles whose solve applies, and never
+# applies, the techniques named -- which --grade, reading the same cascade, must
+# agree with.
+gen="$(run_solver --generate 3 --seed 42 2>/dev/null)"
+gcount="$(printf '%s\n' "$gen" | run_solver --batch --count 2 2>&1 | tr '\n' ' ')"
+gminimal="$(printf '%s\n' "$gen" \
+    | awk '{ for (i = 1; i <= 81; i++) if (substr($0, i, 1) != ".") print substr($0, 1, i - 1) "." substr($0, i + 1) }' \
+    | run_solver --batch --count 2 2>&1 | sort -u | tr '\n' ' ')"
+if [ "$(printf '%s\n' "$gen" | grep -c '^[1-9.]\{81\}$')" = 3 ] && [ "$gcount" = "1 1 1 " ] && [ "$gminimal" = "2 " ]; then
+    ok "generate: three puzzles, each unique and minimal"
+else
+    bad "generate: puzzles not unique and minimal" "counts: $gcount; with a clue blanked: $gminimal"
+fi
+if [ "$(run_solver --generate 3 --seed 42 --jobs 3 2>/dev/null)" = "$gen" ] \
+   && [ "$(run_solver --generate 3 --seed 43 2>/dev/null)" != "$gen" ]; then
+    ok "generate: a seed gives the same puzzles under any --jobs, another seed others"
+else
+    bad "generate: output not determined by the seed alone"
+fi
+gneeds="$(run_solver --generate 3 --seed 5 --needs LC --without NP 2>/dev/null | run_solver --batch --grade 2>&1)"
+if [ "$(printf '%s\n' "$gneeds" | grep -c ' LC:')" = 3 ] && ! printf '%s\n' "$gneeds" | grep -q ' NP:'; then
+    ok "generate: --needs LC --without NP yields puzzles whose solve applies LC and never NP"
+else
+    bad "generate: --needs LC --without NP yielded other puzzles" "got: $(printf '%s' "$gneeds" | cut -c82- | tr '\n' '|')"
+fi
+if run_solver --generate 1 --needs QQ </dev/null >/dev/null 2>&1 \
+   || run_solver --generate 1 --needs FS --without FS </dev/null >/dev/null 2>&1 \
+   || run_solver --seed 1 </dev/null >/dev/null 2>&1 \
+   || run_solver --batch --generate 1 </dev/null >/dev/null 2>&1; then
+    bad "generate: an unknown or contradictory tag, --seed without --generate, or --generate with --batch was accepted"
+else
+    ok "generate: an unknown or contradictory tag, --seed without --generate and --generate with --batch are rejected"
+fi
+gout="$(run_solver --generate 1 --seed 1 --needs HQ --without XY --without SC --attempts 20 --jobs 2 2>&1)"; grc=$?
+if [ "$grc" -eq 1 ] && [ "$gout" = "error: no puzzle needing HQ without XY, SC in 20 attempts" ]; then
+    ok "generate: a --needs target out of reach ends the run with an error naming it"
+else
+    bad "generate: a --needs target out of reach did not end the run (exit $grc)" "$gout"
+fi
+if run_solver --generate 1 2>&1 >/dev/null | grep -q '^seed: [0-9][0-9]*$'; then
+    ok "generate: an unseeded run reports the seed it drew"
+else
+    bad "generate: an unseeded run did not report its seed"
+fi
+
+echo
+echo "[18] Solution cache: --cache answers symmetric repeats, unchanged output"
+# P_easy transposed and relabeled (d -> 10 - d) is the same puzzle up to
+# symmetry, so with --cache it is answered from P_easy's entry, its grid mapped
+# back. Every line must read as it does without the cache, serial or pooled,
+# the invalid board's error included.
+P_easy_t="$(printf '%s' "$P_easy" | awk '{ for (c = 0; c < 9; c++) for (r = 0; r < 9; r++) printf "%s", substr($0, r * 9 + c + 1, 1) }' | tr '123456789' '987654321')"
+cin="$(printf '%s\n' "$P_easy" "$P_easy_t" "$P_med" "$P_easy_t" "$P_hard" "123")"
+cplain="$(printf '%s\n' "$cin" | run_solver --batch 2>&1)"
+for jobs in 1 3; do
+    cout="$(printf '%s\n' "$cin" | run_solver --batch --cache 2 --jobs $jobs 2>&1)"
+    if [ "$cout" = "$cplain" ]; then
+        ok "cache: --cache 2 --jobs $jobs gives the same lines as no cache"
+    else
+        bad "cache: --cache 2 --jobs $jobs changed the output" "got: $(printf '%s' "$cout" | cut -c1-20 | tr '\n' '|')"
+    fi
+done
+# The two repeats are answered from the cache, so no technique runs on them, but
+# --stats still counts them, as reused; the invalid board is not counted at all.
+cstats="$(printf '%s\n' "$cin" | run_solver --batch --cache 2 --stats 2>&1 >/dev/null | head -1)"
+if [ "$cstats" = "Technique statistics over 5 board(s), 2 of them answered from the cache or store:" ]; then
+    ok "cache: --stats counts the boards the cache answered"
+else
+    bad "cache: --stats miscounted the boards the cache answered" "got: $cstats"
+fi
+if run_solver --cache 4 </dev/null >/dev/null 2>&1; then
+    bad "cache: --cache without --batch was accepted"
+else
+    ok "cache: --cache without --batch is rejected"
+fi
+
+echo "[19] Solution store: --store persists results across runs, unchanged output"
+# The first run solves everything and appends it to the store's log: three
+# puzzles, P_easy_t being P_easy up to symmetry. Once --compact-store has folded
+# the log into the store, a second run answers every board from the map --
+# nothing new is solved, so no log reappears -- and the output must still read
+# as it does without a store.
+store_dir="$(mktemp -d)"
+trap 'rm -rf "$store_dir"' EXIT
+store="$store_dir/results"
+sout="$(printf '%s\n' "$cin" | run_solver --batch --store "$store" 2>&1)"
+if [ "$sout" = "$cplain" ] && [ -f "$store.log" ]; then
+    ok "store: a cold --store run gives the same lines as no store, and logs them"
+else
+    bad "store: a cold --store run changed the output or logged nothing" "got: $(printf '%s' "$sout" | cut -c1-20 | tr '\n' '|')"
+fi
+compacted="$(run_solver --compact-store "$store" 2>&1)"
+if [ "$compacted" = "3 records" ] && [ -f "$store" ] && [ ! -e "$store.log" ]; then
+    ok "store: --compact-store folds the log into the store"
+else
+    bad "store: --compact-store did not fold the log" "got: $compacted"
+fi
+for jobs in 1 3; do
+    sout="$(printf '%s\n' "$cin" | run_solver --batch --store "$store" --jobs $jobs 2>&1)"
+    if [ "$sout" = "$cplain" ] && [ ! -e "$store.log" ]; then
+        ok "store: a warm --store --jobs $jobs run answers from the store, unchanged"
+    else
+        bad "store: a warm --store --jobs $jobs run changed the output or solved again"
+    fi
+done
+printf 'not a store\n' > "$store"
+if printf '%s\n' "$P_easy" | run_solver --batch --store "$store" >/dev/null 2>&1; then
+    bad "store: a file that is not a store was accepted"
+else
+    ok "store: a file that is not a store is rejected"
+fi
+if run_solver --store "$store" </dev/null >/dev/null 2>&1; then
+    bad "store: --store without --batch was accepted"
+else
+    ok "store: --store without --batch is rejected"
+fi
+
 echo
 echo "----------------------------------------"
 printf 'passed: %d   failed: %d\n' "$pass" "$fail"
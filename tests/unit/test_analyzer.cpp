@@ -22,23 +22,34 @@
 
 #include "board.h"
 #include "analyzer.h"
-#include "analyzer-nakedpairs.h"
-#include "analyzer-hiddenpairs.h"
+#include "canonical.h"
+#include "analyzer-subsets.h"
 #include "analyzer-xwing.h"
 #include "analyzer-colorchain.h"
 #include "analyzer-ywing.h"
 #include "analyzer-swordfish.h"
+#include "analyzer-jellyfish.h"
 #include "analyzer-finnedxwing.h"
 #include "analyzer-finnedswordfish.h"
+#include "analyzer-finnedjellyfish.h"
 #include "analyzer-xychain.h"
 #include "cell.h"
 #include "coord.h"
-
+#include "search.h"
+#include "solver.h"
+#include "store.h"
+#include "units.h"
+#include "verbose.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <initializer_list>
 #include <iostream>
 #include <memory>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -46,7 +57,7 @@
 // The analyzer reads this application-global to decide whether to narrate its
 // steps; it is normally defined in the REPL main (sudoku-solver.cpp), which this
 // test binary does not link, so we supply it here. The tests keep it false.
-bool sVerbose = false;
+thread_local bool sVerbose = false;
 
 // Friend hook: the only thing allowed to read/construct Analyzer internals.
 struct AnalyzerTest {
@@ -88,16 +99,17 @@ struct AnalyzerTest {
     // static and YWingFinding is declared in analyzer-ywing.h -- both without
     // friendship.
 
-    // --- the fish / naked pair / hidden pair ---
-    // No hooks: every one of them is a standalone Technique. Naked pair and
-    // hidden pair are given-tuple shaped, so their test_naked_pair /
-    // test_hidden_pair are public statics the whitebox cases call directly. The
-    // fish -- plain X-Wing and Swordfish, and their finned variants -- are all
-    // scan-fused (no test_ predicate -- see docs/test-predicate-idiom.md); the
-    // cases drive each one's per-anchor entry (XWingTechnique::find_xwing,
-    // SwordfishTechnique::find_swordfish,
+    // --- the fish / naked and hidden subsets ---
+    // No hooks: every one of them is a standalone Technique. Naked and hidden
+    // subsets are given-tuple shaped, so their test_naked_subset /
+    // test_hidden_subset are public statics the whitebox cases call directly. The
+    // fish -- plain X-Wing, Swordfish and Jellyfish, and their finned variants --
+    // are all scan-fused (no test_ predicate -- see docs/test-predicate-idiom.md);
+    // the cases drive each one's per-anchor entry (XWingTechnique::find_xwing,
+    // SwordfishTechnique::find_swordfish, JellyfishTechnique::find_jellyfish,
     // FinnedXWingTechnique::find_finned_xwing,
-    // FinnedSwordfishTechnique::find_finned_swordfish) on crafted boards and
+    // FinnedSwordfishTechnique::find_finned_swordfish,
+    // FinnedJellyfishTechnique::find_finned_jellyfish) on crafted boards and
     // inspect the recorded finding, which each fish declares in its own header
     // for that reason. Either way: no friendship.
 
@@ -131,10 +143,12 @@ void set_candidates(Board &board, size_t r, size_t c, std::initializer_list<int>
 }
 
 // Strike `value` everywhere except the listed (row,col) cells, so the technique
-// under test sees a controlled distribution of that one candidate.
-void confine_value(Board &board, Value value, const std::vector<std::pair<size_t,size_t>> &keep) {
-    for (size_t r = 0; r < Board::height; ++r) {
-        for (size_t c = 0; c < Board::width; ++c) {
+// under test sees a controlled distribution of that one candidate. These three
+// take a board of any size; the larger-board cases below use them too.
+template<size_t Box>
+void confine_value(BasicBoard<Box> &board, Value value, const std::vector<std::pair<size_t,size_t>> &keep) {
+    for (size_t r = 0; r < BasicBoard<Box>::height; ++r) {
+        for (size_t c = 0; c < BasicBoard<Box>::width; ++c) {
             bool keep_it = false;
             for (auto const &k : keep) if (k.first == r && k.second == c) { keep_it = true; break; }
             if (!keep_it) board.clear_note_at(r, c, value);
@@ -142,12 +156,14 @@ void confine_value(Board &board, Value value, const std::vector<std::pair<size_t
     }
 }
 
-bool has_candidate(const Board &board, size_t r, size_t c, Value v) {
-    return board.cells()[r * Board::width + c].check(v);
+template<size_t Box>
+bool has_candidate(const BasicBoard<Box> &board, size_t r, size_t c, Value v) {
+    return board.cells()[r * BasicBoard<Box>::width + c].check(v);
 }
 
-const Cell &cell_at(const Board &board, size_t r, size_t c) {
-    return board.cells()[r * Board::width + c];
+template<size_t Box>
+const BasicCell<Box> &cell_at(const BasicBoard<Box> &board, size_t r, size_t c) {
+    return board.cells()[r * BasicBoard<Box>::width + c];
 }
 
 // The lone finding recorded in `out`, downcast to `F`; nullptr if the search
@@ -166,7 +182,7 @@ const Cell &cell_at(const Board &board, size_t r, size_t c) {
 template<class F>
 const F *only(const FindingList &out) {
     if (out.size() != 1) return nullptr;
-    return dynamic_cast<const F *>(out.front().get());
+    return dynamic_cast<const F *>(out.front());
 }
 
 // ===========================================================================
@@ -287,6 +303,71 @@ void test_swordfish_no_elimination() {
     check(found.empty(), "no Swordfish recorded");
 }
 
+// ===========================================================================
+// Jellyfish
+// ===========================================================================
+
+// A column-based Jellyfish on value 6 -- Swordfish's column case one base line
+// wider, the same worker at N=4.
+//
+//        c0 c1 c2 c3 .. c5 .. c7
+//   r0    6  .  .  6     6         <- (0,5) is outside the base columns
+//   r1    6  6  .  .
+//   r2    .  6  6  .
+//   r3    .  .  6  6           6   <- (3,7) is outside the base columns
+//
+// Base columns {0,1,2,3}, each with two 6s, their rows a four-cycle whose union
+// is exactly {0,1,2,3}. No two or three of them close on their own, so only the
+// four-line fish sees it.
+void test_jellyfish_column_based() {
+    std::cout << "[jellyfish] column-based detection and action\n";
+    Board board = empty_board();
+    const Value V = kSix;
+    confine_value(board, V, {
+        {0,0},{1,0},        // column 0: rows {0,1}
+        {1,1},{2,1},        // column 1: rows {1,2}
+        {2,2},{3,2},        // column 2: rows {2,3}
+        {0,3},{3,3},        // column 3: rows {0,3}
+        {0,5},{3,7},        // strays to be eliminated
+    });
+
+    JellyfishTechnique jf;  // needed for apply() below; find_jellyfish is static
+    FindingList found;
+    check(JellyfishTechnique::find_jellyfish(board, cell_at(board, 0, 0), V, found),
+          "column Jellyfish detected with anchor (0,0)");
+    check(found.size() == 1, "exactly one Jellyfish recorded");
+    auto const *f = only<JellyfishFinding>(found);
+    check(f, "the recorded finding is a JellyfishFinding");
+    if (f) {
+        check(!f->is_row_based, "recorded Jellyfish is column-based");
+        check(f->value == V, "recorded Jellyfish is for value 6");
+    }
+
+    bool acted = jf.apply(board, found);
+    check(acted, "apply reports an elimination");
+    check(!has_candidate(board, 0, 5, V), "stray 6 at (0,5) eliminated");
+    check(!has_candidate(board, 3, 7, V), "stray 6 at (3,7) eliminated");
+    check(has_candidate(board, 0, 0, V) && has_candidate(board, 1, 0, V)
+       && has_candidate(board, 1, 1, V) && has_candidate(board, 2, 1, V)
+       && has_candidate(board, 2, 2, V) && has_candidate(board, 3, 2, V)
+       && has_candidate(board, 0, 3, V) && has_candidate(board, 3, 3, V),
+          "all eight pattern cells kept candidate 6");
+}
+
+// Same base columns, strays removed: read either way round it is a Jellyfish
+// with nothing to eliminate, and must not be recorded.
+void test_jellyfish_no_elimination() {
+    std::cout << "[jellyfish] a pattern with nothing to eliminate is not recorded\n";
+    Board board = empty_board();
+    const Value V = kSix;
+    confine_value(board, V, { {0,0},{1,0}, {1,1},{2,1}, {2,2},{3,2}, {0,3},{3,3} });
+
+    FindingList found;
+    check(!JellyfishTechnique::find_jellyfish(board, cell_at(board, 0, 0), V, found),
+          "no Jellyfish reported when there is nothing to eliminate");
+    check(found.empty(), "no Jellyfish recorded");
+}
+
 // ===========================================================================
 // XY-chain
 // ===========================================================================
@@ -551,14 +632,15 @@ void test_notes_set_ops() {
 // Naked Pair
 // ===========================================================================
 
-// test_naked_pair is the archetypal given-tuple predicate (see
-// docs/test-predicate-idiom.md): find_ enumerates cell pairs, the predicate
-// judges each. The black-box suite only reaches it on a real solve that happens
+// test_naked_subset is the archetypal given-tuple predicate (see
+// docs/test-predicate-idiom.md): find enumerates cell tuples, the predicate
+// judges each. These cases hand it pairs; the triple and quad cases below widen
+// the tuple. The black-box suite only reaches it on a real solve that happens
 // to route through a naked pair; these whitebox cases hand it crafted tuples to
 // pin down its branches directly.
 //
-// test_naked_pair is a composite: it accepts only a genuine pair (Notes::==)
-// that is *also* actionable (would_act). Those two gates are tested separately
+// test_naked_subset is a composite: it accepts only a genuine subset (N cells,
+// N values between them) that is *also* actionable (would_act). Those two gates are tested separately
 // below so a would_act change surfaces as an actionability failure, not a
 // phantom pair-match regression.
 void test_naked_pair_accept_and_reject() {
@@ -574,11 +656,11 @@ void test_naked_pair_accept_and_reject() {
 
     // The predicate is a promoted public static (no friend hook): call it directly,
     // instantiated on the cells' shared Row.
-    check(NakedPairTechnique::test_naked_pair(cell_at(board, 0, 0), cell_at(board, 0, 1), board.row(cell_at(board, 0, 0))),
+    check(SubsetTechnique::test_naked_subset({ {0, 0}, {0, 1} }, board.row(cell_at(board, 0, 0))),
           "accepted: two cells holding the same candidate pair {3,5}");
     // Reject short-circuits on the set compare, before would_act: a pure
     // pair-match check, immune to changes in actionability logic.
-    check(!NakedPairTechnique::test_naked_pair(cell_at(board, 0, 0), cell_at(board, 0, 2), board.row(cell_at(board, 0, 0))),
+    check(!SubsetTechnique::test_naked_subset({ {0, 0}, {0, 2} }, board.row(cell_at(board, 0, 0))),
           "rejected: candidate sets {3,5} and {3,6} differ");
 
     // --- actionability gate (would_act) ---
@@ -591,7 +673,7 @@ void test_naked_pair_accept_and_reject() {
     confine_value(inert, kSeven, { {0, 0}, {0, 1} });
     confine_value(inert, kEight, { {0, 0}, {0, 1} });
 
-    check(!NakedPairTechnique::test_naked_pair(cell_at(inert, 0, 0), cell_at(inert, 0, 1), inert.row(cell_at(inert, 0, 0))),
+    check(!SubsetTechnique::test_naked_subset({ {0, 0}, {0, 1} }, inert.row(cell_at(inert, 0, 0))),
           "rejected: a real pair with nothing to act on (would_act gate)");
 }
 
@@ -599,20 +681,17 @@ void test_naked_pair_accept_and_reject() {
 // Hidden pair
 // ===========================================================================
 
-// test_hidden_pair is given-tuple shaped like test_naked_pair (see
-// docs/test-predicate-idiom.md): find_ enumerates the partner cell, the
-// predicate judges each (c1,c2,v1,v2). The predicate is a public static, so
+// test_hidden_subset is given-tuple shaped like test_naked_subset (see
+// docs/test-predicate-idiom.md): find enumerates value tuples, the predicate
+// judges each (cells, values) -- here, the pair (c1,c2,v1,v2). The predicate is a public static, so
 // these cases call it directly -- no friend hook. They pin down its substantive
 // branches -- value ordering, cell ordering, the hidden loop, actionability,
 // and partner incompleteness -- and leave the trivial distinctness/shape guards
 // (c1 == c2, v1 == v2, set membership, isNote, c1 failing to carry the pair)
-// untested, as the test_naked_pair sibling does. Most of these branches are
-// also hit incidentally by any black-box solve, since find_hidden_pair feeds
-// every unfiltered cell to the predicate; the one find_ genuinely cannot reach
-// is value ordering
-// (HiddenPairTechnique::find enumerates pv2 = pv1 + 1, so v1 < v2 always holds), which
-// is the load-bearing reason to test the predicate directly rather than only
-// through find_.
+// untested, as the test_naked_subset sibling does. find reaches neither the
+// predicate's ordering guards nor its partner gate -- it builds only ascending
+// tuples out of the unit's position masks -- which is the load-bearing reason
+// to test the predicate directly rather than only through find.
 void test_hidden_pair_accept_and_reject() {
     std::cout << "[hidden pair] the hidden, actionability, ordering and partner gates\n";
 
@@ -624,7 +703,7 @@ void test_hidden_pair_accept_and_reject() {
     confine_value(board, kThree, { {0, 0}, {0, 1} });
     confine_value(board, kFive,  { {0, 0}, {0, 1} });
 
-    check(HiddenPairTechnique::test_hidden_pair(cell_at(board, 0, 0), cell_at(board, 0, 1), kThree, kFive, board.row(cell_at(board, 0, 0))),
+    check(SubsetTechnique::test_hidden_subset({ {0, 0}, {0, 1} }, { kThree, kFive }, board.row(cell_at(board, 0, 0))),
           "accepted: {3,5} confined to two cells, each with more to strip");
 
     // A third cell in the row carrying just one of the values breaks "hidden".
@@ -632,7 +711,7 @@ void test_hidden_pair_accept_and_reject() {
     confine_value(stray, kThree, { {0, 0}, {0, 1}, {0, 2} });
     confine_value(stray, kFive,  { {0, 0}, {0, 1} });
 
-    check(!HiddenPairTechnique::test_hidden_pair(cell_at(stray, 0, 0), cell_at(stray, 0, 1), kThree, kFive, stray.row(cell_at(stray, 0, 0))),
+    check(!SubsetTechnique::test_hidden_subset({ {0, 0}, {0, 1} }, { kThree, kFive }, stray.row(cell_at(stray, 0, 0))),
           "rejected: a third cell carries 3, so {3,5} is not hidden");
 
     // --- actionability gate ---
@@ -644,21 +723,20 @@ void test_hidden_pair_accept_and_reject() {
     confine_value(naked, kThree, { {0, 0}, {0, 1} });
     confine_value(naked, kFive,  { {0, 0}, {0, 1} });
 
-    check(!HiddenPairTechnique::test_hidden_pair(cell_at(naked, 0, 0), cell_at(naked, 0, 1), kThree, kFive, naked.row(cell_at(naked, 0, 0))),
+    check(!SubsetTechnique::test_hidden_subset({ {0, 0}, {0, 1} }, { kThree, kFive }, naked.row(cell_at(naked, 0, 0))),
           "rejected: both cells bivalue {3,5} -- a naked pair, nothing to strip");
 
     // --- ordering and partner gates (reuse the accepting board) ---
     // Cell ordering: c2 must come after c1.
-    check(!HiddenPairTechnique::test_hidden_pair(cell_at(board, 0, 1), cell_at(board, 0, 0), kThree, kFive, board.row(cell_at(board, 0, 0))),
+    check(!SubsetTechnique::test_hidden_subset({ {0, 1}, {0, 0} }, { kThree, kFive }, board.row(cell_at(board, 0, 0))),
           "rejected: cells passed out of order (c2 before c1)");
 
     // Value ordering: v2 must come after v1. find_ guarantees this; a direct
     // test caller can violate it, so the guard must be tested by the direct call.
-    check(!HiddenPairTechnique::test_hidden_pair(cell_at(board, 0, 0), cell_at(board, 0, 1), kFive, kThree, board.row(cell_at(board, 0, 0))),
+    check(!SubsetTechnique::test_hidden_subset({ {0, 0}, {0, 1} }, { kFive, kThree }, board.row(cell_at(board, 0, 0))),
           "rejected: values passed out of order (v2 < v1)");
 
-    // Partner incompleteness: c2 carries only one of the two values. find_ does
-    // reach this branch (it hands every unfiltered cell to the predicate). Both
+    // Partner incompleteness: c2 carries only one of the two values. Both
     // values are confined to the pair so the hidden loop finds nothing: the carry
     // gate is then the *only* thing that can reject, so deleting it would flip the
     // case to accept -- isolating this gate rather than letting the hidden loop
@@ -668,10 +746,89 @@ void test_hidden_pair_accept_and_reject() {
     confine_value(partial, kFive,  { {0, 0} });   // 5 lives only in (0,0)
     set_candidates(partial, 0, 1, {3});           // partner carries 3 but not 5
 
-    check(!HiddenPairTechnique::test_hidden_pair(cell_at(partial, 0, 0), cell_at(partial, 0, 1), kThree, kFive, partial.row(cell_at(partial, 0, 0))),
+    check(!SubsetTechnique::test_hidden_subset({ {0, 0}, {0, 1} }, { kThree, kFive }, partial.row(cell_at(partial, 0, 0))),
           "rejected: partner carries 3 but not 5");
 }
 
+// ===========================================================================
+// Triples and quads
+// ===========================================================================
+
+// The same two predicates one and two sizes up. What a pair cannot show is a
+// subset no member spells out: a naked triple {1,2},{2,3},{1,3} has no cell
+// holding all three values, so the gate is the union's size, not equality of
+// any two sets. The hidden quad is also driven through find and apply, because
+// no board in the black-box suite routes through HQ (tests/run.sh, tier [3]).
+void test_subset_triples_and_quads() {
+    std::cout << "[subsets] triples and quads: the union gate, member sizes, and HQ end to end\n";
+
+    // --- naked triple: the union gate ---
+    Board board = empty_board();
+    set_candidates(board, 0, 0, {1, 2});
+    set_candidates(board, 0, 1, {2, 3});
+    set_candidates(board, 0, 2, {1, 3});
+    set_candidates(board, 0, 3, {3, 4});
+
+    check(SubsetTechnique::test_naked_subset({ {0, 0}, {0, 1}, {0, 2} }, board.row(cell_at(board, 0, 0))),
+          "accepted: {1,2} {2,3} {1,3} hold three values between them");
+    check(!SubsetTechnique::test_naked_subset({ {0, 0}, {0, 1}, {0, 3} }, board.row(cell_at(board, 0, 0))),
+          "rejected: {1,2} {2,3} {3,4} hold four values between them");
+    check(SubsetTechnique::test_naked_subset({ {0, 0}, {0, 1}, {0, 2}, {0, 3} }, board.row(cell_at(board, 0, 0))),
+          "accepted: the fourth cell that broke the triple makes a quad on 1..4");
+
+    // A member holding a single candidate is a naked single, not part of a
+    // subset: the singles earlier in the cascade own it.
+    Board single = empty_board();
+    set_candidates(single, 0, 0, {1, 2});
+    set_candidates(single, 0, 1, {2});
+    set_candidates(single, 0, 2, {1, 3});
+    check(!SubsetTechnique::test_naked_subset({ {0, 0}, {0, 1}, {0, 2} }, single.row(cell_at(single, 0, 0))),
+          "rejected: a member with one candidate");
+
+    // --- shape guards ---
+    check(!SubsetTechnique::test_naked_subset({ {0, 0}, {0, 1}, {0, 2}, {0, 3}, {0, 4} }, board.row(cell_at(board, 0, 0))),
+          "rejected: five cells, past kMaxSize");
+    check(!SubsetTechnique::test_hidden_subset({ {0, 0}, {0, 1}, {0, 2} }, { kOne, kTwo }, board.row(cell_at(board, 0, 0))),
+          "rejected: three cells but two values");
+
+    // --- hidden quad ---
+    // 1..4 live only in the first four cells of row 0, each in at least two of
+    // them, and the cells still carry 5..9 to strip.
+    Board quad = empty_board();
+    confine_value(quad, kOne,   { {0, 0}, {0, 1} });
+    confine_value(quad, kTwo,   { {0, 1}, {0, 2} });
+    confine_value(quad, kThree, { {0, 2}, {0, 3} });
+    confine_value(quad, kFour,  { {0, 0}, {0, 3} });
+
+    check(SubsetTechnique::test_hidden_subset({ {0, 0}, {0, 1}, {0, 2}, {0, 3} }, { kOne, kTwo, kThree, kFour },
+                                              quad.row(cell_at(quad, 0, 0))),
+          "accepted: 1..4 confined to four cells with more to strip");
+
+    // One of the values confined to a single cell is a hidden single there.
+    Board lone = empty_board();
+    confine_value(lone, kOne,   { {0, 0}, {0, 1} });
+    confine_value(lone, kTwo,   { {0, 1}, {0, 2} });
+    confine_value(lone, kThree, { {0, 2}, {0, 3} });
+    confine_value(lone, kFour,  { {0, 0} });
+    check(!SubsetTechnique::test_hidden_subset({ {0, 0}, {0, 1}, {0, 2}, {0, 3} }, { kOne, kTwo, kThree, kFour },
+                                               lone.row(cell_at(lone, 0, 0))),
+          "rejected: 4 lies in one cell -- a hidden single, not part of a quad");
+
+    // find records the quad once, under its row, and apply strips 5..9 from it.
+    SubsetTechnique hq(Subset::Hidden, 4);
+    FindingList found;
+    check(hq.find(quad, found), "HQ finds the hidden quad");
+    std::ostringstream os;
+    for (auto const &f : found) f->print(os);
+    check(os.str() == "{[1, 1],[1, 2],[1, 3],[1, 4]}#{1,2,3,4}", "HQ records the quad once, under row 1");
+    check(hq.apply(quad, found), "HQ apply reports an elimination");
+    bool stripped = true;
+    for (size_t c = 0; c < 4; ++c)
+        for (int v = 5; v <= 9; ++v) stripped = stripped && !has_candidate(quad, 0, c, static_cast<Value>(v));
+    check(stripped, "5..9 stripped from all four cells of the quad");
+    check(has_candidate(quad, 0, 0, kOne) && has_candidate(quad, 0, 3, kFour), "the quad's own values survive");
+}
+
 // ===========================================================================
 // X-Wing
 // ===========================================================================
@@ -1429,6 +1586,65 @@ void test_finnedswordfish_plain_swordfish_not_reported() {
     check(found.empty(), "nothing recorded");
 }
 
+// ===========================================================================
+// Finned Jellyfish
+// ===========================================================================
+
+// A row-based finned Jellyfish on value 7.
+//
+//        c0 c1 c2 c3 c4
+//   r0    7  7                <- base row
+//   r1       7  7             <- base row
+//   r3          7     7       <- base row
+//   r4    7        7  7       <- base row, plus the fin at c3
+//   r5                7       <- cover column, fin's nonet, not a base row: eliminated
+//
+// Cover {c0,c1,c2,c4}; the fin at (4,3) puts the middle-centre nonet in play, and
+// c4 is the only cover column through it. (3,4) and (4,4) are in that nonet on
+// c4 too, but on base rows, so only (5,4) goes. Cross lines in first-encounter
+// order are c0, c1, c2, c4, c3, so the cover is the first quadruple tried.
+void test_finnedjellyfish_row_based() {
+    std::cout << "[finned jellyfish] row-based detection and action\n";
+    Board board = empty_board();
+    const Value V = kSeven;
+    confine_value(board, V, { {0,0},{0,1}, {1,1},{1,2}, {3,2},{3,4}, {4,0},{4,3},{4,4}, {5,4} });
+
+    FinnedJellyfishTechnique fj;  // needed for apply() below; find_finned_jellyfish is static
+    FindingList found;
+    check(FinnedJellyfishTechnique::find_finned_jellyfish(board, cell_at(board, 0, 0), V, found),
+          "row finned Jellyfish detected with anchor (0,0)");
+    check(found.size() == 1, "exactly one finned Jellyfish recorded");
+    auto const *f = only<FinnedJellyfishFinding>(found);
+    check(f, "the recorded finding is a FinnedJellyfishFinding");
+    if (f) {
+        check(f->is_row_based, "recorded pattern is row-based");
+        check(f->value == V, "recorded pattern is for value 7");
+        check(f->fins.size() == 1 && f->fins[0] == Coord(4, 3), "the fin at (4,3) is recorded");
+    }
+
+    bool acted = fj.apply(board, found);
+    check(acted, "apply reports an elimination");
+    check(!has_candidate(board, 5, 4, V), "stray 7 at (5,4) eliminated");
+    check(has_candidate(board, 4, 3, V), "the fin at (4,3) survives");
+    check(has_candidate(board, 3, 4, V) && has_candidate(board, 4, 4, V),
+          "(3,4) and (4,4) survive: in the fin's nonet on the cover, but on base rows");
+}
+
+// The same fish without (5,4): the fin's nonet holds no cover cell off the base
+// rows, so there is nothing to eliminate. Read by columns, every four of them
+// fall within rows {0,1,3,4} -- finless, so plain Jellyfish's to report.
+void test_finnedjellyfish_no_elimination() {
+    std::cout << "[finned jellyfish] a pattern with nothing to eliminate is not recorded\n";
+    Board board = empty_board();
+    const Value V = kSeven;
+    confine_value(board, V, { {0,0},{0,1}, {1,1},{1,2}, {3,2},{3,4}, {4,0},{4,3},{4,4} });
+
+    FindingList found;
+    check(!FinnedJellyfishTechnique::find_finned_jellyfish(board, cell_at(board, 0, 0), V, found),
+          "no finned Jellyfish reported when there is nothing to eliminate");
+    check(found.empty(), "nothing recorded");
+}
+
 // ===========================================================================
 // Simple coloring
 // ===========================================================================
@@ -1444,16 +1660,16 @@ void test_colorchain_rule2_contradiction() {
     confine_value(board, V, { {0,0}, {0,4}, {8,8} });
 
     ColorChainFinding chain(V);
-    chain.cells[Coord(0,0)] = true;    // green
-    chain.cells[Coord(0,4)] = true;    // green -- same row as the other green
-    chain.cells[Coord(8,8)] = false;   // red
+    chain.paint(Coord(0,0), true);    // green
+    chain.paint(Coord(0,4), true);    // green -- same row as the other green
+    chain.paint(Coord(8,8), false);   // red
 
     check(ColorChainTechnique::test_color_chain(board, chain),
           "test_color_chain reports a same-color-in-unit chain as actionable");
 
     ColorChainTechnique sc;
     FindingList found;
-    found.push_back(std::make_shared<ColorChainFinding>(chain));
+    found.emplace<ColorChainFinding>(chain);
     bool acted = sc.apply(board, found);
     check(acted, "apply reports an elimination");
     check(!has_candidate(board, 0, 0, V) && !has_candidate(board, 0, 4, V),
@@ -1470,8 +1686,8 @@ void test_colorchain_benign_not_actionable() {
     confine_value(board, V, { {0,0}, {4,4} });   // value lives only on the chain
 
     ColorChainFinding chain(V);
-    chain.cells[Coord(0,0)] = true;    // green
-    chain.cells[Coord(4,4)] = false;   // red -- shares no unit with the green
+    chain.paint(Coord(0,0), true);    // green
+    chain.paint(Coord(4,4), false);   // red -- shares no unit with the green
 
     check(!ColorChainTechnique::test_color_chain(board, chain),
           "test_color_chain reports a benign chain as not actionable");
@@ -1500,8 +1716,8 @@ void test_rebinding_ctor_carries_findings() {
 
     Analyzer a(board);
     a.analyze();
-    check(AnalyzerTest::findings_bucket_count(a) == 12, "twelve registry buckets (NS, HS, NP, LC, HP, XW, SC, YW, SF, FX, FS, XY)");
-    check(AnalyzerTest::findings_total(a) == 1, "the naked single was recorded in a's bucket (HS/NP/LC/HP/XW/SC/YW/SF/FX/FS/XY short-circuited)");
+    check(AnalyzerTest::findings_bucket_count(a) == 18, "eighteen registry buckets (NS, HS, NP, LC, HP, NT, HT, NQ, HQ, XW, SC, YW, SF, JF, FX, FS, FJ, XY)");
+    check(AnalyzerTest::findings_total(a) == 1, "the naked single was recorded in a's bucket (HS/NP/LC/HP/NT/HT/NQ/HQ/XW/SC/YW/SF/JF/FX/FS/FJ/XY short-circuited)");
 
     // Copy the candidate grid and rebind onto it -- this is the ONLY operation
     // under test. b.analyze() is deliberately never called.
@@ -1515,6 +1731,47 @@ void test_rebinding_ctor_carries_findings() {
           "the carried findings are byte-identical to the source's");
 }
 
+// --- FindingList's arena ---
+//
+// The carried findings above are shared, not copied: a FindingList copy holds
+// the same findings, in the arena both lists now own. So clearing one list must
+// leave the other's findings alive, and the last list to let go must destroy
+// every one of them, exactly once.
+namespace {
+struct CountedFinding : Finding {
+    static inline int sLive = 0;
+    int id;
+    explicit CountedFinding(int i) : id(i) { ++sLive; }
+    ~CountedFinding() override { --sLive; }
+    void print(std::ostream &out) const override { out << id; }
+};
+} // namespace
+
+void test_finding_list_shares_its_arena() {
+    std::cout << "[findings] a FindingList copy shares its arena; the last owner frees it\n";
+
+    {
+        FindingList a;
+        for (int i = 0; i < 200; ++i) a.emplace<CountedFinding>(i);  // more than one block
+        check(a.size() == 200 && CountedFinding::sLive == 200, "every emplaced finding is live");
+
+        FindingList b(a);
+        check(b.size() == 200 && b.front() == a.front(), "a copy holds the very same findings");
+
+        a.clear();
+        check(a.empty() && CountedFinding::sLive == 200, "clearing one list leaves the copy's findings alive");
+
+        bool in_order = true;
+        int next = 0;
+        for (auto const *f : b) in_order &= bucket_cast<CountedFinding>(*f).id == next++;
+        check(in_order, "the copy reads its findings back in the order they were recorded");
+
+        a.emplace<CountedFinding>(-1);
+        check(a.size() == 1 && CountedFinding::sLive == 201, "a cleared list records into an arena of its own");
+    }
+    check(CountedFinding::sLive == 0, "the last owner destroys every finding, exactly once");
+}
+
 // --- Board's peer invariant ---
 //
 // These cases are about Board, not the Analyzer, and they live in this file
@@ -1611,6 +1868,414 @@ void test_set_value_keeps_counts_consistent() {
           "peer invariant: the cached note count still matches after a second, disjoint placement");
 }
 
+// Board's per-digit candidate bitboards, its solved and bivalue bitboards and
+// its per-unit position masks are derived from the cells and must agree with
+// them bit for bit. Checked cell by cell and digit by digit against the cells
+// themselves, so any drift is caught whichever mutator caused it.
+bool bitboards_match(const Board &board) {
+    for (auto const &cell : board.cells()) {
+        const size_t i = cell.coord().index();
+        if (board.solved().test(i) != cell.isValue()) return false;
+        if (board.bivalue().test(i) != (cell.isNote() && cell.notes().count() == 2)) return false;
+        for (Value v : value_range())
+            if (board.candidates(v).test(i) != cell.check(v)) return false;
+    }
+    for (size_t unit = 0; unit < units::kUnitCount; ++unit) {
+        for (Value v : value_range()) {
+            uint16_t expected = 0;
+            for (size_t k = 0; k < 9; ++k)
+                if (board.cells()[units::kUnitCells[unit][k]].check(v)) expected |= static_cast<uint16_t>(1u << k);
+            if (board.positions(unit, v) != expected) return false;
+        }
+    }
+    return true;
+}
+
+void test_bitboards_track_the_cells() {
+    std::cout << "[board] candidate and solved bitboards stay in step with the cells\n";
+    Board board = empty_board();
+    check(bitboards_match(board), "bitboards: an empty board has every candidate bit and no solved bit");
+
+    board.set_value_at(4, 4, kFive);
+    check(bitboards_match(board), "bitboards: a placement clears the cell and its peers' bits for the value");
+
+    set_candidates(board, 0, 0, {2, 7});
+    check(bitboards_match(board), "bitboards: clearing notes clears exactly those bits");
+    check(board.candidates(kTwo).test(0) && !board.candidates(kThree).test(0),
+          "bitboards: the kept candidates are still set");
+
+    Board copy(board);
+    copy.set_value_at(0, 0, kSeven);
+    check(bitboards_match(copy) && bitboards_match(board),
+          "bitboards: a copy carries its own bitboards, and mutating it leaves the original's alone");
+
+    Board loaded(".53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79");
+    check(bitboards_match(loaded), "bitboards: a board loaded from its givens matches its cells");
+    check(loaded.solved().count() == 81 - loaded.note_cells_count(),
+          "bitboards: the solved bitboard counts the value cells");
+}
+
+// The bivalue and position indexes, read the way their consumers read them.
+// (0,0) is cut to {2,7}, then to {7}: it enters the bivalue index and leaves it
+// again. 7 is then confined to two cells of row 0, which is a conjugate pair.
+void test_bivalue_and_position_indexes() {
+    std::cout << "[board] bivalue cells and conjugate pairs are indexed as they form\n";
+    Board board = empty_board();
+    check(board.bivalue().empty(), "indexes: an empty board has no bivalue cell");
+    check(board.positions(0, kSeven) == 0x1ff, "indexes: every cell of row 0 can hold 7");
+
+    set_candidates(board, 0, 0, {2, 7});
+    check(board.bivalue() == Bitboard::cell(0), "indexes: a cell cut to two candidates is bivalue");
+    board.clear_note_at(0, 0, kTwo);
+    check(board.bivalue().empty(), "indexes: cut to one, it leaves the index");
+
+    confine_value(board, kSeven, { {0,0}, {0,5} });
+    check(board.positions(0, kSeven) == ((1u << 0) | (1u << 5)),
+          "indexes: row 0's 7s are its cells 0 and 5");
+    check(board.positions(9 + 5, kSeven) == 1u && board.positions(18 + 1, kSeven) == 1u << 2,
+          "indexes: (0,5) is the first cell of column 5 and the third of nonet 1");
+    check(bitboards_match(board), "indexes: and both agree with the cells throughout");
+}
+
+// The prefilters read those indexes. An empty board offers nothing: no bivalue
+// cell, no conjugate pair, every digit in all nine cells of every unit. Each
+// pattern then switches on exactly the prefilters it could feed, and no more.
+void test_prefilters_rule_out_what_cannot_fire() {
+    std::cout << "[prefilter] techniques are ruled out until their raw material exists\n";
+    const XWingTechnique xw;
+    const FinnedXWingTechnique fx;
+    const ColorChainTechnique sc;
+    const YWingTechnique yw;
+    const XYChainTechnique xy;
+    const SubsetTechnique np(Subset::Naked, 2), nt(Subset::Naked, 3), hp(Subset::Hidden, 2);
+
+    Board board = empty_board();
+    check(!xw.may_fire(board) && !fx.may_fire(board) && !sc.may_fire(board),
+          "prefilter: no fish and no coloring on an empty board");
+    check(!yw.may_fire(board) && !xy.may_fire(board) && !np.may_fire(board) && !hp.may_fire(board),
+          "prefilter: no bivalue cell, so no Y-Wing, XY-Chain or pair");
+    check(nt.may_fire(board), "prefilter: naked triples have no index, so are always searched");
+
+    // The row-based X-Wing fixture: rows 0 and 3 hold 7 in two cells each.
+    confine_value(board, kSeven, { {0,1},{0,5}, {3,1},{3,5}, {6,1}, {7,5} });
+    check(xw.may_fire(board) && fx.may_fire(board) && sc.may_fire(board),
+          "prefilter: two two-cell rows for 7 admit an X-Wing and a coloring");
+
+    // Two bivalue cells that see each other: a naked pair and an XY link, but a
+    // Y-Wing needs a third.
+    set_candidates(board, 8, 0, {2, 4});
+    set_candidates(board, 8, 1, {2, 4});
+    check(np.may_fire(board) && xy.may_fire(board), "prefilter: two bivalue peers admit a pair and a chain");
+    check(!yw.may_fire(board), "prefilter: two bivalue cells are not a Y-Wing");
+}
+
+void test_peer_tables_match_the_board_geometry() {
+    std::cout << "[board] the precomputed peer tables agree with the row/column/nonet rule\n";
+    Board board = empty_board();
+    bool all_agree = true;
+    for (size_t a = 0; a < 81; ++a) {
+        const Coord ca(a / 9, a % 9);
+        size_t listed = 0;
+        for (size_t b = 0; b < 81; ++b) {
+            const Coord cb(b / 9, b % 9);
+            const bool sees = a != b && (ca.row() == cb.row() || ca.column() == cb.column()
+                                         || (ca.row() / 3 == cb.row() / 3 && ca.column() / 3 == cb.column() / 3));
+            if (units::kPeers[a].test(b) != sees) all_agree = false;
+            if (a != b && board.see_each_other(ca, cb).has_value() != sees) all_agree = false;
+            if (sees && units::kPeerList[a][listed++] != b) all_agree = false;
+        }
+    }
+    check(all_agree, "peers: kPeers, kPeerList and see_each_other match the geometry for every cell pair");
+
+    // (0,0) and (0,8) share row 0 and nothing else, so what they both see is the
+    // rest of row 0: each one's nonet and column lie outside the other's sight.
+    check(units::common_peers(0, 8) == (units::kRows[0] & ~(Bitboard::cell(0) | Bitboard::cell(8))),
+          "peers: two cells at either end of a row see the rest of that row in common");
+}
+
+// Render everything observable about a board -- values, candidates, counts --
+// so two boards can be compared as strings.
+std::string board_dump(const Board &board) {
+    std::ostringstream out;
+    board.print_candidates(out);
+    out << board;
+    return out.str();
+}
+
+void test_undo_restores_the_board() {
+    std::cout << "[board] undoing the journal restores the board exactly\n";
+    Board board(".53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79");
+    const std::string before = board_dump(board);
+
+    std::vector<BoardChange> journal;
+    board.set_journal(&journal);
+    board.set_value_at(0, 2, kFour);     // a placement, and the peer eliminations it causes
+    board.clear_note_at(0, 3, kSix);
+    const size_t mark = journal.size();
+    board.set_value_at(0, 3, kSix);
+    check(journal.size() > mark + 1, "undo: placements journal their peer eliminations too");
+
+    board.undo(journal, mark);
+    check(journal.size() == mark && bitboards_match(board) && board.cells()[3].isNote()
+          && !board.cells()[3].check(kSix) && board.cells()[2].isValue(), "undo: undoing to a mark reverts only the changes after it");
+
+    board.undo(journal, 0);
+    check(journal.empty() && board_dump(board) == before && bitboards_match(board),
+          "undo: undoing the whole journal gives back the board it started from");
+
+    Board copy(board);
+    copy.set_value_at(0, 2, kFour);
+    check(journal.empty(), "undo: a copy of a journaled board does not write to its journal");
+}
+
+void test_change_stamps_track_the_cells() {
+    std::cout << "[board] change stamps name exactly the cells touched since\n";
+    Board board = empty_board();
+    const uint32_t start = board.stamp();
+    check(board.changed_since(start).empty(), "stamps: nothing has changed since now");
+
+    board.clear_note_at(0, 0, kOne);
+    check(board.changed_since(start) == Bitboard::cell(0), "stamps: a cleared note touches its cell");
+
+    const uint32_t before_placement = board.stamp();
+    board.set_value_at(4, 4, kFive);
+    Bitboard touched = units::kPeers[Coord(4, 4).index()];
+    touched.set(Coord(4, 4).index());
+    check(board.changed_since(before_placement) == touched,
+          "stamps: a placement touches its cell and every peer it clears");
+
+    Board copy(board);
+    check(copy.changed_since(before_placement) == touched, "stamps: a copy carries the stamps");
+}
+
+void test_search_finishes_and_counts() {
+    std::cout << "[search] backtracking finishes a board from its candidates, up to a limit\n";
+    // The board the cascade stalls on (tests/run.sh P_hard). It has more than
+    // one completion, which is why no sound technique finishes it.
+    const std::string hard = ".1..4....6.46.912....2......3......4....2.8....6......5......9....875.12.7....3..4";
+    SearchResult r = search(Board(hard), 2);
+    bool completes = r.solution.size() == 81;
+    for (size_t i = 0; completes && i < 81; ++i)
+        completes = hard[i + 1] == '.' || hard[i + 1] == r.solution[i];
+    check(completes && Board("." + r.solution).note_cells_count() == 0,
+          "search: the solution found is a legal grid keeping every given");
+    check(r.solutions == 2 && r.guesses > 0, "search: the stalled board has a second solution, found by guessing");
+
+    Board easy(".53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79");
+    r = search(easy);
+    check(r.solutions == 1 && r.guesses == 0, "search: propagation alone finishes an easy board");
+
+    r = search(empty_board(), 3);
+    check(r.solutions == 3 && r.solution.size() == 81, "search: an empty board stops at the limit");
+
+    // (0,8) can hold neither 1-8 (its row) nor 9 (its nonet): no solution, though
+    // no unit repeats a given.
+    std::string desc(82, '.');
+    desc.replace(1, 18, "12345678.........9");
+    Board impossible(desc);
+    r = search(impossible, 2);
+    check(r.solutions == 0 && r.solution.empty(), "search: a board with an empty cell has no solution");
+
+    check(count_solutions(easy, 2) == 1 && count_solutions(Board(hard), 2) == 2
+          && count_solutions(Board(hard), 4) == 4 && count_solutions(impossible, 2) == 0,
+          "count: unique, several and no solutions, each counted no further than the limit");
+}
+
+// ===========================================================================
+// Larger boards
+// ===========================================================================
+
+// The 16x16 and 25x25 boards are the same templates as the 9x9 one at box size 4
+// and 5 (geometry.h), so what these cases pin down is that nothing in the
+// templates still assumes three: the tables, the fish's bands and fin nonets,
+// and a whole cascade solve.
+
+// Every cell of a board of box size Box against the row/column/box rule, as
+// test_peer_tables_match_the_board_geometry checks the 9x9 one.
+template<size_t Box>
+bool peer_tables_agree() {
+    using G = Geometry<Box>;
+    const BasicBoard<Box> board(std::string(G::kCells + 1, '.'));
+    bool all_agree = true;
+    for (size_t a = 0; a < G::kCells; ++a) {
+        const Coord ca = G::coord(a);
+        size_t listed = 0;
+        for (size_t b = 0; b < G::kCells; ++b) {
+            const Coord cb = G::coord(b);
+            const bool sees = a != b && (ca.row() == cb.row() || ca.column() == cb.column()
+                                         || (ca.row() / Box == cb.row() / Box && ca.column() / Box == cb.column() / Box));
+            if (G::kPeers[a].test(b) != sees) all_agree = false;
+            if (a != b && board.see_each_other(ca, cb).has_value() != sees) all_agree = false;
+            if (sees && G::kPeerList[a][listed++] != b) all_agree = false;
+        }
+        if (listed != G::kPeerCount) all_agree = false;
+    }
+    return all_agree;
+}
+
+void test_large_board_geometry() {
+    std::cout << "[large] the 16x16 and 25x25 tables agree with the row/column/box rule\n";
+    check(Geometry<4>::kPeerCount == 39 && Geometry<5>::kPeerCount == 64,
+          "peers: 39 per cell on a 16x16 board, 64 on a 25x25 one");
+    check(peer_tables_agree<4>() && peer_tables_agree<5>(),
+          "peers: kPeers, kPeerList and see_each_other match the geometry at both sizes");
+    check(sizeof(Geometry<4>::Notes) == 2 && sizeof(Geometry<5>::Notes) == 4,
+          "notes: a 16x16 cell's candidates fit 16 bits, a 25x25 cell's 32");
+
+    const BasicBoard<4> board(std::string(257, '.'));
+    bool full = true;
+    for (auto const &cell : board.cells()) full = full && cell.isNote() && cell.notes().count() == 16;
+    check(full && board.note_cells_count() == 256, "board: an empty 16x16 board has all 16 candidates in every cell");
+}
+
+// A finned X-Wing on value 16 (G) whose fin's box is four rows by four columns:
+// rows 0 and 8 are the base lines, on columns 1 and 10; row 8's extra G at
+// (8,11) is the fin, in the box of rows 8-11, columns 8-11. So the G at (9,10),
+// in cover column 10 and the fin's box, goes; (14,10) is outside that box and
+// (5,1) on the other cover column, so both stay.
+void test_large_finned_xwing() {
+    std::cout << "[large] a finned X-Wing on a 16x16 board eliminates within the fin's box\n";
+    BasicBoard<4> board(std::string(257, '.'));
+    const Value V = static_cast<Value>(16);
+    confine_value(board, V, { {0,1},{0,10}, {8,1},{8,10},{8,11}, {9,10}, {14,10}, {5,1} });
+
+    BasicFinnedXWingTechnique<4> fxw;
+    FindingList found;
+    check(BasicFinnedXWingTechnique<4>::find_finned_xwing(board, cell_at(board, 0, 1), V, found),
+          "finned X-Wing detected with anchor (0,1)");
+    auto const *f = only<FinnedXWingFinding>(found);
+    check(f && f->value == V && f->fins.size() == 1 && f->fins[0] == Coord(8, 11),
+          "the recorded finding is for G, with its one fin at (8,11)");
+
+    check(fxw.apply(board, found), "apply reports an elimination");
+    check(!has_candidate(board, 9, 10, V), "G at (9,10), in the fin's box, eliminated");
+    check(has_candidate(board, 14, 10, V) && has_candidate(board, 5, 1, V),
+          "G outside the fin's box kept at (14,10) and (5,1)");
+}
+
+// A 16x16 board the singles cannot finish: it takes pairs, locked candidates,
+// a naked triple, a Y-Wing and two XY-chains (tests/run.sh has its grade).
+void test_large_cascade_solves() {
+    std::cout << "[large] the technique cascade solves a 16x16 board\n";
+    const std::string desc = "..F...C5....1...B.C..D921..3.....D......B.F8.EC..G73...8.E..6....F.AE...D.21.73.4......1.....F..E.....3B..8....6D7..4.8..C56......AE..6.92...3.4...D..1G..B.F....21G.3......C...9....8.EC5..9....AE.5..92....B.F8...21G..B4..A..5.....4....C......4F8A.C........3";
+    const std::string solution = "4F8AEC56D921G73BEC56D921G73B4F8AD921G73B4F8AEC56G73B4F8AEC56D921F8AEC56D921G73B4C56D921G73B4F8AE921G73B4F8AEC56D73B4F8AEC56D921G8AEC56D921G73B4F56D921G73B4F8AEC21G73B4F8AEC56D93B4F8AEC56D921G7AEC56D921G73B4F86D921G73B4F8AEC51G73B4F8AEC56D92B4F8AEC56D921G73";
+
+    // The steps are narrated; keep them, to see which techniques ran.
+    std::ostringstream narrated;
+    set_narration(narrated);
+    BasicSolver<4> singles(desc, History::Deltas);
+    singles.solve_singles();
+    BasicSolver<4> solver(desc, History::Deltas);
+    solver.solve();
+    set_narration(std::cout);
+
+    check(!singles.solved(), "the singles alone stall on it");
+    std::ostringstream line;
+    solver.print_line(line);
+    check(solver.solved() && line.str() == solution, "the cascade finishes it, to the one solution");
+    check(narrated.str().find("[YW]") != std::string::npos && narrated.str().find("[XY]") != std::string::npos,
+          "the solve went through the Y-Wing and the XY-chain");
+    check(count_solutions(BasicBoard<4>(desc), 2) == 1, "the search agrees the board is unique");
+}
+
+void test_canonical_form_is_shared_by_symmetries() {
+    std::cout << "[canonical] a puzzle and its symmetries share one canonical form\n";
+    const std::string easy = "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+
+    // Transposed, bands 0 and 2 swapped, rows 3 and 5 swapped, stacks 0 and 1
+    // swapped, columns 6 and 8 swapped, and every digit d relabeled 10 - d.
+    const size_t rows[9]    = { 6, 7, 8, 5, 4, 3, 0, 1, 2 };
+    const size_t columns[9] = { 3, 4, 5, 0, 1, 2, 8, 7, 6 };
+    std::string image(81, '.');
+    for (size_t r = 0; r < 9; ++r)
+        for (size_t c = 0; c < 9; ++c) {
+            const char d = easy[columns[c] * 9 + rows[r]];
+            image[r * 9 + c] = d == '.' ? '.' : static_cast<char>('0' + 10 - (d - '0'));
+        }
+
+    const Canonical a = canonicalize(Board("." + easy));
+    const Canonical b = canonicalize(Board("." + image));
+    check(a.cells == b.cells, "canonical: a transposed, permuted, relabeled puzzle has the same form");
+    check(a.cells != canonicalize(Board(".1..4....6.46.912....2......3......4....2.8....6......5......9....875.12.7....3..4")).cells,
+          "canonical: a different puzzle has a different form");
+    check(a.symmetry.restore(a.cells) == easy && b.symmetry.restore(b.cells) == image,
+          "canonical: each symmetry maps the form back to its own puzzle");
+
+    const std::string solution = search(Board("." + a.cells)).solution;
+    check(a.symmetry.restore(solution) == search(Board("." + easy)).solution
+          && b.symmetry.restore(solution) == search(Board("." + image)).solution,
+          "canonical: the form's solution maps back to each puzzle's own");
+}
+
+void test_solution_store_round_trips() {
+    std::cout << "[store] a store finds what was appended, through the log and the map\n";
+    const std::string puzzle   = "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+    const std::string solution = "534678912672195348198342567859761423426853791713924856961537284287419635345286179";
+    const std::string stalled  = "1..4....6.46.912....2......3......4....2.8....6......5......9....875.12.7....3..4";
+
+    char unpacked[81];
+    SolutionStore::unpack(SolutionStore::pack(puzzle).data(), unpacked);
+    check(std::string(unpacked, 81) == puzzle, "store: a grid packs and unpacks unchanged");
+
+    char dir[] = "/tmp/store-test-XXXXXX";
+    check(mkdtemp(dir) != nullptr, "store: made a scratch directory");
+    const std::string path = std::string(dir) + "/results";
+
+    // Each stage opens the store afresh, so the first finds read the log and
+    // the last the compacted map.
+    auto found = [&](const char *stage) {
+        SolutionStore store(path);
+        SolutionStore::Entry entry;
+        check(store.find(SolutionStore::pack(puzzle), entry) && entry.solved
+              && entry.grade == " grade: 5 HS NS:40 HS:11",
+              std::string("store: the solved puzzle is found ") + stage);
+        SolutionStore::unpack(entry.solution, unpacked);
+        check(std::string(unpacked, 81) == solution, std::string("store: its solution is intact ") + stage);
+        check(store.find(SolutionStore::pack(stalled), entry) && !entry.solved && entry.grade.empty(),
+              std::string("store: the stall is found ") + stage);
+        check(!store.find(SolutionStore::pack(solution), entry),
+              std::string("store: a puzzle never appended is not found ") + stage);
+    };
+    {
+        SolutionStore store(path);
+        store.append(SolutionStore::pack(puzzle), true, solution, " grade: 5 HS NS:40 HS:11");
+        store.append(SolutionStore::pack(stalled), false, {}, {});
+        store.append(SolutionStore::pack(puzzle), false, {}, {});   // already held: ignored
+    }
+
+    // A run killed mid-append leaves the stall's record torn. The next open drops
+    // it and cuts the log back, so appending it again lands after the puzzle's.
+    const std::string log = path + ".log";
+    std::filesystem::resize_file(log, std::filesystem::file_size(log) - 3);
+    {
+        SolutionStore store(path);
+        SolutionStore::Entry entry;
+        check(store.find(SolutionStore::pack(puzzle), entry) && entry.solved,
+              "store: the record before a torn one survives it");
+        check(!store.find(SolutionStore::pack(stalled), entry), "store: the torn record is dropped");
+        store.append(SolutionStore::pack(stalled), false, {}, {});
+    }
+    found("in the log");
+    check(SolutionStore::compact(path) == 2, "store: compaction writes both records");
+    found("in the map");
+
+    // A header that checks out over a table with no empty slot: a lookup would
+    // probe forever, so the open must refuse it. One slot, one record, and a
+    // two-byte stall record in the blob.
+    {
+        std::string bytes("SUDOKUS1", 8);
+        for (uint64_t v : { 1, 1 }) for (size_t i = 0; i < 4; ++i) bytes += char(v >> (8 * i));
+        for (size_t i = 0; i < 8; ++i) bytes += char(i == 0 ? 2 : 0);
+        bytes += std::string(44, '\0') + std::string(4, '\0') + std::string(2, '\0');
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+        bool rejected = false;
+        try { SolutionStore store(path); } catch (const std::runtime_error &) { rejected = true; }
+        check(bytes.size() == 74 && rejected, "store: a slot table with no empty slot is rejected");
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
 void test_set_value_after_peer_cleared_a_candidate() {
     Board board = empty_board();
 
@@ -1698,6 +2363,8 @@ int main() {
     test_swordfish_column_based();
     test_swordfish_row_based();
     test_swordfish_no_elimination();
+    test_jellyfish_column_based();
+    test_jellyfish_no_elimination();
     test_xychain_detect_and_act();
     test_xychain_length_bound();
     test_xychain_canonical_direction();
@@ -1708,6 +2375,7 @@ int main() {
     test_notes_set_ops();
     test_naked_pair_accept_and_reject();
     test_hidden_pair_accept_and_reject();
+    test_subset_triples_and_quads();
     test_xwing_row_based();
     test_xwing_column_based();
     test_xwing_no_elimination();
@@ -1730,11 +2398,26 @@ int main() {
     test_finnedswordfish_sole_elimination_on_first_cover_line();
     test_finnedswordfish_sole_elimination_on_second_cover_line();
     test_finnedswordfish_plain_swordfish_not_reported();
+    test_finnedjellyfish_row_based();
+    test_finnedjellyfish_no_elimination();
     test_colorchain_rule2_contradiction();
     test_colorchain_benign_not_actionable();
     test_rebinding_ctor_carries_findings();
+    test_finding_list_shares_its_arena();
     test_set_value_clears_peer_notes();
     test_set_value_keeps_counts_consistent();
+    test_bitboards_track_the_cells();
+    test_bivalue_and_position_indexes();
+    test_prefilters_rule_out_what_cannot_fire();
+    test_peer_tables_match_the_board_geometry();
+    test_undo_restores_the_board();
+    test_change_stamps_track_the_cells();
+    test_search_finishes_and_counts();
+    test_large_board_geometry();
+    test_large_finned_xwing();
+    test_large_cascade_solves();
+    test_canonical_form_is_shared_by_symmetries();
+    test_solution_store_round_trips();
     test_set_value_after_peer_cleared_a_candidate();
     test_set_value_ignores_whether_the_value_is_still_a_candidate();
     test_analyze_does_not_mutate_the_board();
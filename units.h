@@ -0,0 +1,43 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include "bitboard.h"
+#include "geometry.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// The 9x9 board's geometry (geometry.h's Geometry<3>) under the names the 9x9
+// code has always used for it: cells 0..80 (Coord::index()), rows and columns
+// 0..8, nonets row-major 0..8, and the 27 units in kUnitCells as rows 0..8,
+// columns 9..17, nonets 18..26.
+namespace units {
+
+constexpr size_t nonet_index(size_t row, size_t column) { return Geometry<3>::nonet_index(row, column); }
+
+// The cells of each row, column and nonet.
+inline constexpr const std::array<Bitboard, 9> &kRows = Geometry<3>::kRows;
+inline constexpr const std::array<Bitboard, 9> &kColumns = Geometry<3>::kColumns;
+inline constexpr const std::array<Bitboard, 9> &kNonets = Geometry<3>::kNonets;
+
+// The cells of all 27 units as lists, ascending.
+inline constexpr size_t kUnitCount = Geometry<3>::kUnitCount;
+inline constexpr const std::array<std::array<uint8_t, 9>, kUnitCount> &kUnitCells = Geometry<3>::kUnitCells;
+
+// The three units of each cell and its place in each.
+using CellUnits = ::CellUnits;
+inline constexpr const std::array<CellUnits, Bitboard::kCells> &kCellUnits = Geometry<3>::kCellUnits;
+
+// The 20 peers of each cell, as a mask and as an ascending list.
+inline constexpr const std::array<Bitboard, Bitboard::kCells> &kPeers = Geometry<3>::kPeers;
+inline constexpr size_t kPeerCount = Geometry<3>::kPeerCount;
+inline constexpr const std::array<std::array<uint8_t, kPeerCount>, Bitboard::kCells> &kPeerList = Geometry<3>::kPeerList;
+
+static_assert(kPeerCount == 20);
+
+// The cells `a` and `b` both see.
+constexpr Bitboard common_peers(size_t a, size_t b) { return Geometry<3>::common_peers(a, b); }
+
+} // namespace units
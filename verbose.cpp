@@ -0,0 +1,18 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "verbose.h"
+
+#include <iostream>
+
+namespace {
+thread_local std::ostream *sNarration = &std::cout;
+} // namespace
+
+std::ostream &narration() {
+    return *sNarration;
+}
+
+void set_narration(std::ostream &outs) {
+    sNarration = &outs;
+}
@@ -2,4 +2,20 @@
 // See LICENSE for details of BSD 3-Clause License
 #pragma once
 
-extern bool sVerbose;
+#include <iosfwd>
+
+// Per-thread, like the narration stream below: batch mode solves on several
+// threads at once, and each solve reads these on every step. Keeping them
+// thread_local means a worker can never see another thread's setting, and no
+// lock is taken on the hot path. The REPL runs on the main thread only, so for
+// it they behave exactly like the plain globals they used to be.
+extern thread_local bool sVerbose;
+
+// Where solving narrates: the "Step #N:" headers, every "[XX] ..." action line,
+// the verbose "[fXX]"/"[FNv]" traces, "SOLVED!" and "???". It is std::cout by
+// default, which is what the REPL wants; batch mode points it at a discarding
+// stream so a corpus solves silently. The REPL's own output (boards, the
+// analyzer summary, help) is not narration and always goes to std::cout.
+// set_narration() affects the calling thread only.
+std::ostream &narration();
+void set_narration(std::ostream &);
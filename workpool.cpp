@@ -0,0 +1,92 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+
+#include "workpool.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// One thread's share of the index space, [next, end). The owner takes from the
+// front, a thief from the back, both under the range's own lock: a lock per
+// range rather than one for the pool, so owners contend only with the rare
+// thief, never with each other.
+struct Range {
+    std::mutex lock;
+    size_t next = 0;
+    size_t end = 0;
+};
+
+// Take the next index from our own range, if any is left.
+bool take(Range &mine, size_t &index) {
+    std::lock_guard<std::mutex> guard(mine.lock);
+    if (mine.next == mine.end) return false;
+    index = mine.next++;
+    return true;
+}
+
+// Move the back half of the fullest other range into ours. Returns false once
+// every range is empty, which is the pool's termination condition: ranges only
+// ever shrink, so an empty sweep means no work is left anywhere.
+bool steal(std::vector<Range> &ranges, size_t self) {
+    for (;;) {
+        size_t victim = ranges.size();
+        size_t most = 0;
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            if (i == self) continue;
+            std::lock_guard<std::mutex> guard(ranges[i].lock);
+            size_t left = ranges[i].end - ranges[i].next;
+            if (left > most) { most = left; victim = i; }
+        }
+        if (victim == ranges.size()) return false;
+
+        // The victim may have drained since the sweep; re-check under its lock
+        // and sweep again if so. Locks are never held two at a time.
+        size_t begin, end;
+        {
+            std::lock_guard<std::mutex> guard(ranges[victim].lock);
+            Range &v = ranges[victim];
+            size_t left = v.end - v.next;
+            if (left == 0) continue;
+            end = v.end;
+            begin = v.end - (left + 1) / 2;
+            v.end = begin;
+        }
+        std::lock_guard<std::mutex> guard(ranges[self].lock);
+        ranges[self].next = begin;
+        ranges[self].end = end;
+        return true;
+    }
+}
+
+void work(std::vector<Range> &ranges, size_t self, const std::function<void(size_t)> &task) {
+    size_t index;
+    do {
+        while (take(ranges[self], index)) task(index);
+    } while (steal(ranges, self));
+}
+
+} // namespace anonymous
+
+void parallel_for(size_t count, size_t jobs, const std::function<void(size_t)> &task) {
+    jobs = std::min(jobs, count);
+    if (jobs <= 1) {
+        for (size_t i = 0; i < count; ++i) task(i);
+        return;
+    }
+
+    std::vector<Range> ranges(jobs);
+    for (size_t t = 0; t < jobs; ++t) {
+        ranges[t].next = count * t / jobs;
+        ranges[t].end  = count * (t + 1) / jobs;
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < jobs; ++t)
+        threads.emplace_back(work, std::ref(ranges), t, std::cref(task));
+    work(ranges, 0, task);
+    for (auto &t : threads) t.join();
+}
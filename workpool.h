@@ -0,0 +1,20 @@
+// Copyright (c) 2025, Bertrand Mollinier Toublet
+// See LICENSE for details of BSD 3-Clause License
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// Run task(i) once for every i in [0, count), spread over `jobs` threads (the
+// calling thread is one of them), and return once all of them have finished.
+// jobs <= 1 runs every task inline, in order, on the calling thread.
+//
+// The index space is dealt out up front as one contiguous range per thread.
+// Each thread works its own range from the front; one that runs dry steals the
+// back half of the fullest remaining range. Sudoku solve times vary by orders
+// of magnitude from board to board, so a static split alone would leave most
+// threads idle behind whichever drew the hard boards; stealing halves keeps
+// the number of steals logarithmic in the range size instead of one lock per
+// task. Tasks must be independent: nothing orders them against each other,
+// and a task that needs a result position writes it by index.
+void parallel_for(size_t count, size_t jobs, const std::function<void(size_t)> &task);